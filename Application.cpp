@@ -1,5 +1,6 @@
 #include "Application.h"
 #include "ControlIDs.h"
+#include "FanOutConverter.h"
 #include <sstream>
 #include <codecvt>
 #include <locale>
@@ -140,6 +141,15 @@ namespace OutfitConverter {
             }
         });
 
+        UI::CustomButton exportAllBtn;
+        exportAllBtn.Create(mainWindow, L"Export All Formats", 
+            280 + panelWidth, 170, 200, 45, ID_BTN_EXPORT_ALL);
+        exportAllBtn.SetCallback([this]() {
+            if (outfitLoaded) {
+                ExportAllFormats();
+            }
+        });
+
         // Memory controls
         UI::CustomButton attachBtn;
         attachBtn.Create(mainWindow, L"Attach to GTA V", 
@@ -219,41 +229,13 @@ namespace OutfitConverter {
         std::string path = WStringToString(filepath);
         currentFormat = FormatConverter::DetectFormat(path);
 
-        bool success = false;
-        switch (currentFormat) {
-            case FormatConverter::FormatType::CHERAX: {
-                CheraxOutfit cherax;
-                if (FileHandler::LoadCheraxOutfit(path, cherax)) {
-                    currentOutfit = FormatConverter::CheraxToYim(cherax);
-                    success = true;
-                }
-                break;
-            }
-            case FormatConverter::FormatType::YIM: {
-                success = FileHandler::LoadYimOutfit(path, currentOutfit);
-                break;
-            }
-            case FormatConverter::FormatType::LEXIS: {
-                LexisOutfit lexis;
-                if (FileHandler::LoadLexisOutfit(path, lexis)) {
-                    currentOutfit = FormatConverter::LexisToYim(lexis);
-                    success = true;
-                }
-                break;
-            }
-            case FormatConverter::FormatType::STAND: {
-                StandOutfit stand;
-                if (FileHandler::LoadStandOutfit(path, stand)) {
-                    currentOutfit = FormatConverter::StandToYim(stand);
-                    success = true;
-                }
-                break;
-            }
-            default:
-                ShowError(L"Unknown outfit format!");
-                return;
+        if (currentFormat == FormatConverter::FormatType::UNKNOWN) {
+            ShowError(L"Unknown outfit format!");
+            return;
         }
 
+        bool success = FormatConverter::LoadAsYim(path, currentFormat, currentOutfit);
+
         if (success) {
             outfitLoaded = true;
             currentFilePath = path;
@@ -280,36 +262,51 @@ namespace OutfitConverter {
         SaveOutfitFile(targetPath, targetFormat);
     }
 
+    void Application::ExportAllFormats() {
+        WCHAR targetPath[MAX_PATH];
+        GetWindowTextW(targetPathEdit, targetPath, MAX_PATH);
+
+        if (wcslen(targetPath) == 0) {
+            ShowError(L"Please specify a target file path!");
+            return;
+        }
+
+        // One serialization pass over the loaded outfit for every format
+        std::string basePath = WStringToString(targetPath);
+        size_t dotPos = basePath.find_last_of('.');
+        size_t slashPos = basePath.find_last_of("\\/");
+        if (dotPos != std::string::npos && (slashPos == std::string::npos || dotPos > slashPos)) {
+            basePath = basePath.substr(0, dotPos);
+        }
+
+        const auto formats = FanOutConverter::AllFormats();
+        std::vector<std::string> outputs;
+        FanOutConverter::SerializeAll(currentOutfit, formats, outputs);
+
+        bool success = true;
+        for (size_t i = 0; i < formats.size(); i++) {
+            success &= FileHandler::WriteFileContent(
+                FanOutConverter::GetFanOutPath(basePath, formats[i]), outputs[i]);
+        }
+
+        if (success) {
+            ShowSuccess(L"Outfit exported in all formats successfully!");
+        } else {
+            ShowError(L"Failed to export one or more formats!");
+        }
+    }
+
     void Application::SaveOutfitFile(const std::wstring& filepath, 
                                     FormatConverter::FormatType format) {
         std::string path = WStringToString(filepath);
-        bool success = false;
-
-        switch (format) {
-            case FormatConverter::FormatType::CHERAX: {
-                CheraxOutfit cherax = FormatConverter::YimToCherax(currentOutfit);
-                success = FileHandler::SaveCheraxOutfit(path, cherax);
-                break;
-            }
-            case FormatConverter::FormatType::YIM: {
-                success = FileHandler::SaveYimOutfit(path, currentOutfit);
-                break;
-            }
-            case FormatConverter::FormatType::LEXIS: {
-                LexisOutfit lexis = FormatConverter::YimToLexis(currentOutfit);
-                success = FileHandler::SaveLexisOutfit(path, lexis);
-                break;
-            }
-            case FormatConverter::FormatType::STAND: {
-                StandOutfit stand = FormatConverter::YimToStand(currentOutfit);
-                success = FileHandler::SaveStandOutfit(path, stand);
-                break;
-            }
-            default:
-                ShowError(L"Invalid target format!");
-                return;
+        std::string content = FormatConverter::SerializeFromYim(currentOutfit, format);
+        if (content.empty()) {
+            ShowError(L"Invalid target format!");
+            return;
         }
 
+        bool success = FileHandler::WriteFileContent(path, content);
+
         if (success) {
             ShowSuccess(L"Outfit converted and saved successfully!");
         } else {
@@ -39,6 +39,7 @@ namespace OutfitConverter {
     #define ID_BTN_SAVE_FILE 2002
     #define ID_BTN_CONVERT 2003
     #define ID_BTN_CLEAR 2004
+    #define ID_BTN_EXPORT_ALL 2005
     #define ID_COMBO_SOURCE_FORMAT 2010
     #define ID_COMBO_TARGET_FORMAT 2011
     #define ID_EDIT_SOURCE_PATH 2020
@@ -88,6 +89,7 @@ namespace OutfitConverter {
         void LoadOutfitFile(const std::wstring& filepath);
         void SaveOutfitFile(const std::wstring& filepath, FormatConverter::FormatType format);
         void ConvertAndSave(FormatConverter::FormatType targetFormat);
+        void ExportAllFormats();
         void AttachToMemory();
         void ReadFromMemory();
         void WriteToMemory();
@@ -0,0 +1,285 @@
+#include "BatchConverter.h"
+#include "FileHandler.h"
+#include "ContentHash.h"
+#include "FanOutConverter.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <sstream>
+#include <cctype>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    static const char* MANIFEST_HEADER = "# OutfitConverter manifest v1";
+
+    // ============== CONVERSION MANIFEST ==============
+    bool ConversionManifest::Load(const std::string& filepath) {
+        entries.clear();
+
+        std::string content = FileHandler::ReadFileContent(filepath);
+        if (content.empty()) return false;
+
+        std::istringstream stream(content);
+        std::string line;
+        if (!std::getline(stream, line) || line.rfind(MANIFEST_HEADER, 0) != 0) {
+            return false;
+        }
+
+        // path \t size \t mtime \t contentHash \t format \t settingsHash \t outputHash,...
+        while (std::getline(stream, line)) {
+            if (line.empty()) continue;
+
+            std::vector<std::string> fields;
+            size_t start = 0;
+            while (true) {
+                size_t tab = line.find('\t', start);
+                fields.push_back(line.substr(start, tab - start));
+                if (tab == std::string::npos) break;
+                start = tab + 1;
+            }
+            if (fields.size() != 7) continue;
+
+            ManifestEntry entry;
+            try {
+                entry.path = fields[0];
+                entry.size = std::stoull(fields[1]);
+                entry.mtime = std::stoll(fields[2]);
+            } catch (...) {
+                continue;
+            }
+            entry.contentHash = HashFromHex(fields[3]);
+            entry.format = FormatConverter::FormatTypeFromName(fields[4]);
+            entry.settingsHash = HashFromHex(fields[5]);
+
+            std::istringstream hashes(fields[6]);
+            std::string hash;
+            while (std::getline(hashes, hash, ',')) {
+                if (!hash.empty()) entry.outputHashes.push_back(HashFromHex(hash));
+            }
+
+            entries[entry.path] = entry;
+        }
+
+        return true;
+    }
+
+    bool ConversionManifest::Save(const std::string& filepath) const {
+        // Sorted output keeps the manifest diff-friendly between runs
+        std::vector<const ManifestEntry*> sorted;
+        sorted.reserve(entries.size());
+        for (const auto& pair : entries) {
+            sorted.push_back(&pair.second);
+        }
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const ManifestEntry* a, const ManifestEntry* b) { return a->path < b->path; });
+
+        std::ostringstream oss;
+        oss << MANIFEST_HEADER << "\n";
+        for (const ManifestEntry* entry : sorted) {
+            oss << entry->path << "\t"
+                << entry->size << "\t"
+                << entry->mtime << "\t"
+                << HashToHex(entry->contentHash) << "\t"
+                << FormatConverter::FormatTypeToName(entry->format) << "\t"
+                << HashToHex(entry->settingsHash) << "\t";
+            for (size_t i = 0; i < entry->outputHashes.size(); i++) {
+                if (i > 0) oss << ",";
+                oss << HashToHex(entry->outputHashes[i]);
+            }
+            oss << "\n";
+        }
+
+        return FileHandler::WriteFileContent(filepath, oss.str());
+    }
+
+    const ManifestEntry* ConversionManifest::Find(const std::string& path) const {
+        auto it = entries.find(path);
+        return (it != entries.end()) ? &it->second : nullptr;
+    }
+
+    void ConversionManifest::Update(const ManifestEntry& entry) {
+        entries[entry.path] = entry;
+    }
+
+    // ============== BATCH CONVERTER ==============
+    BatchResult BatchConverter::Run(const BatchOptions& options) {
+        BatchResult result;
+
+        const bool incremental = !options.manifestPath.empty();
+        ConversionManifest previous;
+        if (incremental && !options.force) {
+            previous.Load(options.manifestPath);
+        }
+
+        const uint64_t settingsHash = HashSettings(options);
+        const std::vector<std::string> files = CollectInputFiles(options.inputDir, options.outputDir);
+        const std::vector<char> collides = FindOutputCollisions(files);
+
+        // Workers only read the previous manifest and write their own slot
+        enum class Outcome { SKIPPED, CONVERTED, FAILED };
+        std::vector<ManifestEntry> entries(files.size());
+        std::vector<Outcome> outcomes(files.size(), Outcome::FAILED);
+
+        ParallelFor(files.size(), options.threads, [&](size_t index, unsigned) {
+            const std::string& relativePath = files[index];
+            const std::string fullPath = (fs::path(options.inputDir) / relativePath).string();
+            std::error_code ec;
+
+            ManifestEntry& entry = entries[index];
+            entry.path = relativePath;
+            entry.size = fs::file_size(fullPath, ec);
+            entry.mtime = static_cast<int64_t>(
+                fs::last_write_time(fullPath, ec).time_since_epoch().count());
+            entry.settingsHash = settingsHash;
+
+            // Neither file of a colliding pair owns the output, so both fail
+            if (collides[index]) return;
+
+            // Fast path: size and mtime unchanged, nothing is read from disk
+            const ManifestEntry* prior = previous.Find(relativePath);
+            const bool settingsMatch = prior && prior->settingsHash == settingsHash;
+            if (settingsMatch && prior->size == entry.size && prior->mtime == entry.mtime &&
+                OutputsExist(options, relativePath)) {
+                entry = *prior;
+                outcomes[index] = Outcome::SKIPPED;
+                return;
+            }
+
+            // Touched but identical content (e.g. copied or re-saved) is still a skip
+            std::string content = FileHandler::ReadFileContent(fullPath);
+            entry.contentHash = HashString(content);
+            if (settingsMatch && prior->contentHash == entry.contentHash &&
+                OutputsExist(options, relativePath)) {
+                entry.format = prior->format;
+                entry.outputHashes = prior->outputHashes;
+                outcomes[index] = Outcome::SKIPPED;
+                return;
+            }
+
+            outcomes[index] = ConvertOne(options, content, entry) ? Outcome::CONVERTED : Outcome::FAILED;
+        });
+
+        ConversionManifest current;
+        for (size_t i = 0; i < files.size(); i++) {
+            result.scanned++;
+            switch (outcomes[i]) {
+                case Outcome::SKIPPED:
+                    result.skipped++;
+                    current.Update(entries[i]);
+                    break;
+                case Outcome::CONVERTED:
+                    result.converted++;
+                    current.Update(entries[i]);
+                    break;
+                case Outcome::FAILED:
+                    result.failed++;
+                    result.failedFiles.push_back(files[i]);
+                    break;
+            }
+        }
+
+        // Outputs must be durable before the manifest claims they exist
+        FileHandler::FlushPendingWrites();
+        if (incremental) {
+            current.Save(options.manifestPath);
+            FileHandler::FlushPendingWrites();
+        }
+
+        return result;
+    }
+
+    bool BatchConverter::ConvertOne(const BatchOptions& options, const std::string& content,
+                                    ManifestEntry& entry) {
+        // Parse once, serialize every target from the same in-memory outfit
+        std::vector<std::string> outputs;
+        if (!FanOutConverter::ConvertContent(content, options.targetFormats, entry.format, outputs)) {
+            return false;
+        }
+
+        entry.outputHashes.clear();
+        for (size_t i = 0; i < options.targetFormats.size(); i++) {
+            std::string outputPath = GetOutputPath(options, entry.path, options.targetFormats[i]);
+            std::error_code ec;
+            fs::create_directories(fs::path(outputPath).parent_path(), ec);
+
+            if (!FileHandler::WriteFileContent(outputPath, outputs[i])) return false;
+            entry.outputHashes.push_back(HashString(outputs[i]));
+        }
+
+        return true;
+    }
+
+    bool BatchConverter::OutputsExist(const BatchOptions& options, const std::string& relativePath) {
+        std::error_code ec;
+        for (auto target : options.targetFormats) {
+            if (!fs::exists(GetOutputPath(options, relativePath, target), ec)) return false;
+        }
+        return true;
+    }
+
+    std::string BatchConverter::GetOutputPath(const BatchOptions& options,
+                                              const std::string& relativePath,
+                                              FormatConverter::FormatType target) {
+        fs::path output = fs::path(options.outputDir) /
+                          FormatConverter::FormatTypeToName(target) / relativePath;
+        output.replace_extension(FormatConverter::GetFormatExtension(target));
+        return output.string();
+    }
+
+    std::vector<char> BatchConverter::FindOutputCollisions(const std::vector<std::string>& files) {
+        std::unordered_map<std::string, size_t> owners;
+        std::vector<char> collides(files.size(), 0);
+        for (size_t i = 0; i < files.size(); i++) {
+            const std::string stem = fs::path(files[i]).replace_extension().generic_string();
+            auto inserted = owners.emplace(stem, i);
+            if (!inserted.second) {
+                collides[i] = 1;
+                collides[inserted.first->second] = 1;
+            }
+        }
+        return collides;
+    }
+
+    uint64_t BatchConverter::HashSettings(const BatchOptions& options) {
+        uint64_t hash = HashString(fs::path(options.outputDir).generic_string());
+        for (auto target : options.targetFormats) {
+            hash = HashString("|" + FormatConverter::FormatTypeToName(target), hash);
+        }
+        return hash;
+    }
+
+    std::vector<std::string> BatchConverter::CollectInputFiles(const std::string& inputDir,
+                                                               const std::string& excludeDir) {
+        std::vector<std::string> files;
+        std::error_code ec;
+
+        // Output trees nested inside the input tree must not be picked up as inputs
+        fs::path excluded;
+        if (!excludeDir.empty()) {
+            excluded = fs::absolute(excludeDir, ec).lexically_normal();
+        }
+
+        for (fs::recursive_directory_iterator it(inputDir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_directory(ec)) {
+                if (!excluded.empty() && fs::absolute(it->path(), ec).lexically_normal() == excluded) {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+            if (!it->is_regular_file(ec)) continue;
+
+            std::string ext = it->path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (ext != ".json" && ext != ".txt") continue;
+
+            files.push_back(it->path().lexically_relative(inputDir).generic_string());
+        }
+
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+} // namespace OutfitConverter
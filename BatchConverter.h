@@ -0,0 +1,85 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace OutfitConverter {
+
+    // ============== CONVERSION MANIFEST ==============
+    // One record per input file converted by the previous run. The manifest
+    // lets a re-run skip every file whose input and target settings are unchanged.
+    struct ManifestEntry {
+        std::string path;                   // Relative to the batch input directory
+        uint64_t size;
+        int64_t mtime;
+        uint64_t contentHash;
+        FormatConverter::FormatType format;
+        uint64_t settingsHash;              // Target formats + output directory
+        std::vector<uint64_t> outputHashes; // One per target format, in order
+
+        ManifestEntry() : size(0), mtime(0), contentHash(0),
+            format(FormatConverter::FormatType::UNKNOWN), settingsHash(0) {}
+    };
+
+    class ConversionManifest {
+    private:
+        std::unordered_map<std::string, ManifestEntry> entries;
+
+    public:
+        bool Load(const std::string& filepath);
+        bool Save(const std::string& filepath) const;
+
+        const ManifestEntry* Find(const std::string& path) const;
+        void Update(const ManifestEntry& entry);
+        void Clear() { entries.clear(); }
+        size_t Size() const { return entries.size(); }
+    };
+
+    // ============== BATCH CONVERTER ==============
+    struct BatchOptions {
+        std::string inputDir;
+        std::string outputDir;
+        std::vector<FormatConverter::FormatType> targetFormats;
+        std::string manifestPath;   // Empty disables incremental conversion
+        bool force;                 // Ignore the manifest and reconvert everything
+        unsigned threads;           // Worker threads, 0 = one per hardware thread
+
+        BatchOptions() : force(false), threads(0) {}
+    };
+
+    struct BatchResult {
+        size_t scanned;
+        size_t converted;
+        size_t skipped;
+        size_t failed;
+        std::vector<std::string> failedFiles;
+
+        BatchResult() : scanned(0), converted(0), skipped(0), failed(0) {}
+    };
+
+    class BatchConverter {
+    public:
+        // Convert every outfit file under inputDir into outputDir/<Format>/<relative path>
+        static BatchResult Run(const BatchOptions& options);
+
+        static std::string GetOutputPath(const BatchOptions& options,
+                                         const std::string& relativePath,
+                                         FormatConverter::FormatType target);
+        static uint64_t HashSettings(const BatchOptions& options);
+        static std::vector<std::string> CollectInputFiles(const std::string& inputDir,
+                                                          const std::string& excludeDir = "");
+
+        // Flags every file whose output path another file also maps to
+        // (e.g. a.json and a.txt both become Stand/a.txt)
+        static std::vector<char> FindOutputCollisions(const std::vector<std::string>& files);
+
+    private:
+        static bool OutputsExist(const BatchOptions& options, const std::string& relativePath);
+        static bool ConvertOne(const BatchOptions& options, const std::string& content,
+                               ManifestEntry& entry);
+    };
+
+} // namespace OutfitConverter
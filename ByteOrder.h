@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+namespace OutfitConverter {
+
+    // ============== LITTLE-ENDIAN FIELD ACCESS ==============
+    // On-disk integers are little-endian regardless of the host; these
+    // helpers read and write them at arbitrary (unaligned) byte positions.
+    inline void PutU16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    inline void PutU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    inline void PutU64(uint8_t* out, uint64_t value) {
+        for (int i = 0; i < 8; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    inline void PutI32(uint8_t* out, int value) {
+        PutU32(out, static_cast<uint32_t>(value));
+    }
+
+    inline void PutF32(uint8_t* out, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        PutU32(out, bits);
+    }
+
+    inline uint16_t GetU16(const uint8_t* in) {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    inline uint32_t GetU32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+               (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    inline uint64_t GetU64(const uint8_t* in) {
+        return static_cast<uint64_t>(GetU32(in)) | (static_cast<uint64_t>(GetU32(in + 4)) << 32);
+    }
+
+    inline int GetI32(const uint8_t* in) {
+        return static_cast<int32_t>(GetU32(in));
+    }
+
+    inline float GetF32(const uint8_t* in) {
+        uint32_t bits = GetU32(in);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,1659 @@
+#include "BatchConverter.h"
+#include "FanOutConverter.h"
+#include "FolderWatcher.h"
+#include "ConversionService.h"
+#include "FileHandler.h"
+#include "Parallel.h"
+#include "FormatClassifier.h"
+#include "FormatConverter.h"
+#include "OutfitBundle.h"
+#include "WardrobeContainer.h"
+#include "PackedOutfit.h"
+#include "OutfitDelta.h"
+#include "OutfitHistory.h"
+#include "OutfitDiff.h"
+#include "OutfitFingerprint.h"
+#include "OutfitIndex.h"
+#include "OutfitSimilarity.h"
+#include "OutfitFilter.h"
+#include "OutfitView.h"
+#include "OutfitTable.h"
+#include "OutfitExport.h"
+#include "OutfitValidation.h"
+#include "OutfitLint.h"
+#include "OutfitFidelity.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <csignal>
+#include <chrono>
+#include <iomanip>
+#include <filesystem>
+#include <limits>
+#include <cctype>
+
+using namespace OutfitConverter;
+namespace fs = std::filesystem;
+
+// ============== COMMAND LINE TOOL ==============
+// Headless front-end over the conversion core for scripted and nightly jobs.
+
+static void PrintUsage() {
+    std::cout <<
+        "Usage: OutfitConverterCli <command> [options]\n"
+        "\n"
+        "Commands:\n"
+        "  convert --input DIR --output DIR --to FORMAT[,FORMAT...]|all [--manifest FILE]\n"
+        "          [--force] [--threads N] [--durability none|file|batch]\n"
+        "      Convert every outfit under DIR. Each input is parsed once and written in\n"
+        "      every target format. With --manifest, files whose content and target\n"
+        "      settings are unchanged since the last run are skipped.\n"
+        "  fanout --input FILE --output BASE [--to FORMAT[,FORMAT...]|all]\n"
+        "      Convert one outfit to BASE_<Format>.<ext> for each target (default: all).\n"
+        "  watch --input DIR [--input DIR...] --output DIR --to FORMAT[,FORMAT...]|all\n"
+        "          [--debounce MS] [--poll MS] [--durability none|file|batch]\n"
+        "      Keep running and convert outfits as they are added or modified.\n"
+        "      Stop with Ctrl+C; pending files are converted before exit.\n"
+        "  detect --input DIR [--threads N]\n"
+        "      Print the detected format and confidence of every outfit file under\n"
+        "      DIR. Only the first few KB of each file are read unless the prefix\n"
+        "      is inconclusive.\n"
+        "  list --input DIR [--threads N]\n"
+        "      Print the format and model of every outfit file under DIR. Only the\n"
+        "      model is decoded, not the slots.\n"
+        "  serve --socket PATH\n"
+        "      Run a persistent conversion service on a Unix domain socket.\n"
+        "  request --socket PATH (--input FILE --to FORMAT [--output FILE] [--repeat N] | --stats)\n"
+        "      Send conversion requests to a running service and report latency.\n"
+        "  pack --input DIR|BUNDLE --output BUNDLE --to FORMAT [--layout array|ndjson]\n"
+        "      Write every outfit under DIR (or in another bundle) into one bundle\n"
+        "      file. Stand bundles separate outfits with a '---' line.\n"
+        "  unpack --input BUNDLE [--from FORMAT] --output DIR --to FORMAT[,FORMAT...]|all\n"
+        "      Stream the outfits of a bundle out to one file per outfit and format.\n"
+        "  import --input DIR|BUNDLE --output FILE.owb [--threads N]\n"
+        "      Store outfits in a binary wardrobe container with O(1) access by index.\n"
+        "  export --input FILE.owb --output DIR --to FORMAT[,FORMAT...]|all [--threads N]\n"
+        "      Write every outfit of a wardrobe container as text files.\n"
+        "  table --input DIR|FILE.owb --output FILE [--format csv|columnar] [--threads N]\n"
+        "      Export a library as one table row per outfit: CSV, or a columnar\n"
+        "      binary file of little-endian column arrays with a schema header.\n"
+        "      The format defaults to CSV for .csv outputs, columnar otherwise.\n"
+        "  archive --input FILE.owb|FILE.opk --output FILE.opk|FILE.owb\n"
+        "      Convert a wardrobe to the bit-packed archive format (64 bytes per\n"
+        "      outfit), or a packed archive back to a wardrobe.\n"
+        "  delta --input FILE.owb|FILE.ods --output FILE.ods|FILE.owb [--max-distance N]\n"
+        "      Store a wardrobe as deltas against automatically chosen base outfits,\n"
+        "      or expand a delta store back to a wardrobe.\n"
+        "  history --log FILE (--record DIR | --list | --show KEY | --get KEY --to FORMAT [--output FILE])\n"
+        "      Append the current state of every outfit under DIR to a history log\n"
+        "      (unchanged outfits are skipped), list tracked outfits, show the versions\n"
+        "      of one outfit, or write its latest version.\n"
+        "  diff --old DIR --new DIR [--patch FILE] [--threads N]\n"
+        "      List outfits added, removed or changed between two libraries, with\n"
+        "      per-slot changes. With --patch, also write them as a patch file.\n"
+        "  patch --input FILE --library DIR [--force] [--threads N]\n"
+        "      Apply a patch file to a library. Outfits that no longer match the\n"
+        "      patch's old values are reported as conflicts unless --force is given.\n"
+        "  dedup --input DIR [--threads N] [--ignore-model] [--list]\n"
+        "      Group outfits under DIR that are the same look, whatever their format\n"
+        "      or formatting. --list prints every file's fingerprint instead.\n"
+        "      YimMenu files written without a model load as male; use\n"
+        "      --ignore-model to match them against other formats.\n"
+        "  index --input DIR|FILE.owb --output FILE.oix [--threads N]\n"
+        "      Build an inverted index of which outfits use which slot values.\n"
+        "  query --index FILE.oix [--count] TERM [TERM...]\n"
+        "      List outfits matching every TERM, written SLOT[=DRAWABLE[:TEXTURE]]\n"
+        "      with SLOT a Cherax slot name or componentN/propN, e.g. Torso=15:2 Hat.\n"
+        "  similar --input DIR|FILE.owb --like FILE [--top K] [--same-model] [--threads N]\n"
+        "      List the K outfits (default 10) most similar to FILE, scoring matching\n"
+        "      slots by importance (jacket, torso, legs and feet count most).\n"
+        "  select --input DIR|FILE.owb --where EXPR [--index FILE.oix] [--count] [--threads N]\n"
+        "      List outfits matching EXPR, e.g. \"model == female AND props.Hat != -1\n"
+        "      AND components.Legs.drawable in [10..20]\". With an index built from the\n"
+        "      same library, only its candidates are loaded.\n"
+        "  stats --input DIR|FILE.owb [--column COLUMN]... [--where EXPR] [--top N] [--threads N]\n"
+        "      Per-column statistics over a library loaded column-wise: rows, min,\n"
+        "      max, distinct values and the N most used values (default 5).\n"
+        "      COLUMN is model or SLOT[.drawable|.texture|.palette], e.g. Torso.texture;\n"
+        "      default: every component and prop drawable.\n"
+        "  validate --input DIR|FILE.owb [--limits FILE] [--threads N]\n"
+        "      Check every outfit against per-model slot limits (default: the\n"
+        "      built-in ranges for the freemode models) and list the violations.\n"
+        "      Limits files hold one \"MODEL SLOT DRAWABLE TEXTURE\" rule per line,\n"
+        "      e.g. \"male Torso 0..195 0..15\" or \"* props -1..199 *\".\n"
+        "  lint --input DIR [--report FILE] [--format json|csv] [--limits FILE]\n"
+        "       [--targets FORMATS] [--strict] [--threads N]\n"
+        "      Check every file: unreadable, unknown format, malformed, out of range\n"
+        "      (errors); ambiguous format, extension mismatch, lossy round trip through\n"
+        "      a target format (warnings). Writes a JSON or CSV report (CSV for .csv\n"
+        "      reports) or lists problem files. Exits 1 on errors, or on warnings\n"
+        "      with --strict. Targets default to every format.\n"
+        "  fidelity --input DIR|FILE.owb [--repeat N] [--threads N]\n"
+        "      Run every A -> B -> A conversion path across the four formats over the\n"
+        "      library and report per-slot loss rates for each path, and time per\n"
+        "      outfit and throughput for each converter (repeated N times, default 1).\n"
+        "\n"
+        "Formats: cherax, yim, lexis, stand\n"
+        "Durability: none (rename only, default), file (fsync every output),\n"
+        "            batch (one group sync when the batch finishes)\n";
+}
+
+static bool ParseFormatList(const std::string& value, std::vector<FormatConverter::FormatType>& formats) {
+    if (value == "all") {
+        formats = FanOutConverter::AllFormats();
+        return true;
+    }
+
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t comma = value.find(',', start);
+        std::string name = value.substr(start, comma - start);
+        FormatConverter::FormatType format = FormatConverter::FormatTypeFromName(name);
+        if (format == FormatConverter::FormatType::UNKNOWN) {
+            std::cerr << "Unknown format: " << name << "\n";
+            return false;
+        }
+        formats.push_back(format);
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return !formats.empty();
+}
+
+static bool ParseCount(const std::string& value, unsigned& count) {
+    // stoul would wrap "-1" and stop quietly at "4x"
+    try {
+        size_t used = 0;
+        if (!value.empty() && std::isdigit(static_cast<unsigned char>(value[0]))) {
+            const unsigned long parsed = std::stoul(value, &used);
+            if (used == value.size() && parsed <= std::numeric_limits<unsigned>::max()) {
+                count = static_cast<unsigned>(parsed);
+                return true;
+            }
+        }
+    } catch (...) {
+    }
+    std::cerr << "Invalid number: " << value << "\n";
+    return false;
+}
+
+static bool ParseDurabilityOption(const std::string& value) {
+    Durability policy;
+    if (!FileHandler::ParseDurability(value, policy)) {
+        std::cerr << "Unknown durability policy: " << value << "\n";
+        return false;
+    }
+    FileHandler::SetDurability(policy);
+    return true;
+}
+
+static int RunConvert(const std::vector<std::string>& args) {
+    BatchOptions options;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) options.inputDir = args[++i];
+        else if (arg == "--output" && hasValue) options.outputDir = args[++i];
+        else if (arg == "--manifest" && hasValue) options.manifestPath = args[++i];
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], options.targetFormats)) return 2;
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], options.threads)) return 2;
+        }
+        else if (arg == "--durability" && hasValue) {
+            if (!ParseDurabilityOption(args[++i])) return 2;
+        }
+        else if (arg == "--force") options.force = true;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (options.inputDir.empty() || options.outputDir.empty() || options.targetFormats.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    BatchResult result = BatchConverter::Run(options);
+
+    std::cout << "Scanned: " << result.scanned
+              << "  Converted: " << result.converted
+              << "  Skipped: " << result.skipped
+              << "  Failed: " << result.failed << "\n";
+    for (const auto& file : result.failedFiles) {
+        std::cerr << "Failed: " << file << "\n";
+    }
+
+    return result.failed == 0 ? 0 : 1;
+}
+
+static int RunFanOut(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputBase;
+    std::vector<FormatConverter::FormatType> targets;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputBase = args[++i];
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], targets)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputBase.empty()) {
+        PrintUsage();
+        return 2;
+    }
+    if (targets.empty()) targets = FanOutConverter::AllFormats();
+
+    if (!FanOutConverter::ConvertFile(inputPath, outputBase, targets)) {
+        std::cerr << "Failed to convert " << inputPath << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+static int RunDetect(const std::vector<std::string>& args) {
+    std::string inputDir;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputDir = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputDir.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputDir);
+    std::vector<Classification> results(files.size());
+    ParallelFor(files.size(), threads, [&](size_t index, unsigned) {
+        results[index] = FormatClassifier::Instance().ClassifyFile((fs::path(inputDir) / files[index]).string());
+    });
+
+    size_t counts[5] = { 0, 0, 0, 0, 0 };
+    for (size_t i = 0; i < files.size(); i++) {
+        std::cout << FormatConverter::FormatTypeToName(results[i].format) << "\t"
+                  << results[i].confidence << "\t" << files[i] << "\n";
+        counts[static_cast<int>(results[i].format)]++;
+    }
+
+    std::cerr << "Cherax: " << counts[0] << "  YimMenu: " << counts[1]
+              << "  Lexis: " << counts[2] << "  Stand: " << counts[3]
+              << "  Unknown: " << counts[4] << "\n";
+    return 0;
+}
+
+static int RunList(const std::vector<std::string>& args) {
+    std::string inputDir;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputDir = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputDir.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputDir);
+    std::vector<FormatConverter::FormatType> formats(files.size(), FormatConverter::FormatType::UNKNOWN);
+    std::vector<uint32_t> models(files.size(), 0);
+    ParallelFor(files.size(), threads, [&](size_t index, unsigned) {
+        OutfitView view;
+        if (view.Open((fs::path(inputDir) / files[index]).string())) {
+            formats[index] = view.GetFormat();
+            models[index] = view.GetModel();
+        }
+    });
+
+    size_t unreadable = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (formats[i] == FormatConverter::FormatType::UNKNOWN) {
+            unreadable++;
+            std::cout << "Unknown\t-\t" << files[i] << "\n";
+            continue;
+        }
+        std::string model = std::to_string(models[i]);
+        for (const auto& pair : ComponentMapping::STAND_MODEL_MAP) {
+            if (pair.second == models[i]) model = pair.first;
+        }
+        std::cout << FormatConverter::FormatTypeToName(formats[i]) << "\t" << model << "\t" << files[i] << "\n";
+    }
+    std::cerr << "Listed: " << files.size() << " files";
+    if (unreadable > 0) std::cerr << ", " << unreadable << " unrecognized";
+    std::cerr << "\n";
+    return 0;
+}
+
+static int RunPack(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputPath;
+    std::vector<FormatConverter::FormatType> targets;
+    BundleLayout layout = BundleLayout::JSON_ARRAY;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], targets)) return 2;
+        }
+        else if (arg == "--layout" && hasValue) {
+            if (!OutfitBundle::ParseLayout(args[++i], layout)) {
+                std::cerr << "Unknown bundle layout: " << args[i] << "\n";
+                return 2;
+            }
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty() || targets.size() != 1) {
+        PrintUsage();
+        return 2;
+    }
+
+    BundleWriter writer;
+    if (!writer.Open(outputPath, targets[0], layout)) {
+        std::cerr << "Failed to create " << outputPath << "\n";
+        return 1;
+    }
+
+    size_t failed = 0;
+    std::error_code ec;
+    if (fs::is_directory(inputPath, ec)) {
+        for (const auto& file : BatchConverter::CollectInputFiles(inputPath)) {
+            const std::string path = (fs::path(inputPath) / file).string();
+            YimOutfit outfit;
+            if (!FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), outfit) ||
+                !writer.Write(outfit)) {
+                std::cerr << "Failed: " << file << "\n";
+                failed++;
+            }
+        }
+    } else {
+        // Bundle to bundle: one outfit in memory at a time
+        BundleReader reader;
+        if (!reader.Open(inputPath)) {
+            std::cerr << "Failed to open " << inputPath << "\n";
+            return 1;
+        }
+        YimOutfit outfit;
+        while (reader.Next(outfit)) {
+            if (!writer.Write(outfit)) failed++;
+        }
+        if (reader.HasError()) {
+            std::cerr << "Malformed bundle after " << reader.GetCount() << " outfits\n";
+            return 1;
+        }
+    }
+
+    const size_t packed = writer.GetCount();
+    if (!writer.Close()) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return 1;
+    }
+
+    std::cout << "Packed: " << packed << "  Failed: " << failed << "\n";
+    return failed == 0 ? 0 : 1;
+}
+
+static int RunUnpack(const std::vector<std::string>& args) {
+    std::string inputPath;
+    FormatConverter::FormatType sourceFormat = FormatConverter::FormatType::UNKNOWN;
+    BatchOptions layout;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) layout.outputDir = args[++i];
+        else if (arg == "--from" && hasValue) {
+            sourceFormat = FormatConverter::FormatTypeFromName(args[++i]);
+            if (sourceFormat == FormatConverter::FormatType::UNKNOWN) {
+                std::cerr << "Unknown format: " << args[i] << "\n";
+                return 2;
+            }
+        }
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], layout.targetFormats)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || layout.outputDir.empty() || layout.targetFormats.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    BundleReader reader;
+    if (!reader.Open(inputPath, sourceFormat)) {
+        std::cerr << "Failed to open " << inputPath << "\n";
+        return 1;
+    }
+
+    const std::string stem = fs::path(inputPath).stem().string();
+    std::vector<std::string> outputs;
+    YimOutfit outfit;
+    size_t failed = 0;
+
+    while (reader.Next(outfit)) {
+        FanOutConverter::SerializeAll(outfit, layout.targetFormats, outputs);
+
+        std::string number = std::to_string(reader.GetCount());
+        number.insert(0, number.size() < 6 ? 6 - number.size() : 0, '0');
+        for (size_t i = 0; i < layout.targetFormats.size(); i++) {
+            std::string outputPath = BatchConverter::GetOutputPath(layout, stem + "_" + number, layout.targetFormats[i]);
+            std::error_code ec;
+            fs::create_directories(fs::path(outputPath).parent_path(), ec);
+            if (!FileHandler::WriteFileContent(outputPath, outputs[i])) failed++;
+        }
+    }
+    FileHandler::FlushPendingWrites();
+
+    if (reader.HasError()) {
+        std::cerr << "Malformed bundle after " << reader.GetCount() << " outfits\n";
+        return 1;
+    }
+
+    std::cout << "Unpacked: " << reader.GetCount() << "  Failed writes: " << failed << "\n";
+    return failed == 0 ? 0 : 1;
+}
+
+static int RunWardrobeTransfer(const std::vector<std::string>& args, bool import) {
+    std::string inputPath;
+    std::string outputPath;
+    std::vector<FormatConverter::FormatType> targets;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--to" && hasValue && !import) {
+            if (!ParseFormatList(args[++i], targets)) return 2;
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty() || (!import && targets.empty())) {
+        PrintUsage();
+        return 2;
+    }
+
+    WardrobeTransferResult result = import
+        ? WardrobeTransfer::Import(inputPath, outputPath, threads)
+        : WardrobeTransfer::Export(inputPath, outputPath, targets, threads);
+
+    std::cout << (import ? "Imported: " : "Exported: ") << result.outfits
+              << "  Failed: " << result.failed << "\n";
+    for (const auto& item : result.failedItems) {
+        std::cerr << "Failed: " << item << "\n";
+    }
+    return result.failed == 0 ? 0 : 1;
+}
+
+static int RunArchive(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputPath;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    PackedArchive archive;
+    YimOutfit outfit;
+
+    // A packed archive unpacks to a wardrobe; anything else must be a wardrobe
+    if (archive.Load(inputPath)) {
+        WardrobeWriter writer;
+        bool success = writer.Open(outputPath);
+        for (size_t i = 0; success && i < archive.Size(); i++) {
+            success = archive.Get(i, outfit) && writer.Add(outfit);
+        }
+        if (!success || !writer.Close()) {
+            std::cerr << "Failed to write " << outputPath << "\n";
+            return 1;
+        }
+        std::cout << "Unpacked: " << archive.Size() << "\n";
+        return 0;
+    }
+
+    WardrobeFile wardrobe;
+    if (!wardrobe.Open(inputPath)) {
+        std::cerr << "Not a wardrobe or packed archive: " << inputPath << "\n";
+        return 1;
+    }
+    size_t failed = 0;
+    for (size_t i = 0; i < wardrobe.GetCount(); i++) {
+        if (!wardrobe.Get(i, outfit)) {
+            std::cerr << "Failed: #" << i << "\n";
+            failed++;
+            continue;
+        }
+        archive.Add(outfit);
+    }
+    if (!archive.Save(outputPath)) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return 1;
+    }
+
+    std::cout << "Packed: " << archive.Size() << "  Overflow: " << archive.GetOverflowCount()
+              << "  Bytes: " << archive.GetByteSize() << "  Failed: " << failed << "\n";
+    return failed == 0 ? 0 : 1;
+}
+
+static int RunDelta(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputPath;
+    unsigned maxDistance = DeltaStore::DEFAULT_MAX_DISTANCE;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--max-distance" && hasValue) {
+            if (!ParseCount(args[++i], maxDistance)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    DeltaStore store(maxDistance);
+    YimOutfit outfit;
+
+    if (store.Load(inputPath)) {
+        WardrobeWriter writer;
+        bool success = writer.Open(outputPath);
+        for (size_t i = 0; success && i < store.Size(); i++) {
+            success = store.Get(i, outfit) && writer.Add(outfit);
+        }
+        if (!success || !writer.Close()) {
+            std::cerr << "Failed to write " << outputPath << "\n";
+            return 1;
+        }
+        std::cout << "Expanded: " << store.Size() << "\n";
+        return 0;
+    }
+
+    WardrobeFile wardrobe;
+    if (!wardrobe.Open(inputPath)) {
+        std::cerr << "Not a wardrobe or delta store: " << inputPath << "\n";
+        return 1;
+    }
+
+    size_t changes = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < wardrobe.GetCount(); i++) {
+        if (!wardrobe.Get(i, outfit)) {
+            std::cerr << "Failed: #" << i << "\n";
+            failed++;
+            continue;
+        }
+        changes += store.GetDelta(store.Add(outfit)).ChangeCount();
+    }
+    if (!store.Save(outputPath)) {
+        std::cerr << "Failed to write " << outputPath << "\n";
+        return 1;
+    }
+
+    std::cout << "Outfits: " << store.Size() << "  Bases: " << store.GetBaseCount()
+              << "  Changed slots: " << changes << "  Failed: " << failed << "\n";
+    return failed == 0 ? 0 : 1;
+}
+
+static int RunHistory(const std::vector<std::string>& args) {
+    std::string logPath;
+    std::string recordDir;
+    std::string showKey;
+    std::string getKey;
+    std::string outputPath;
+    std::vector<FormatConverter::FormatType> targets;
+    bool list = false;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--log" && hasValue) logPath = args[++i];
+        else if (arg == "--record" && hasValue) recordDir = args[++i];
+        else if (arg == "--show" && hasValue) showKey = args[++i];
+        else if (arg == "--get" && hasValue) getKey = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], targets)) return 2;
+        }
+        else if (arg == "--list") list = true;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    const int modes = !recordDir.empty() + !showKey.empty() + !getKey.empty() + list;
+    if (logPath.empty() || modes != 1 || (!getKey.empty() && targets.size() != 1)) {
+        PrintUsage();
+        return 2;
+    }
+
+    OutfitHistory history;
+    if (!history.Open(logPath)) {
+        std::cerr << "Failed to open history log " << logPath << "\n";
+        return 1;
+    }
+
+    if (!recordDir.empty()) {
+        size_t changed = 0;
+        size_t failed = 0;
+        const std::vector<std::string> files = BatchConverter::CollectInputFiles(recordDir);
+        for (const auto& file : files) {
+            const std::string path = (fs::path(recordDir) / file).string();
+            const uint64_t before = history.GetVersionCount(file);
+            YimOutfit outfit;
+            if (!FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), outfit) ||
+                !history.Record(file, outfit)) {
+                std::cerr << "Failed: " << file << "\n";
+                failed++;
+            } else if (history.GetVersionCount(file) != before) {
+                changed++;
+            }
+        }
+        if (!history.Flush()) failed++;
+
+        std::cout << "Scanned: " << files.size() << "  Recorded: " << changed
+                  << "  Failed: " << failed << "\n";
+        return failed == 0 ? 0 : 1;
+    }
+
+    if (list) {
+        for (const auto& key : history.GetKeys()) {
+            std::cout << history.GetVersionCount(key) << "\t" << key << "\n";
+        }
+        return 0;
+    }
+
+    if (!showKey.empty()) {
+        bool found = history.Replay(showKey, [](const HistoryEntry& entry, const YimOutfit& outfit) {
+            std::cout << entry.sequence << "\t" << entry.timestamp << "\t"
+                      << (entry.snapshot ? "snapshot" : "delta") << "\t"
+                      << outfit.components.size() << " components, "
+                      << outfit.props.size() << " props\n";
+        });
+        if (!found) {
+            std::cerr << "No history for " << showKey << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    YimOutfit outfit;
+    if (!history.GetLatest(getKey, outfit)) {
+        std::cerr << "No history for " << getKey << "\n";
+        return 1;
+    }
+    std::string content = FormatConverter::SerializeFromYim(outfit, targets[0]);
+    if (outputPath.empty()) {
+        std::cout << content;
+        return 0;
+    }
+    return FileHandler::WriteFileContent(outputPath, content) ? 0 : 1;
+}
+
+static int RunDiff(const std::vector<std::string>& args) {
+    std::string oldDir;
+    std::string newDir;
+    std::string patchPath;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--old" && hasValue) oldDir = args[++i];
+        else if (arg == "--new" && hasValue) newDir = args[++i];
+        else if (arg == "--patch" && hasValue) patchPath = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (oldDir.empty() || newDir.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    const std::vector<LibraryDiffEntry> entries = LibraryDiff::Run(oldDir, newDir, threads);
+    size_t added = 0, removed = 0, changed = 0, failed = 0;
+    for (const auto& entry : entries) {
+        switch (entry.status) {
+        case LibraryDiffEntry::Status::ADDED: added++; std::cout << "A\t"; break;
+        case LibraryDiffEntry::Status::REMOVED: removed++; std::cout << "D\t"; break;
+        case LibraryDiffEntry::Status::CHANGED: changed++; std::cout << "M\t"; break;
+        case LibraryDiffEntry::Status::FAILED: failed++; std::cout << "!\t"; break;
+        }
+        std::cout << entry.path << "\n";
+        if (entry.status == LibraryDiffEntry::Status::CHANGED) {
+            for (const auto& change : entry.changes) {
+                std::cout << "\t" << OutfitDiffer::Describe(change) << "\n";
+            }
+        }
+    }
+    std::cout << "Added: " << added << "  Removed: " << removed << "  Changed: " << changed
+              << "  Failed: " << failed << "\n";
+
+    if (!patchPath.empty() && !FileHandler::WriteFileContent(patchPath, LibraryDiff::FormatPatch(entries))) {
+        std::cerr << "Failed to write " << patchPath << "\n";
+        return 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+static int RunPatch(const std::vector<std::string>& args) {
+    std::string patchPath;
+    std::string libraryDir;
+    unsigned threads = 0;
+    bool force = false;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) patchPath = args[++i];
+        else if (arg == "--library" && hasValue) libraryDir = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else if (arg == "--force") force = true;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (patchPath.empty() || libraryDir.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<LibraryDiffEntry> entries;
+    if (!FileHandler::FileExists(patchPath) ||
+        !LibraryDiff::ParsePatch(FileHandler::ReadFileContent(patchPath), entries)) {
+        std::cerr << "Invalid patch file " << patchPath << "\n";
+        return 1;
+    }
+
+    const PatchResult result = LibraryDiff::ApplyPatch(entries, libraryDir, force, threads);
+    for (const auto& problem : result.problems) {
+        std::cerr << problem << "\n";
+    }
+    std::cout << "Applied: " << result.applied << "  Conflicts: " << result.conflicts
+              << "  Failed: " << result.failed << "\n";
+    return result.conflicts == 0 && result.failed == 0 ? 0 : 1;
+}
+
+static int RunDedup(const std::vector<std::string>& args) {
+    std::string inputDir;
+    unsigned threads = 0;
+    bool list = false;
+    bool includeModel = true;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputDir = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else if (arg == "--list") list = true;
+        else if (arg == "--ignore-model") includeModel = false;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputDir.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    if (list) {
+        const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputDir);
+        std::vector<std::string> lines(files.size());
+        ParallelFor(files.size(), threads, [&](size_t index, unsigned) {
+            const std::string path = (fs::path(inputDir) / files[index]).string();
+            YimOutfit outfit;
+            lines[index] = FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), outfit)
+                ? OutfitFingerprint::Compute(outfit, includeModel).ToHex() : std::string(32, '-');
+        });
+        for (size_t i = 0; i < files.size(); i++) {
+            std::cout << lines[i] << "\t" << files[i] << "\n";
+        }
+        return 0;
+    }
+
+    const DedupResult result = LibraryDedup::Run(inputDir, threads, includeModel);
+    size_t redundant = 0;
+    for (const auto& group : result.groups) {
+        std::cout << group.fingerprint.ToHex() << "\t" << group.paths.size() << "\n";
+        for (const auto& path : group.paths) {
+            std::cout << "\t" << path << "\n";
+        }
+        redundant += group.paths.size() - 1;
+    }
+    for (const auto& item : result.failedItems) {
+        std::cerr << "Failed: " << item << "\n";
+    }
+    std::cout << "Files: " << result.files << "  Unique: " << result.unique
+              << "  Duplicate groups: " << result.groups.size() << "  Redundant: " << redundant
+              << "  Failed: " << result.failed << "\n";
+    return result.failed == 0 ? 0 : 1;
+}
+
+static int RunIndex(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputPath;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    const IndexBuildResult result = OutfitIndex::Build(inputPath, outputPath, threads);
+    for (const auto& item : result.failedItems) {
+        std::cerr << "Failed: " << item << "\n";
+    }
+    std::cout << "Indexed: " << result.outfits << "  Terms: " << result.terms
+              << "  Failed: " << result.failed << "\n";
+    return result.failed == 0 ? 0 : 1;
+}
+
+static int RunQuery(const std::vector<std::string>& args) {
+    std::string indexPath;
+    std::vector<IndexTerm> terms;
+    bool countOnly = false;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--index" && hasValue) indexPath = args[++i];
+        else if (arg == "--count") countOnly = true;
+        else {
+            IndexTerm term;
+            if (arg.compare(0, 2, "--") == 0 || !IndexTerm::Parse(arg, term)) {
+                std::cerr << "Invalid term: " << arg << "\n";
+                return 2;
+            }
+            terms.push_back(term);
+        }
+    }
+
+    if (indexPath.empty() || terms.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    OutfitIndex index;
+    if (!index.Open(indexPath)) {
+        std::cerr << "Failed to open index " << indexPath << "\n";
+        return 1;
+    }
+
+    const std::vector<uint32_t> ids = index.Query(terms);
+    if (!countOnly) {
+        for (uint32_t id : ids) {
+            std::string name = index.GetName(id);
+            std::cout << (name.empty() ? "#" + std::to_string(id) : name) << "\n";
+        }
+    }
+    std::cout << "Matches: " << ids.size() << " of " << index.GetOutfitCount() << "\n";
+    return 0;
+}
+
+static int RunSimilar(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string likePath;
+    unsigned top = 10;
+    unsigned threads = 0;
+    bool sameModel = false;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--like" && hasValue) likePath = args[++i];
+        else if (arg == "--top" && hasValue) {
+            if (!ParseCount(args[++i], top)) return 2;
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else if (arg == "--same-model") sameModel = true;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || likePath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    YimOutfit query;
+    if (!FormatConverter::LoadAsYim(likePath, FormatConverter::DetectFormat(likePath), query)) {
+        std::cerr << "Failed to load " << likePath << "\n";
+        return 1;
+    }
+
+    SimilarityIndex index;
+    std::vector<std::string> names;
+    if (!index.AddLibrary(inputPath, names, threads) && index.Size() == 0) {
+        std::cerr << "Failed to load library " << inputPath << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const std::vector<SimilarityMatch> matches = index.TopK(query, top, threads, sameModel);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    const uint32_t best = index.Score(query, query);
+    for (const auto& match : matches) {
+        const std::string& name = names[match.id];
+        std::cout << match.score << "/" << best << "\t"
+                  << (name.empty() ? "#" + std::to_string(match.id) : name) << "\n";
+    }
+    std::cout << "Searched: " << index.Size() << " outfits in " << elapsed / 1000.0 << " ms\n";
+    return 0;
+}
+
+static int RunSelect(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string expression;
+    std::string indexPath;
+    unsigned threads = 0;
+    bool countOnly = false;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--where" && hasValue) expression = args[++i];
+        else if (arg == "--index" && hasValue) indexPath = args[++i];
+        else if (arg == "--count") countOnly = true;
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || expression.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    OutfitFilter filter;
+    std::string error;
+    if (!filter.Compile(expression, error)) {
+        std::cerr << "Invalid filter: " << error << "\n";
+        return 2;
+    }
+
+    OutfitIndex index;
+    if (!indexPath.empty() && !index.Open(indexPath)) {
+        std::cerr << "Failed to open index " << indexPath << "\n";
+        return 1;
+    }
+
+    const SelectResult result = LibrarySelect::Run(inputPath, filter, indexPath.empty() ? nullptr : &index, threads);
+    if (!countOnly) {
+        for (const auto& name : result.matches) std::cout << name << "\n";
+    }
+    for (const auto& item : result.failedItems) std::cerr << "Failed: " << item << "\n";
+    std::cout << "Matches: " << result.matches.size() << " of " << result.scanned << " scanned";
+    if (result.failed > 0) std::cout << ", " << result.failed << " failed";
+    std::cout << "\n";
+    return result.failed > 0 ? 1 : 0;
+}
+
+static int RunStats(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string expression;
+    std::vector<size_t> columns;
+    unsigned top = 5;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--where" && hasValue) expression = args[++i];
+        else if (arg == "--column" && hasValue) {
+            size_t column;
+            if (!OutfitTable::ParseColumn(args[++i], column)) {
+                std::cerr << "Unknown column: " << args[i] << "\n";
+                return 2;
+            }
+            columns.push_back(column);
+        }
+        else if (arg == "--top" && hasValue) {
+            if (!ParseCount(args[++i], top)) return 2;
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+    if (columns.empty()) {
+        for (int slot = 0; slot < 12; slot++) columns.push_back(OutfitTable::ComponentColumn(slot, 0));
+        for (int slot = 0; slot < 9; slot++) columns.push_back(OutfitTable::PropColumn(slot, 0));
+    }
+
+    OutfitFilter filter;
+    std::string error;
+    if (!expression.empty() && !filter.Compile(expression, error)) {
+        std::cerr << "Invalid filter: " << error << "\n";
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    OutfitTable table;
+    if (!table.Load(inputPath, threads) && table.Size() == 0) {
+        std::cerr << "Failed to load library " << inputPath << "\n";
+        return 1;
+    }
+    auto loaded = std::chrono::steady_clock::now();
+
+    std::vector<uint8_t> mask;
+    const std::vector<uint8_t>* rows = nullptr;
+    if (filter.IsCompiled()) {
+        if (!table.Select(filter, mask)) {
+            std::cerr << "Filters over blend fields are not supported here\n";
+            return 2;
+        }
+        rows = &mask;
+    }
+
+    for (size_t column : columns) {
+        const ColumnStats stats = table.MinMax(column, rows);
+        std::vector<ValueCount> histogram = table.Histogram(column, rows);
+        std::cout << OutfitTable::ColumnName(column) << ": rows " << stats.count;
+        if (stats.count > 0) {
+            std::cout << ", min " << stats.min << ", max " << stats.max << ", distinct " << histogram.size();
+        }
+        std::cout << "\n";
+
+        const size_t shown = std::min<size_t>(top, histogram.size());
+        std::partial_sort(histogram.begin(), histogram.begin() + shown, histogram.end(),
+                          [](const ValueCount& a, const ValueCount& b) {
+                              return a.count != b.count ? a.count > b.count : a.value < b.value;
+                          });
+        for (size_t i = 0; i < shown; i++) {
+            std::cout << "    " << histogram[i].value << "\t" << histogram[i].count << "\n";
+        }
+    }
+
+    auto finished = std::chrono::steady_clock::now();
+    std::cout << "Loaded: " << table.Size() << " outfits in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(loaded - start).count() << " ms, statistics in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(finished - loaded).count() / 1000.0 << " ms\n";
+    return 0;
+}
+
+static int RunTable(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputPath;
+    std::string formatName;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--format" && hasValue) formatName = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty() || outputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    TableFormat format = fs::path(outputPath).extension() == ".csv" ? TableFormat::CSV : TableFormat::COLUMNAR;
+    if (formatName == "csv") format = TableFormat::CSV;
+    else if (formatName == "columnar") format = TableFormat::COLUMNAR;
+    else if (!formatName.empty()) {
+        std::cerr << "Unknown table format: " << formatName << "\n";
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const TableExportResult result = TableExport::Run(inputPath, outputPath, format, threads);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& item : result.failedItems) std::cerr << "Failed: " << item << "\n";
+    std::cout << "Exported: " << result.outfits << "  Failed: " << result.failed
+              << "  (" << elapsed << " ms)\n";
+    return result.failed > 0 ? 1 : 0;
+}
+
+static int RunValidate(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string limitsPath;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--limits" && hasValue) limitsPath = args[++i];
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    OutfitLimits limits;
+    std::string error;
+    if (!limitsPath.empty() && !limits.Load(limitsPath, error)) {
+        std::cerr << "Invalid limits file " << limitsPath << ": " << error << "\n";
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    OutfitTable table;
+    if (!table.Load(inputPath, threads) && table.Size() == 0) {
+        std::cerr << "Failed to load library " << inputPath << "\n";
+        return 1;
+    }
+    auto loaded = std::chrono::steady_clock::now();
+
+    std::vector<uint64_t> violations;
+    const size_t invalid = BatchValidator::Validate(table, limits, violations);
+    auto finished = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < violations.size(); i++) {
+        if (violations[i] != 0) {
+            const std::string& name = table.GetName(i);
+            std::cout << (name.empty() ? "#" + std::to_string(i) : name) << "\t"
+                      << BatchValidator::Describe(violations[i]) << "\n";
+        }
+    }
+
+    std::cerr << "Validated: " << table.Size() << " outfits, " << invalid << " with violations (loaded in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(loaded - start).count() << " ms, checked in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(finished - loaded).count() / 1000.0 << " ms)\n";
+    return invalid > 0 ? 1 : 0;
+}
+
+static int RunLint(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string reportPath;
+    std::string formatName;
+    std::string limitsPath;
+    std::vector<FormatConverter::FormatType> targets;
+    bool strict = false;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--report" && hasValue) reportPath = args[++i];
+        else if (arg == "--format" && hasValue) formatName = args[++i];
+        else if (arg == "--limits" && hasValue) limitsPath = args[++i];
+        else if (arg == "--targets" && hasValue) {
+            if (!ParseFormatList(args[++i], targets)) return 2;
+        }
+        else if (arg == "--strict") strict = true;
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    LintReportFormat format = fs::path(reportPath).extension() == ".csv" ? LintReportFormat::CSV
+                                                                          : LintReportFormat::JSON;
+    if (formatName == "csv") format = LintReportFormat::CSV;
+    else if (formatName == "json") format = LintReportFormat::JSON;
+    else if (!formatName.empty()) {
+        std::cerr << "Unknown report format: " << formatName << "\n";
+        return 2;
+    }
+
+    OutfitLimits limits;
+    std::string error;
+    if (!limitsPath.empty() && !limits.Load(limitsPath, error)) {
+        std::cerr << "Invalid limits file " << limitsPath << ": " << error << "\n";
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const LintResult result = LibraryLint::Run(inputPath, limits, targets, threads);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    if (!reportPath.empty()) {
+        if (!LibraryLint::WriteReport(reportPath, result, format)) {
+            std::cerr << "Failed to write report " << reportPath << "\n";
+            return 1;
+        }
+    } else {
+        for (const auto& record : result.records) {
+            if (record.issues != 0) {
+                std::cout << record.path << "\t" << LibraryLint::DescribeIssues(record.issues) << "\n";
+            }
+        }
+    }
+
+    std::cerr << "Linted: " << result.scanned << " files, " << result.errors << " with errors, "
+              << result.warnings << " with warnings only (" << elapsed << " ms)\n";
+    return result.errors > 0 || (strict && result.warnings > 0) ? 1 : 0;
+}
+
+static int RunFidelity(const std::vector<std::string>& args) {
+    std::string inputPath;
+    unsigned repeat = 1;
+    unsigned threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--repeat" && hasValue) {
+            if (!ParseCount(args[++i], repeat)) return 2;
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseCount(args[++i], threads)) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    const FidelityResult result = FidelityMatrix::Run(inputPath, threads, repeat);
+    for (const auto& item : result.failedItems) {
+        std::cerr << "Failed: " << item << "\n";
+    }
+    if (result.outfits == 0) {
+        std::cerr << "No outfits loaded from " << inputPath << "\n";
+        return 1;
+    }
+
+    // Converter names as in FormatConverter, indexed by FormatType
+    static const char* const NAMES[] = { "Cherax", "Yim", "Lexis", "Stand" };
+    auto percent = [&](size_t count) { return 100.0 * count / result.outfits; };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Round trips over " << result.outfits << " outfits (lost slots, % of outfits):\n";
+    for (const auto& path : result.paths) {
+        const char* from = NAMES[static_cast<int>(path.from)];
+        std::cout << "  " << from << " -> " << NAMES[static_cast<int>(path.via)] << " -> " << from << ": "
+                  << percent(path.lossy) << "% lossy";
+        const char* separator = ": ";
+        for (int slot = 0; slot < FidelityPath::SLOTS; slot++) {
+            if (path.slotLoss[slot] == 0) continue;
+            std::cout << separator << FidelityMatrix::SlotName(slot) << " " << percent(path.slotLoss[slot]) << "%";
+            separator = ", ";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "Converters (per thread):\n";
+    for (const auto& timing : result.converters) {
+        const double nanoseconds = timing.calls ? static_cast<double>(timing.nanoseconds) / timing.calls : 0.0;
+        std::cout << "  " << std::left << std::setw(14)
+                  << std::string(NAMES[static_cast<int>(timing.from)]) + "To" + NAMES[static_cast<int>(timing.to)]
+                  << std::right << std::setw(10) << nanoseconds << " ns/outfit" << std::setw(14)
+                  << (nanoseconds > 0.0 ? 1e9 / nanoseconds : 0.0) << " outfits/s\n";
+    }
+    return result.failed > 0 ? 1 : 0;
+}
+
+static std::atomic<bool> stopRequested(false);
+
+static void HandleStopSignal(int) {
+    stopRequested = true;
+}
+
+static int RunWatch(const std::vector<std::string>& args) {
+    WatchOptions options;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--input" && hasValue) options.inputDirs.push_back(args[++i]);
+        else if (arg == "--output" && hasValue) options.outputDir = args[++i];
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], options.targetFormats)) return 2;
+        }
+        else if (arg == "--debounce" && hasValue) {
+            if (!ParseCount(args[++i], options.debounceMs)) return 2;
+        }
+        else if (arg == "--poll" && hasValue) {
+            if (!ParseCount(args[++i], options.pollMs)) return 2;
+        }
+        else if (arg == "--durability" && hasValue) {
+            if (!ParseDurabilityOption(args[++i])) return 2;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (options.inputDirs.empty() || options.outputDir.empty() || options.targetFormats.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    FolderWatcher watcher(options);
+    watcher.SetCallback([](const std::string& path, bool success) {
+        std::cout << (success ? "Converted: " : "Failed: ") << path << std::endl;
+    });
+
+    if (!watcher.Run(stopRequested)) {
+        std::cerr << "Failed to watch input directories\n";
+        return 1;
+    }
+    return 0;
+}
+
+static int RunServe(const std::vector<std::string>& args) {
+    std::string socketPath;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--socket" && hasValue) socketPath = args[++i];
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (socketPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    ConversionService service(socketPath);
+    if (!service.Start()) {
+        std::cerr << "Failed to listen on " << socketPath << "\n";
+        return 1;
+    }
+
+    std::cout << "Listening on " << socketPath << std::endl;
+    service.Run(stopRequested);
+    std::cout << "Service latency: " << service.GetLatency().ToString() << std::endl;
+    return 0;
+}
+
+static int RunRequest(const std::vector<std::string>& args) {
+    std::string socketPath;
+    std::string inputPath;
+    std::string outputPath;
+    std::vector<FormatConverter::FormatType> targets;
+    unsigned repeat = 1;
+    bool stats = false;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+
+        if (arg == "--socket" && hasValue) socketPath = args[++i];
+        else if (arg == "--input" && hasValue) inputPath = args[++i];
+        else if (arg == "--output" && hasValue) outputPath = args[++i];
+        else if (arg == "--to" && hasValue) {
+            if (!ParseFormatList(args[++i], targets)) return 2;
+        }
+        else if (arg == "--repeat" && hasValue) {
+            if (!ParseCount(args[++i], repeat)) return 2;
+        }
+        else if (arg == "--stats") stats = true;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (socketPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    if (stats) {
+        std::string report;
+        if (!ServiceClient::QueryStats(socketPath, report)) {
+            std::cerr << "Failed to query " << socketPath << "\n";
+            return 1;
+        }
+        std::cout << report << "\n";
+        return 0;
+    }
+
+    if (inputPath.empty() || targets.size() != 1) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::string content = FileHandler::ReadFileContent(inputPath);
+    std::string output;
+    FormatConverter::FormatType detected = FormatConverter::FormatType::UNKNOWN;
+    LatencyRecorder latency;
+
+    for (unsigned i = 0; i < repeat; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (!ServiceClient::Convert(socketPath, content, targets[0], output, detected)) {
+            std::cerr << "Conversion failed (detected "
+                      << FormatConverter::FormatTypeToName(detected) << ")\n";
+            return 1;
+        }
+        latency.Record(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    if (!outputPath.empty()) {
+        if (!FileHandler::WriteFileContent(outputPath, output)) return 1;
+    } else if (repeat == 1) {
+        std::cout << output;
+    }
+
+    if (repeat > 1) {
+        std::cout << "Round-trip latency: " << latency.Summarize().ToString() << "\n";
+    }
+    return 0;
+}
+
+// ============== ENTRY POINT ==============
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::string command = argv[1];
+    std::vector<std::string> args(argv + 2, argv + argc);
+
+    if (command == "convert") return RunConvert(args);
+    if (command == "fanout") return RunFanOut(args);
+    if (command == "watch") return RunWatch(args);
+    if (command == "detect") return RunDetect(args);
+    if (command == "list") return RunList(args);
+    if (command == "serve") return RunServe(args);
+    if (command == "request") return RunRequest(args);
+    if (command == "pack") return RunPack(args);
+    if (command == "unpack") return RunUnpack(args);
+    if (command == "import") return RunWardrobeTransfer(args, true);
+    if (command == "export") return RunWardrobeTransfer(args, false);
+    if (command == "table") return RunTable(args);
+    if (command == "archive") return RunArchive(args);
+    if (command == "delta") return RunDelta(args);
+    if (command == "history") return RunHistory(args);
+    if (command == "diff") return RunDiff(args);
+    if (command == "patch") return RunPatch(args);
+    if (command == "dedup") return RunDedup(args);
+    if (command == "index") return RunIndex(args);
+    if (command == "query") return RunQuery(args);
+    if (command == "similar") return RunSimilar(args);
+    if (command == "select") return RunSelect(args);
+    if (command == "stats") return RunStats(args);
+    if (command == "validate") return RunValidate(args);
+    if (command == "lint") return RunLint(args);
+    if (command == "fidelity") return RunFidelity(args);
+
+    PrintUsage();
+    return command == "--help" || command == "help" ? 0 : 2;
+}
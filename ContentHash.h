@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== CONTENT HASHING ==============
+    // 64-bit FNV-1a. Stable across platforms and builds so hashes can be
+    // persisted on disk; not a cryptographic digest.
+    constexpr uint64_t HASH_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t HASH_PRIME = 1099511628211ULL;
+
+    inline uint64_t HashBytes(const void* data, size_t length, uint64_t seed = HASH_OFFSET_BASIS) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= bytes[i];
+            hash *= HASH_PRIME;
+        }
+        return hash;
+    }
+
+    inline uint64_t HashString(const std::string& value, uint64_t seed = HASH_OFFSET_BASIS) {
+        return HashBytes(value.data(), value.size(), seed);
+    }
+
+    // MurmurHash3 finalizer: spreads every input bit across the word. Use on
+    // FNV results (weak high bits) or on small structured keys.
+    inline uint64_t MixHash(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    inline std::string HashToHex(uint64_t hash) {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(16, '0');
+        for (int i = 15; i >= 0; i--) {
+            hex[i] = digits[hash & 0xF];
+            hash >>= 4;
+        }
+        return hex;
+    }
+
+    inline uint64_t HashFromHex(const std::string& hex) {
+        uint64_t hash = 0;
+        for (char c : hex) {
+            hash <<= 4;
+            if (c >= '0' && c <= '9') hash |= static_cast<uint64_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') hash |= static_cast<uint64_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') hash |= static_cast<uint64_t>(c - 'A' + 10);
+            else return 0;
+        }
+        return hash;
+    }
+
+} // namespace OutfitConverter
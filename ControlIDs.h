@@ -30,6 +30,7 @@ namespace OutfitConverter {
     constexpr int ID_BTN_SAVE_FILE = 2002;
     constexpr int ID_BTN_CONVERT = 2003;
     constexpr int ID_BTN_CLEAR = 2004;
+    constexpr int ID_BTN_EXPORT_ALL = 2005;
     constexpr int ID_COMBO_SOURCE_FORMAT = 2010;
     constexpr int ID_COMBO_TARGET_FORMAT = 2011;
     constexpr int ID_EDIT_SOURCE_PATH = 2020;
@@ -0,0 +1,417 @@
+#include "ConversionService.h"
+#include "FanOutConverter.h"
+#include "OutfitCodec.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace OutfitConverter {
+
+    // ============== SERVICE PROTOCOL ==============
+    std::string ServiceProtocol::EncodeFrame(const std::string& body) {
+        uint32_t length = static_cast<uint32_t>(body.size());
+        std::string frame(4, '\0');
+        for (int i = 0; i < 4; i++) {
+            frame[i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+        }
+        return frame + body;
+    }
+
+    bool ServiceProtocol::DecodeLength(const std::string& buffer, size_t offset, uint32_t& length) {
+        if (buffer.size() < offset + 4) return false;
+        length = 0;
+        for (int i = 0; i < 4; i++) {
+            length |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[offset + i])) << (8 * i);
+        }
+        return true;
+    }
+
+    // ============== LATENCY RECORDER ==============
+    LatencyRecorder::LatencyRecorder(size_t capacity) : next(0), total(0) {
+        samples.reserve(capacity);
+    }
+
+    void LatencyRecorder::Record(double micros) {
+        if (samples.size() < samples.capacity()) {
+            samples.push_back(micros);
+        } else {
+            samples[next] = micros;
+            next = (next + 1) % samples.size();
+        }
+        total++;
+    }
+
+    LatencySummary LatencyRecorder::Summarize() const {
+        LatencySummary summary;
+        summary.count = total;
+        if (samples.empty()) return summary;
+
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+
+        auto percentile = [&](double p) {
+            size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[index];
+        };
+        summary.p50Micros = percentile(0.50);
+        summary.p90Micros = percentile(0.90);
+        summary.p99Micros = percentile(0.99);
+        summary.maxMicros = sorted.back();
+        return summary;
+    }
+
+    std::string LatencySummary::ToString() const {
+        std::ostringstream oss;
+        oss << "requests=" << count
+            << " p50=" << p50Micros << "us"
+            << " p90=" << p90Micros << "us"
+            << " p99=" << p99Micros << "us"
+            << " max=" << maxMicros << "us";
+        return oss.str();
+    }
+
+    // ============== CONVERSION SERVICE ==============
+    ConversionService::ConversionService(const std::string& path)
+        : socketPath(path), listenFd(-1), requestCount(0) {}
+
+    std::string ConversionService::HandleRequest(const std::string& body) {
+        std::string response(2, '\0');
+        response[1] = static_cast<char>(FormatConverter::FormatType::UNKNOWN);
+
+        if (body.empty()) {
+            response[0] = static_cast<char>(ServiceProtocol::STATUS_BAD_REQUEST);
+            return response;
+        }
+
+        const uint8_t target = static_cast<uint8_t>(body[0]);
+        if (target == ServiceProtocol::REQUEST_STATS) {
+            response[0] = static_cast<char>(ServiceProtocol::STATUS_OK);
+            return response + latency.Summarize().ToString();
+        }
+        // Registered codecs sit past UNKNOWN; the registry knows which slots are filled
+        if (!CodecRegistry::Instance().Get(static_cast<FormatConverter::FormatType>(target))) {
+            response[0] = static_cast<char>(ServiceProtocol::STATUS_BAD_REQUEST);
+            return response;
+        }
+
+        const std::vector<FormatConverter::FormatType> targets = {
+            static_cast<FormatConverter::FormatType>(target)
+        };
+        FormatConverter::FormatType detected = FormatConverter::FormatType::UNKNOWN;
+        std::vector<std::string> outputs;
+        bool success;
+        try {
+            success = FanOutConverter::ConvertContent(body.substr(1), targets, detected, outputs);
+        } catch (const std::exception&) {
+            // One bad request must not take the service down
+            success = false;
+        }
+
+        response[1] = static_cast<char>(detected);
+        if (!success) {
+            response[0] = static_cast<char>(ServiceProtocol::STATUS_CONVERT_FAILED);
+            return response;
+        }
+        response[0] = static_cast<char>(ServiceProtocol::STATUS_OK);
+        return response + outputs[0];
+    }
+
+#ifndef _WIN32
+    ConversionService::~ConversionService() {
+        for (auto& connection : connections) {
+            CloseClient(connection);
+        }
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+    }
+
+    bool ConversionService::Start() {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) return false;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        // A stale socket file from a previous run would make bind() fail. Only
+        // a socket nobody accepts on is removed; a running service or any
+        // other file at the path fails Start instead.
+        struct stat info;
+        if (lstat(socketPath.c_str(), &info) == 0) {
+            if (!S_ISSOCK(info.st_mode)) return false;
+
+            int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (probe < 0) return false;
+            const bool stale = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 &&
+                               errno == ECONNREFUSED;
+            close(probe);
+            if (!stale) return false;
+            unlink(socketPath.c_str());
+        }
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) return false;
+
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listenFd, SOMAXCONN) != 0) {
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+
+        fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL, 0) | O_NONBLOCK);
+        return true;
+    }
+
+    void ConversionService::Run(const std::atomic<bool>& stop) {
+        std::vector<pollfd> pollSet;
+
+        while (!stop) {
+            pollSet.clear();
+            pollfd listener;
+            listener.fd = listenFd;
+            listener.events = POLLIN;
+            listener.revents = 0;
+            pollSet.push_back(listener);
+
+            for (const auto& connection : connections) {
+                pollfd entry;
+                entry.fd = connection.fd;
+                entry.events = 0;
+                if (!connection.readClosed && connection.PendingOutput() < MAX_PENDING_OUTPUT) entry.events |= POLLIN;
+                if (connection.PendingOutput() > 0) entry.events |= POLLOUT;
+                entry.revents = 0;
+                pollSet.push_back(entry);
+            }
+
+            if (poll(pollSet.data(), pollSet.size(), 100) <= 0) continue;
+
+            // Connections added by AcceptClients are polled on the next pass
+            const size_t polled = pollSet.size() - 1;
+            for (size_t i = 0; i < polled; i++) {
+                Connection& connection = connections[i];
+                const short events = pollSet[i + 1].revents;
+                if (events == 0) continue;
+
+                bool open = true;
+                if ((events & (POLLIN | POLLHUP | POLLERR)) && !connection.readClosed &&
+                    connection.PendingOutput() < MAX_PENDING_OUTPUT) {
+                    open = ReadClient(connection);
+                }
+                if (open) ProcessFrames(connection);
+                if (open && connection.PendingOutput() > 0) {
+                    // Draining may lift the output cap off requests still buffered
+                    open = WriteClient(connection);
+                    if (open) ProcessFrames(connection);
+                }
+                if (open && connection.closeAfterFlush && connection.PendingOutput() == 0) {
+                    open = false;
+                }
+                if (!open) CloseClient(connection);
+            }
+
+            connections.erase(std::remove_if(connections.begin(), connections.end(),
+                              [](const Connection& c) { return c.fd < 0; }),
+                              connections.end());
+
+            if (pollSet[0].revents & POLLIN) AcceptClients();
+        }
+    }
+
+    void ConversionService::AcceptClients() {
+        while (true) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;
+
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            Connection connection;
+            connection.fd = fd;
+            connections.push_back(connection);
+        }
+    }
+
+    bool ConversionService::ReadClient(Connection& connection) {
+        char buffer[64 * 1024];
+        // Bounded per pass so one fast sender cannot starve the other clients;
+        // poll() reports the rest as readable on the next pass
+        size_t total = 0;
+        while (total < MAX_READ_PER_PASS) {
+            ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                connection.input.append(buffer, static_cast<size_t>(received));
+                total += static_cast<size_t>(received);
+                continue;
+            }
+            if (received == 0) {
+                connection.readClosed = true;
+                return true;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        return true;
+    }
+
+    bool ConversionService::WriteClient(Connection& connection) {
+        while (connection.outputOffset < connection.output.size()) {
+            ssize_t sent = send(connection.fd, connection.output.data() + connection.outputOffset,
+                                connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+            if (sent < 0) {
+                return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            }
+            connection.outputOffset += static_cast<size_t>(sent);
+        }
+
+        connection.output.clear();
+        connection.outputOffset = 0;
+        return true;
+    }
+
+    void ConversionService::ProcessFrames(Connection& connection) {
+        size_t consumed = 0;
+        uint32_t length;
+        bool throttled = false;
+
+        while (!connection.closeAfterFlush) {
+            if (connection.PendingOutput() >= MAX_PENDING_OUTPUT) {
+                throttled = true;
+                break;
+            }
+            if (!ServiceProtocol::DecodeLength(connection.input, consumed, length)) break;
+
+            if (length > ServiceProtocol::MAX_MESSAGE_SIZE) {
+                std::string response(2, '\0');
+                response[0] = static_cast<char>(ServiceProtocol::STATUS_BAD_REQUEST);
+                response[1] = static_cast<char>(FormatConverter::FormatType::UNKNOWN);
+                connection.output += ServiceProtocol::EncodeFrame(response);
+                connection.closeAfterFlush = true;
+                break;
+            }
+            if (connection.input.size() - consumed < 4 + static_cast<size_t>(length)) break;
+
+            auto start = std::chrono::steady_clock::now();
+            std::string response = HandleRequest(connection.input.substr(consumed + 4, length));
+            connection.output += ServiceProtocol::EncodeFrame(response);
+            latency.Record(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count());
+            requestCount++;
+
+            consumed += 4 + length;
+        }
+
+        if (consumed > 0) connection.input.erase(0, consumed);
+
+        // Every complete request has been answered; a partial one never will be
+        if (connection.readClosed && !throttled) connection.closeAfterFlush = true;
+    }
+
+    void ConversionService::CloseClient(Connection& connection) {
+        if (connection.fd >= 0) {
+            close(connection.fd);
+            connection.fd = -1;
+        }
+    }
+
+    // ============== SERVICE CLIENT ==============
+    bool ServiceClient::Exchange(const std::string& socketPath, const std::string& request,
+                                 std::string& response) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) return false;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return false;
+        }
+
+        std::string frame = ServiceProtocol::EncodeFrame(request);
+        size_t offset = 0;
+        while (offset < frame.size()) {
+            ssize_t sent = send(fd, frame.data() + offset, frame.size() - offset, MSG_NOSIGNAL);
+            if (sent <= 0) {
+                close(fd);
+                return false;
+            }
+            offset += static_cast<size_t>(sent);
+        }
+
+        std::string buffer;
+        char chunk[64 * 1024];
+        uint32_t length = 0;
+        while (!ServiceProtocol::DecodeLength(buffer, 0, length) || buffer.size() < 4 + static_cast<size_t>(length)) {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                close(fd);
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+
+        close(fd);
+        response = buffer.substr(4, length);
+        return true;
+    }
+#else
+    ConversionService::~ConversionService() {}
+
+    bool ConversionService::Start() {
+        return false;
+    }
+
+    void ConversionService::Run(const std::atomic<bool>&) {}
+
+    void ConversionService::AcceptClients() {}
+    bool ConversionService::ReadClient(Connection&) { return false; }
+    bool ConversionService::WriteClient(Connection&) { return false; }
+    void ConversionService::ProcessFrames(Connection&) {}
+    void ConversionService::CloseClient(Connection&) {}
+
+    bool ServiceClient::Exchange(const std::string&, const std::string&, std::string&) {
+        return false;
+    }
+#endif
+
+    bool ServiceClient::Convert(const std::string& socketPath, const std::string& content,
+                                FormatConverter::FormatType target,
+                                std::string& output, FormatConverter::FormatType& detected) {
+        std::string request(1, static_cast<char>(target));
+        std::string response;
+        if (!Exchange(socketPath, request + content, response) || response.size() < 2) return false;
+
+        detected = static_cast<FormatConverter::FormatType>(static_cast<uint8_t>(response[1]));
+        if (static_cast<uint8_t>(response[0]) != ServiceProtocol::STATUS_OK) return false;
+
+        output = response.substr(2);
+        return true;
+    }
+
+    bool ServiceClient::QueryStats(const std::string& socketPath, std::string& report) {
+        std::string request(1, static_cast<char>(ServiceProtocol::REQUEST_STATS));
+        std::string response;
+        if (!Exchange(socketPath, request, response) || response.size() < 2) return false;
+
+        report = response.substr(2);
+        return true;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,120 @@
+#pragma once
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== SERVICE PROTOCOL ==============
+    // Every message is a 4-byte little-endian body length followed by the body.
+    //   Request body:  [target format][input bytes]
+    //   Response body: [status][detected source format][output bytes]
+    // A request whose target byte is REQUEST_STATS returns the latency report.
+    namespace ServiceProtocol {
+        const uint8_t REQUEST_STATS = 0xFF;
+
+        const uint8_t STATUS_OK = 0;
+        const uint8_t STATUS_CONVERT_FAILED = 1;
+        const uint8_t STATUS_BAD_REQUEST = 2;
+
+        const uint32_t MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+
+        std::string EncodeFrame(const std::string& body);
+        bool DecodeLength(const std::string& buffer, size_t offset, uint32_t& length);
+    }
+
+    // ============== LATENCY RECORDER ==============
+    struct LatencySummary {
+        size_t count;
+        double p50Micros;
+        double p90Micros;
+        double p99Micros;
+        double maxMicros;
+
+        LatencySummary() : count(0), p50Micros(0), p90Micros(0), p99Micros(0), maxMicros(0) {}
+        std::string ToString() const;
+    };
+
+    // Keeps the most recent samples in a fixed ring so long-running services
+    // report current percentiles with bounded memory.
+    class LatencyRecorder {
+    private:
+        std::vector<double> samples;
+        size_t next;
+        size_t total;
+
+    public:
+        explicit LatencyRecorder(size_t capacity = 100000);
+
+        void Record(double micros);
+        LatencySummary Summarize() const;
+    };
+
+    // ============== CONVERSION SERVICE ==============
+    // Persistent local converter on a Unix domain socket. One poll()-driven
+    // event loop multiplexes all clients; conversions run inline on the loop
+    // since a single outfit converts in microseconds.
+    class ConversionService {
+    private:
+        struct Connection {
+            int fd;
+            std::string input;
+            std::string output;
+            size_t outputOffset;
+            bool readClosed;        // Peer sent EOF; answer what is buffered, then close
+            bool closeAfterFlush;
+
+            Connection() : fd(-1), outputOffset(0), readClosed(false), closeAfterFlush(false) {}
+
+            size_t PendingOutput() const { return output.size() - outputOffset; }
+        };
+
+        // Past this much unsent output a client is neither read from nor has
+        // further requests answered until it drains its responses
+        static constexpr size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+        // Bytes read from one client per poll pass
+        static constexpr size_t MAX_READ_PER_PASS = 256 * 1024;
+
+        std::string socketPath;
+        int listenFd;
+        std::vector<Connection> connections;
+        LatencyRecorder latency;
+        size_t requestCount;
+
+        void AcceptClients();
+        bool ReadClient(Connection& connection);
+        bool WriteClient(Connection& connection);
+        void ProcessFrames(Connection& connection);
+        void CloseClient(Connection& connection);
+
+    public:
+        explicit ConversionService(const std::string& path);
+        ~ConversionService();
+
+        bool Start();
+        void Run(const std::atomic<bool>& stop);
+
+        // Handle one request body and produce the response body
+        std::string HandleRequest(const std::string& body);
+
+        LatencySummary GetLatency() const { return latency.Summarize(); }
+        size_t GetRequestCount() const { return requestCount; }
+    };
+
+    // ============== SERVICE CLIENT ==============
+    class ServiceClient {
+    public:
+        static bool Convert(const std::string& socketPath, const std::string& content,
+                            FormatConverter::FormatType target,
+                            std::string& output, FormatConverter::FormatType& detected);
+        static bool QueryStats(const std::string& socketPath, std::string& report);
+
+    private:
+        static bool Exchange(const std::string& socketPath, const std::string& request,
+                             std::string& response);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,152 @@
+#include "OutfitCorpus.h"
+#include "FormatConverter.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace OutfitConverter;
+
+// ============== CORPUS GENERATOR TOOL ==============
+// Writes reproducible synthetic outfit libraries for parser and batch benchmarks.
+
+static void PrintUsage() {
+    std::cout <<
+        "Usage: OutfitCorpusGen --output DIR [options]\n"
+        "\n"
+        "Options:\n"
+        "  --count N               Outfits to write (default 1000)\n"
+        "  --format FORMAT         cherax, yim, lexis or stand (default yim)\n"
+        "  --seed N                Same seed, same corpus (default 1)\n"
+        "  --layout pretty|compact JSON layout (default pretty)\n"
+        "  --components MIN..MAX   Dressed components per outfit, 0-12 (default 4..12)\n"
+        "  --prop-rate P           Chance of each prop slot being worn (default 0.3)\n"
+        "  --pathological P        Share of outfits with whitespace runs and/or\n"
+        "                          shuffled keys or lines (default 0)\n"
+        "  --whitespace BYTES      Longest whitespace run (default 4096)\n"
+        "  --per-directory N       Files per numbered subdirectory, 0 = flat (default 1000)\n"
+        "  --threads N             Worker threads (default: all cores)\n";
+}
+
+static bool ParseNumber(const std::string& value, uint64_t& number) {
+    try {
+        size_t used = 0;
+        number = std::stoull(value, &used);
+        if (used == value.size()) return true;
+    } catch (...) {
+    }
+    std::cerr << "Invalid number: " << value << "\n";
+    return false;
+}
+
+static bool ParseRate(const std::string& value, double& rate) {
+    try {
+        size_t used = 0;
+        rate = std::stod(value, &used);
+        if (used == value.size() && rate >= 0.0 && rate <= 1.0) return true;
+    } catch (...) {
+    }
+    std::cerr << "Invalid rate (0..1): " << value << "\n";
+    return false;
+}
+
+static bool ParseComponents(const std::string& value, int& low, int& high) {
+    const size_t dots = value.find("..");
+    uint64_t first, second;
+    if (!ParseNumber(value.substr(0, dots), first)) return false;
+    second = first;
+    if (dots != std::string::npos && !ParseNumber(value.substr(dots + 2), second)) return false;
+    if (first > second || second > 12) {
+        std::cerr << "Invalid component range (0..12): " << value << "\n";
+        return false;
+    }
+    low = static_cast<int>(first);
+    high = static_cast<int>(second);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::string outputDir;
+    CorpusOptions options;
+    uint64_t threads = 0;
+
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+        uint64_t number = 0;
+
+        if (arg == "--output" && hasValue) outputDir = args[++i];
+        else if (arg == "--count" && hasValue) {
+            if (!ParseNumber(args[++i], number)) return 2;
+            options.count = static_cast<size_t>(number);
+        }
+        else if (arg == "--format" && hasValue) {
+            options.format = FormatConverter::FormatTypeFromName(args[++i]);
+            if (options.format == FormatConverter::FormatType::UNKNOWN) {
+                std::cerr << "Unknown format: " << args[i] << "\n";
+                return 2;
+            }
+        }
+        else if (arg == "--seed" && hasValue) {
+            if (!ParseNumber(args[++i], options.seed)) return 2;
+        }
+        else if (arg == "--layout" && hasValue) {
+            const std::string layout = args[++i];
+            if (layout == "pretty") options.layout = CorpusLayout::PRETTY;
+            else if (layout == "compact") options.layout = CorpusLayout::COMPACT;
+            else {
+                std::cerr << "Unknown layout: " << layout << "\n";
+                return 2;
+            }
+        }
+        else if (arg == "--components" && hasValue) {
+            if (!ParseComponents(args[++i], options.minComponents, options.maxComponents)) return 2;
+        }
+        else if (arg == "--prop-rate" && hasValue) {
+            if (!ParseRate(args[++i], options.propRate)) return 2;
+        }
+        else if (arg == "--pathological" && hasValue) {
+            if (!ParseRate(args[++i], options.pathologicalRate)) return 2;
+        }
+        else if (arg == "--whitespace" && hasValue) {
+            if (!ParseNumber(args[++i], number)) return 2;
+            options.whitespaceBytes = static_cast<size_t>(number);
+        }
+        else if (arg == "--per-directory" && hasValue) {
+            if (!ParseNumber(args[++i], number)) return 2;
+            options.filesPerDirectory = static_cast<size_t>(number);
+        }
+        else if (arg == "--threads" && hasValue) {
+            if (!ParseNumber(args[++i], threads)) return 2;
+        }
+        else if (arg == "--help") {
+            PrintUsage();
+            return 0;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (outputDir.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const CorpusResult result = CorpusGenerator::Write(outputDir, options, static_cast<unsigned>(threads));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& item : result.failedItems) {
+        std::cerr << "Failed: " << item << "\n";
+    }
+    std::cout << "Generated: " << result.written << " " << FormatConverter::FormatTypeToName(options.format)
+              << " files, " << result.bytes << " bytes in " << elapsed << " ms";
+    if (elapsed > 0) std::cout << " (" << result.written * 1000 / static_cast<uint64_t>(elapsed) << " files/s)";
+    std::cout << "\n";
+    return result.failed > 0 ? 1 : 0;
+}
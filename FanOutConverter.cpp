@@ -0,0 +1,69 @@
+#include "FanOutConverter.h"
+#include "FileHandler.h"
+#include "OutfitCodec.h"
+
+namespace OutfitConverter {
+
+    // ============== FAN-OUT CONVERTER ==============
+    std::vector<FormatConverter::FormatType> FanOutConverter::AllFormats() {
+        return CodecRegistry::Instance().GetFormats();
+    }
+
+    void FanOutConverter::SerializeAll(const YimOutfit& outfit,
+                                       const std::vector<FormatConverter::FormatType>& targets,
+                                       std::vector<std::string>& outputs) {
+        outputs.resize(targets.size());
+
+        // One context per outfit so codecs share intermediates (Cherax for Stand)
+        const CodecRegistry& registry = CodecRegistry::Instance();
+        EncodeContext context(outfit);
+
+        for (size_t i = 0; i < targets.size(); i++) {
+            const OutfitCodec* codec = registry.Get(targets[i]);
+            if (codec) {
+                outputs[i] = codec->Encode(context);
+            } else {
+                outputs[i].clear();
+            }
+        }
+    }
+
+    bool FanOutConverter::ConvertContent(const std::string& content,
+                                         const std::vector<FormatConverter::FormatType>& targets,
+                                         FormatConverter::FormatType& detected,
+                                         std::vector<std::string>& outputs) {
+        detected = FormatConverter::DetectFormatFromContent(content);
+
+        YimOutfit outfit;
+        if (!FormatConverter::ParseAsYim(content, detected, outfit)) return false;
+
+        SerializeAll(outfit, targets, outputs);
+        for (const auto& output : outputs) {
+            if (output.empty()) return false;
+        }
+        return true;
+    }
+
+    bool FanOutConverter::ConvertFile(const std::string& inputPath,
+                                      const std::string& outputBase,
+                                      const std::vector<FormatConverter::FormatType>& targets) {
+        FormatConverter::FormatType detected;
+        std::vector<std::string> outputs;
+        if (!ConvertContent(FileHandler::ReadFileContent(inputPath), targets, detected, outputs)) {
+            return false;
+        }
+
+        bool success = true;
+        for (size_t i = 0; i < targets.size(); i++) {
+            success &= FileHandler::WriteFileContent(GetFanOutPath(outputBase, targets[i]), outputs[i]);
+        }
+        return success;
+    }
+
+    std::string FanOutConverter::GetFanOutPath(const std::string& outputBase,
+                                               FormatConverter::FormatType target) {
+        return outputBase + "_" + FormatConverter::FormatTypeToName(target) +
+               FormatConverter::GetFormatExtension(target);
+    }
+
+} // namespace OutfitConverter
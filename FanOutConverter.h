@@ -0,0 +1,37 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+
+namespace OutfitConverter {
+
+    // ============== FAN-OUT CONVERTER ==============
+    // Parses an outfit once and serializes it to several target formats. The
+    // intermediate Cherax form is built a single time and shared by the Cherax
+    // and Stand writers instead of being rebuilt per target.
+    class FanOutConverter {
+    public:
+        static std::vector<FormatConverter::FormatType> AllFormats();
+
+        // outputs[i] receives the serialization for targets[i]. Targets are
+        // encoded inline; callers parallelize across outfits instead.
+        static void SerializeAll(const YimOutfit& outfit,
+                                 const std::vector<FormatConverter::FormatType>& targets,
+                                 std::vector<std::string>& outputs);
+
+        // Detect, parse once and serialize every target from in-memory content
+        static bool ConvertContent(const std::string& content,
+                                   const std::vector<FormatConverter::FormatType>& targets,
+                                   FormatConverter::FormatType& detected,
+                                   std::vector<std::string>& outputs);
+
+        // Write one file per target next to outputBase: <outputBase>_<Format><ext>
+        static bool ConvertFile(const std::string& inputPath,
+                                const std::string& outputBase,
+                                const std::vector<FormatConverter::FormatType>& targets);
+        static std::string GetFanOutPath(const std::string& outputBase,
+                                         FormatConverter::FormatType target);
+    };
+
+} // namespace OutfitConverter
@@ -3,6 +3,23 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <set>
+#include <cstdio>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace OutfitConverter {
 
@@ -180,7 +197,11 @@ namespace OutfitConverter {
             numStr += GetChar();
         }
 
-        return numStr.empty() ? 0 : std::stoi(numStr);
+        // Malformed input must not throw: a lone '-' reads 0 and values past
+        // the int range saturate
+        if (numStr.empty()) return 0;
+        const long long value = std::strtoll(numStr.c_str(), nullptr, 10);
+        return value < INT_MIN ? INT_MIN : value > INT_MAX ? INT_MAX : static_cast<int>(value);
     }
 
     float JsonParser::ParseFloat() {
@@ -196,7 +217,8 @@ namespace OutfitConverter {
             numStr += GetChar();
         }
 
-        return numStr.empty() ? 0.0f : std::stof(numStr);
+        // strtof rather than stof: "-" or "." reads 0 and overflow gives inf
+        return numStr.empty() ? 0.0f : std::strtof(numStr.c_str(), nullptr);
     }
 
     bool JsonParser::FindKey(const std::string& key) {
@@ -249,11 +271,12 @@ namespace OutfitConverter {
         size_t oldPos = position;
         if (FindKey(key)) {
             SkipWhitespace();
-            std::string numStr;
+            // Accumulated modulo 2^32, so overlong values wrap instead of throwing
+            uint32_t value = 0;
             while (std::isdigit(PeekChar())) {
-                numStr += GetChar();
+                value = value * 10 + static_cast<uint32_t>(GetChar() - '0');
             }
-            return numStr.empty() ? 0 : std::stoul(numStr);
+            return value;
         }
         position = oldPos;
         return 0;
@@ -268,10 +291,12 @@ namespace OutfitConverter {
             if (GetChar() == '[') {
                 SkipWhitespace();
                 while (PeekChar() != ']' && PeekChar() != '\0') {
+                    const size_t before = position;
                     result.push_back(ParseInt());
                     SkipWhitespace();
                     if (PeekChar() == ',') GetChar();
                     SkipWhitespace();
+                    if (position == before) break;  // Not a number; stop rather than spin
                 }
                 if (PeekChar() == ']') GetChar();
             }
@@ -283,55 +308,64 @@ namespace OutfitConverter {
 
     // ============== CHERAX FILE OPERATIONS ==============
     bool FileHandler::LoadCheraxOutfit(const std::string& filepath, CheraxOutfit& outfit) {
-        std::string content = ReadFileContent(filepath);
+        return ParseCheraxOutfit(ReadFileContent(filepath), outfit);
+    }
+
+    bool FileHandler::ParseCheraxOutfit(const std::string& content, CheraxOutfit& outfit) {
         if (content.empty()) return false;
 
+        // Every key is searched from the start of its own object, so the
+        // result does not depend on key order (as in OutfitView)
         JsonParser parser(content);
         
         outfit.format = parser.GetString("format");
+        parser.Reset();
         outfit.type = parser.GetInt("type");
+        parser.Reset();
         outfit.model = parser.GetUInt32("model");
+        parser.Reset();
         outfit.baseFlags = parser.GetUInt32("baseFlags");
 
         // Parse components
-        size_t compPos = content.find("\"components\"");
-        if (compPos != std::string::npos) {
-            JsonParser compParser(content.substr(compPos));
-            
+        std::string compObject = GetJsonObject(content, "components");
+        if (!compObject.empty()) {
             const std::vector<std::string> componentNames = {
                 "Head", "Beard", "Hair", "Torso", "Legs", "Hands", "Feet",
                 "Teeth", "Special", "Special 2", "Decal", "Tuxedo/Jacket Bib"
             };
 
             for (const auto& name : componentNames) {
-                compParser.Reset();
-                if (compParser.FindKey(name)) {
-                    Component comp;
-                    comp.drawable = compParser.GetInt("drawable");
-                    comp.texture = compParser.GetInt("texture");
-                    comp.palette = compParser.GetInt("palette");
-                    outfit.components[name] = comp;
-                }
+                std::string slotObject = GetJsonObject(compObject, name);
+                if (slotObject.empty()) continue;
+
+                JsonParser slotParser(slotObject);
+                Component comp;
+                comp.drawable = slotParser.GetInt("drawable");
+                slotParser.Reset();
+                comp.texture = slotParser.GetInt("texture");
+                slotParser.Reset();
+                comp.palette = slotParser.GetInt("palette");
+                outfit.components[name] = comp;
             }
         }
 
         // Parse props
-        size_t propPos = content.find("\"props\"");
-        if (propPos != std::string::npos) {
-            JsonParser propParser(content.substr(propPos));
-            
+        std::string propObject = GetJsonObject(content, "props");
+        if (!propObject.empty()) {
             const std::vector<std::string> propNames = {
                 "Hat", "Glasses", "Earwear", "Watch", "Bracelet"
             };
 
             for (const auto& name : propNames) {
-                propParser.Reset();
-                if (propParser.FindKey(name)) {
-                    Prop prop;
-                    prop.drawable = propParser.GetInt("drawable");
-                    prop.texture = propParser.GetInt("texture");
-                    outfit.props[name] = prop;
-                }
+                std::string slotObject = GetJsonObject(propObject, name);
+                if (slotObject.empty()) continue;
+
+                JsonParser slotParser(slotObject);
+                Prop prop;
+                prop.drawable = slotParser.GetInt("drawable");
+                slotParser.Reset();
+                prop.texture = slotParser.GetInt("texture");
+                outfit.props[name] = prop;
             }
         }
 
@@ -339,6 +373,10 @@ namespace OutfitConverter {
     }
 
     bool FileHandler::SaveCheraxOutfit(const std::string& filepath, const CheraxOutfit& outfit) {
+        return WriteFileContent(filepath, SerializeCheraxOutfit(outfit));
+    }
+
+    std::string FileHandler::SerializeCheraxOutfit(const CheraxOutfit& outfit) {
         JsonBuilder builder;
         
         builder.StartObject();
@@ -370,7 +408,7 @@ namespace OutfitConverter {
 
         builder.EndObject();
 
-        return WriteFileContent(filepath, builder.GetJson());
+        return builder.GetJson();
     }
 
     // ============== UTILITY FUNCTIONS ==============
@@ -387,65 +425,230 @@ namespace OutfitConverter {
                           std::istreambuf_iterator<char>());
     }
 
+    std::string FileHandler::ReadFilePrefix(const std::string& filepath, size_t maxBytes) {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) return "";
+
+        std::string content(maxBytes, '\0');
+        file.read(&content[0], static_cast<std::streamsize>(maxBytes));
+        content.resize(static_cast<size_t>(file.gcount()));
+        return content;
+    }
+
     bool FileHandler::WriteFileContent(const std::string& filepath, const std::string& content) {
-        std::ofstream file(filepath, std::ios::binary);
-        if (!file.is_open()) return false;
+        std::string tempPath;
+        std::FILE* file = BeginAtomicWrite(filepath, tempPath);
+        if (!file) return false;
+
+        bool success = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+        return CommitAtomicWrite(file, tempPath, filepath, success);
+    }
+
+    std::FILE* FileHandler::BeginAtomicWrite(const std::string& filepath, std::string& tempPath) {
+        // Write a sibling temp file and rename it over the target, so an
+        // interrupted write never leaves a truncated or half-written outfit.
+        // The name is only a hint: exclusive creation ("x") retries under the
+        // next name when another thread or process already holds it.
+        static std::atomic<unsigned> tempCounter(0);
+        const std::string prefix = filepath + "." +
+            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000) + ".";
+
+        for (int attempt = 0; attempt < 100; attempt++) {
+            tempPath = prefix + std::to_string(tempCounter.fetch_add(1)) + ".tmp";
+            errno = 0;
+            std::FILE* file = std::fopen(tempPath.c_str(), "wbx");
+            if (file || errno != EEXIST) return file;
+        }
+        return nullptr;
+    }
 
-        file << content;
-        return file.good();
+    bool FileHandler::CommitAtomicWrite(std::FILE* file, const std::string& tempPath,
+                                        const std::string& filepath, bool success) {
+        const Durability policy = GetDurability();
+        std::error_code ec;
+
+        success = success && std::fflush(file) == 0;
+        if (success && policy == Durability::PER_FILE) {
+            success = SyncDescriptor(fileno(file));
+        }
+        success &= std::fclose(file) == 0;
+
+        if (success) {
+            std::filesystem::rename(tempPath, filepath, ec);
+            success = !ec;
+        }
+        if (!success) {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        if (policy == Durability::PER_FILE) {
+            // The rename itself is only durable once the directory entry is
+            SyncDirectory(ParentDirectory(filepath));
+        } else if (policy == Durability::GROUP) {
+            std::lock_guard<std::mutex> lock(DurabilityMutex());
+            PendingSyncFiles().push_back(filepath);
+        }
+        return true;
+    }
+
+    // ============== DURABILITY ==============
+    static std::atomic<int> durabilityPolicy(static_cast<int>(Durability::NONE));
+
+    void FileHandler::SetDurability(Durability policy) {
+        durabilityPolicy = static_cast<int>(policy);
+    }
+
+    Durability FileHandler::GetDurability() {
+        return static_cast<Durability>(durabilityPolicy.load());
+    }
+
+    bool FileHandler::ParseDurability(const std::string& name, Durability& policy) {
+        if (name == "none") policy = Durability::NONE;
+        else if (name == "file") policy = Durability::PER_FILE;
+        else if (name == "batch") policy = Durability::GROUP;
+        else return false;
+        return true;
+    }
+
+    std::mutex& FileHandler::DurabilityMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::vector<std::string>& FileHandler::PendingSyncFiles() {
+        static std::vector<std::string> files;
+        return files;
+    }
+
+    std::string FileHandler::ParentDirectory(const std::string& filepath) {
+        std::string parent = std::filesystem::path(filepath).parent_path().string();
+        return parent.empty() ? "." : parent;
+    }
+
+    bool FileHandler::FlushPendingWrites() {
+        std::vector<std::string> files;
+        {
+            std::lock_guard<std::mutex> lock(DurabilityMutex());
+            files.swap(PendingSyncFiles());
+        }
+        if (files.empty()) return true;
+
+        // Sync exactly the files of this batch, then each parent directory
+        // once so the renames are durable too
+        std::sort(files.begin(), files.end());
+        files.erase(std::unique(files.begin(), files.end()), files.end());
+        std::set<std::string> directories;
+        for (const auto& file : files) {
+            directories.insert(ParentDirectory(file));
+        }
+
+        bool success = true;
+        for (const auto& file : files) {
+            std::FILE* handle = std::fopen(file.c_str(), "rb");
+            if (!handle) {
+                success = false;
+                continue;
+            }
+            success &= SyncDescriptor(fileno(handle));
+            std::fclose(handle);
+        }
+        for (const auto& dir : directories) {
+            success &= SyncDirectory(dir);
+        }
+        return success;
+    }
+
+    bool FileHandler::SyncFile(std::FILE* file) {
+        return std::fflush(file) == 0 && SyncDescriptor(fileno(file));
+    }
+
+    bool FileHandler::SyncDescriptor(int fd) {
+#ifdef _WIN32
+        return _commit(fd) == 0;
+#else
+        return fsync(fd) == 0;
+#endif
+    }
+
+    bool FileHandler::SyncDirectory(const std::string& dir) {
+#ifdef _WIN32
+        // NTFS journals renames; directory handles cannot be flushed from the CRT
+        (void)dir;
+        return true;
+#else
+        int fd = open(dir.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        bool success = fsync(fd) == 0;
+        close(fd);
+        return success;
+#endif
     }
 // ============== YIM FILE OPERATIONS ==============
 bool FileHandler::LoadYimOutfit(const std::string& filepath, YimOutfit& outfit) {
-    std::string content = ReadFileContent(filepath);
+    return ParseYimOutfit(ReadFileContent(filepath), outfit);
+}
+
+bool FileHandler::ParseYimOutfit(const std::string& content, YimOutfit& outfit) {
     if (content.empty()) return false;
 
     JsonParser parser(content);
 
-    // Parse blend data
-    if (parser.FindKey("blend_data")) {
-        outfit.blend_data.is_parent = parser.GetInt("is_parent");
-        outfit.blend_data.shape_first_id = parser.GetInt("shape_first_id");
-        outfit.blend_data.shape_mix = parser.GetFloat("shape_mix");
-        outfit.blend_data.shape_second_id = parser.GetInt("shape_second_id");
-        outfit.blend_data.shape_third_id = parser.GetInt("shape_third_id");
-        outfit.blend_data.skin_first_id = parser.GetInt("skin_first_id");
-        outfit.blend_data.skin_mix = parser.GetFloat("skin_mix");
-        outfit.blend_data.skin_second_id = parser.GetInt("skin_second_id");
-        outfit.blend_data.skin_third_id = parser.GetInt("skin_third_id");
-        outfit.blend_data.third_mix = parser.GetFloat("third_mix");
-    }
-
-    // Parse components
-    size_t compPos = content.find("\"components\"");
-    if (compPos != std::string::npos) {
+    // Parse blend data. Each key is searched from the start of its own
+    // object, so the result does not depend on key order (as in OutfitView).
+    std::string blendObject = GetJsonObject(content, "blend_data");
+    if (!blendObject.empty()) {
+        JsonParser blendParser(blendObject);
+        auto getInt = [&](const std::string& key) { blendParser.Reset(); return blendParser.GetInt(key); };
+        auto getFloat = [&](const std::string& key) { blendParser.Reset(); return blendParser.GetFloat(key); };
+        outfit.blend_data.is_parent = getInt("is_parent");
+        outfit.blend_data.shape_first_id = getInt("shape_first_id");
+        outfit.blend_data.shape_mix = getFloat("shape_mix");
+        outfit.blend_data.shape_second_id = getInt("shape_second_id");
+        outfit.blend_data.shape_third_id = getInt("shape_third_id");
+        outfit.blend_data.skin_first_id = getInt("skin_first_id");
+        outfit.blend_data.skin_mix = getFloat("skin_mix");
+        outfit.blend_data.skin_second_id = getInt("skin_second_id");
+        outfit.blend_data.skin_third_id = getInt("skin_third_id");
+        outfit.blend_data.third_mix = getFloat("third_mix");
+    }
+
+    // Parse components. Slot keys are searched within the components object
+    // only: files may omit slots, and a missing "7" must not match props' "7".
+    // Likewise a slot's ids are read from that slot's own object.
+    std::string compObject = GetJsonObject(content, "components");
+    if (!compObject.empty()) {
         for (int i = 0; i < 12; i++) {
-            JsonParser compParser(content.substr(compPos));
-            if (compParser.FindKey(std::to_string(i))) {
-                Component comp;
-                comp.drawable = compParser.GetInt("drawable_id");
-                comp.texture = compParser.GetInt("texture_id");
-                comp.palette = 0;
-                outfit.components[i] = comp;
-            }
+            std::string slotObject = GetJsonObject(compObject, std::to_string(i));
+            if (slotObject.empty()) continue;
+
+            JsonParser slotParser(slotObject);
+            Component comp;
+            comp.drawable = slotParser.GetInt("drawable_id");
+            slotParser.Reset();
+            comp.texture = slotParser.GetInt("texture_id");
+            comp.palette = 0;
+            outfit.components[i] = comp;
         }
     }
 
     // Parse props
-    size_t propPos = content.find("\"props\"");
-    if (propPos != std::string::npos) {
+    std::string propObject = GetJsonObject(content, "props");
+    if (!propObject.empty()) {
         for (int i = 0; i < 9; i++) {
-            JsonParser propParser(content.substr(propPos));
-            if (propParser.FindKey(std::to_string(i))) {
-                Prop prop;
-                prop.drawable = propParser.GetInt("drawable_id");
-                prop.texture = propParser.GetInt("texture_id");
-                outfit.props[i] = prop;
-            }
+            std::string slotObject = GetJsonObject(propObject, std::to_string(i));
+            if (slotObject.empty()) continue;
+
+            JsonParser slotParser(slotObject);
+            Prop prop;
+            prop.drawable = slotParser.GetInt("drawable_id");
+            slotParser.Reset();
+            prop.texture = slotParser.GetInt("texture_id");
+            outfit.props[i] = prop;
         }
     }
 
     // Try to get model from file or use default
-    parser.Reset();
     outfit.model = parser.GetUInt32("model");
     if (outfit.model == 0) {
         outfit.model = 1885233650; // Default male model
@@ -455,6 +658,10 @@ bool FileHandler::LoadYimOutfit(const std::string& filepath, YimOutfit& outfit)
 }
 
 bool FileHandler::SaveYimOutfit(const std::string& filepath, const YimOutfit& outfit) {
+    return WriteFileContent(filepath, SerializeYimOutfit(outfit));
+}
+
+std::string FileHandler::SerializeYimOutfit(const YimOutfit& outfit) {
     JsonBuilder builder;
     
     builder.StartObject();
@@ -483,6 +690,9 @@ bool FileHandler::SaveYimOutfit(const std::string& filepath, const YimOutfit& ou
     }
     builder.EndObjectField();
 
+    // Read back by ParseYimOutfit; without it every outfit reloads as male
+    builder.AddField("model", outfit.model);
+
     // Props
     builder.StartObjectField("props");
     for (const auto& pair : outfit.props) {
@@ -495,20 +705,29 @@ bool FileHandler::SaveYimOutfit(const std::string& filepath, const YimOutfit& ou
 
     builder.EndObject();
 
-    return WriteFileContent(filepath, builder.GetJson());
+    return builder.GetJson();
 }
 
 // ============== LEXIS FILE OPERATIONS ==============
 bool FileHandler::LoadLexisOutfit(const std::string& filepath, LexisOutfit& outfit) {
-    std::string content = ReadFileContent(filepath);
+    return ParseLexisOutfit(ReadFileContent(filepath), outfit);
+}
+
+bool FileHandler::ParseLexisOutfit(const std::string& content, LexisOutfit& outfit) {
     if (content.empty()) return false;
 
     JsonParser parser(content);
 
+    // Keys are searched forward from the last match and Lexis writes "model"
+    // between the arrays, so rewind before each lookup
     outfit.model = parser.GetUInt32("model");
+    parser.Reset();
     outfit.component = parser.GetIntArray("component");
+    parser.Reset();
     outfit.component_variation = parser.GetIntArray("component variation");
+    parser.Reset();
     outfit.prop = parser.GetIntArray("prop");
+    parser.Reset();
     outfit.prop_variation = parser.GetIntArray("prop variation");
 
     // Ensure proper sizes
@@ -521,6 +740,10 @@ bool FileHandler::LoadLexisOutfit(const std::string& filepath, LexisOutfit& outf
 }
 
 bool FileHandler::SaveLexisOutfit(const std::string& filepath, const LexisOutfit& outfit) {
+    return WriteFileContent(filepath, SerializeLexisOutfit(outfit));
+}
+
+std::string FileHandler::SerializeLexisOutfit(const LexisOutfit& outfit) {
     JsonBuilder builder;
     
     builder.StartObject();
@@ -560,7 +783,7 @@ bool FileHandler::SaveLexisOutfit(const std::string& filepath, const LexisOutfit
     builder.EndObjectField();
     builder.EndObject();
 
-    return WriteFileContent(filepath, builder.GetJson());
+    return builder.GetJson();
 }
 
 // ============== STAND FILE OPERATIONS ==============
@@ -568,9 +791,21 @@ bool FileHandler::LoadStandOutfit(const std::string& filepath, StandOutfit& outf
     std::ifstream file(filepath);
     if (!file.is_open()) return false;
 
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    return ParseStandOutfit(content, outfit);
+}
+
+bool FileHandler::ParseStandOutfit(const std::string& content, StandOutfit& outfit) {
+    std::istringstream file(content);
+
     std::string line;
     while (std::getline(file, line)) {
+        // "Hair Colour\: Highlight" escapes the colon inside its key
         size_t colonPos = line.find(':');
+        while (colonPos != std::string::npos && colonPos > 0 && line[colonPos - 1] == '\\') {
+            colonPos = line.find(':', colonPos + 1);
+        }
         if (colonPos == std::string::npos) continue;
 
         std::string key = TrimWhitespace(line.substr(0, colonPos));
@@ -614,11 +849,14 @@ bool FileHandler::LoadStandOutfit(const std::string& filepath, StandOutfit& outf
         else if (key == "Bracelet Variation") outfit.bracelet_variation = ParseStandInt(value);
     }
 
-    file.close();
     return true;
 }
 
 bool FileHandler::SaveStandOutfit(const std::string& filepath, const StandOutfit& outfit) {
+    return WriteFileContent(filepath, SerializeStandOutfit(outfit));
+}
+
+std::string FileHandler::SerializeStandOutfit(const StandOutfit& outfit) {
     std::ostringstream oss;
     
     oss << "Model: " << outfit.model_name << "\n";
@@ -658,7 +896,7 @@ bool FileHandler::SaveStandOutfit(const std::string& filepath, const StandOutfit
     oss << "Bracelet: " << outfit.bracelet << "\n";
     oss << "Bracelet Variation: " << outfit.bracelet_variation << "\n";
 
-    return WriteFileContent(filepath, oss.str());
+    return oss.str();
 }
 
 // ============== HELPER FUNCTIONS ==============
@@ -670,6 +908,55 @@ std::string FileHandler::TrimWhitespace(const std::string& str) {
     return str.substr(start, end - start + 1);
 }
 
+// Text of the object value of the first "key", braces included ("" when
+// absent), so lookups inside it cannot run on into a following object
+std::string FileHandler::GetJsonObject(const std::string& json, const std::string& key) {
+    size_t keyPos = json.find("\"" + key + "\"");
+    if (keyPos == std::string::npos) return "";
+    size_t start = json.find('{', keyPos + key.length() + 2);
+    if (start == std::string::npos) return "";
+
+    int depth = 0;
+    bool inString = false;
+    for (size_t i = start; i < json.length(); i++) {
+        char ch = json[i];
+        if (inString) {
+            if (ch == '\\') i++;
+            else if (ch == '"') inString = false;
+        } else if (ch == '"') {
+            inString = true;
+        } else if (ch == '{') {
+            depth++;
+        } else if (ch == '}' && --depth == 0) {
+            return json.substr(start, i - start + 1);
+        }
+    }
+    return json.substr(start);
+}
+
+std::string FileHandler::EscapeJsonString(const std::string& input) {
+    std::string result;
+    result.reserve(input.size());
+    for (unsigned char ch : input) {
+        switch (ch) {
+        case '"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '\n': result += "\\n"; break;
+        case '\r': result += "\\r"; break;
+        case '\t': result += "\\t"; break;
+        default:
+            if (ch < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+                result += buffer;
+            } else {
+                result += static_cast<char>(ch);
+            }
+        }
+    }
+    return result;
+}
+
 int FileHandler::ParseStandInt(const std::string& value) {
     try {
         return std::stoi(value);
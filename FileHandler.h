@@ -2,34 +2,66 @@
 #include "OutfitStructures.h"
 #include <string>
 #include <fstream>
+#include <cstdio>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace OutfitConverter {
 
+    // ============== WRITE DURABILITY ==============
+    enum class Durability {
+        NONE,       // Atomic rename only; the OS flushes when it likes
+        PER_FILE,   // fsync each file and its directory before returning
+        GROUP       // Defer syncing until FlushPendingWrites() at batch end
+    };
+
     // ============== FILE HANDLER CLASS ==============
     class FileHandler {
     public:
         // ============== CHERAX FILE OPERATIONS ==============
         static bool LoadCheraxOutfit(const std::string& filepath, CheraxOutfit& outfit);
+        static bool ParseCheraxOutfit(const std::string& content, CheraxOutfit& outfit);
         static bool SaveCheraxOutfit(const std::string& filepath, const CheraxOutfit& outfit);
+        static std::string SerializeCheraxOutfit(const CheraxOutfit& outfit);
 
         // ============== YIM FILE OPERATIONS ==============
         static bool LoadYimOutfit(const std::string& filepath, YimOutfit& outfit);
+        static bool ParseYimOutfit(const std::string& content, YimOutfit& outfit);
         static bool SaveYimOutfit(const std::string& filepath, const YimOutfit& outfit);
+        static std::string SerializeYimOutfit(const YimOutfit& outfit);
 
         // ============== LEXIS FILE OPERATIONS ==============
         static bool LoadLexisOutfit(const std::string& filepath, LexisOutfit& outfit);
+        static bool ParseLexisOutfit(const std::string& content, LexisOutfit& outfit);
         static bool SaveLexisOutfit(const std::string& filepath, const LexisOutfit& outfit);
+        static std::string SerializeLexisOutfit(const LexisOutfit& outfit);
 
         // ============== STAND FILE OPERATIONS ==============
         static bool LoadStandOutfit(const std::string& filepath, StandOutfit& outfit);
+        static bool ParseStandOutfit(const std::string& content, StandOutfit& outfit);
         static bool SaveStandOutfit(const std::string& filepath, const StandOutfit& outfit);
+        static std::string SerializeStandOutfit(const StandOutfit& outfit);
 
         // ============== UTILITY FUNCTIONS ==============
         static bool FileExists(const std::string& filepath);
         static std::string GetFileExtension(const std::string& filepath);
         static std::string ReadFileContent(const std::string& filepath);
+        static std::string ReadFilePrefix(const std::string& filepath, size_t maxBytes);
         static bool WriteFileContent(const std::string& filepath, const std::string& content);
+
+        // Streaming form of WriteFileContent: write to the returned temp file,
+        // then commit renames it into place (or discards it when !success)
+        static std::FILE* BeginAtomicWrite(const std::string& filepath, std::string& tempPath);
+        static bool CommitAtomicWrite(std::FILE* file, const std::string& tempPath,
+                                      const std::string& filepath, bool success);
+
+        // Durability of WriteFileContent (temp file + rename in every mode)
+        static void SetDurability(Durability policy);
+        static Durability GetDurability();
+        static bool ParseDurability(const std::string& name, Durability& policy);
+        static bool FlushPendingWrites();   // GROUP: sync everything written since the last flush
+        static bool SyncFile(std::FILE* file);  // Flush stdio buffers and the OS cache to disk
         
         // JSON helper functions
         static std::string EscapeJsonString(const std::string& input);
@@ -53,6 +85,13 @@ namespace OutfitConverter {
         static std::string BuildJsonArray(const std::vector<int>& values);
         static std::string BuildJsonObject(const std::map<std::string, std::string>& pairs);
 
+        // Durability helpers
+        static std::mutex& DurabilityMutex();
+        static std::vector<std::string>& PendingSyncFiles();
+        static std::string ParentDirectory(const std::string& filepath);
+        static bool SyncDescriptor(int fd);
+        static bool SyncDirectory(const std::string& dir);
+
         // Stand format parsing
         static std::string GetStandValue(const std::string& line);
         static int ParseStandInt(const std::string& value);
@@ -0,0 +1,274 @@
+#include "FolderWatcher.h"
+#include "FanOutConverter.h"
+#include "FileHandler.h"
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+#include <cctype>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    // ============== FOLDER WATCHER ==============
+    FolderWatcher::FolderWatcher(const WatchOptions& watchOptions)
+        : options(watchOptions), notifyFd(-1) {
+        layout.outputDir = options.outputDir;
+        layout.targetFormats = options.targetFormats;
+    }
+
+    FolderWatcher::~FolderWatcher() {
+#ifdef __linux__
+        if (notifyFd >= 0) {
+            close(notifyFd);
+        }
+#endif
+    }
+
+    bool FolderWatcher::Run(const std::atomic<bool>& stop) {
+        for (const auto& dir : options.inputDirs) {
+            std::error_code ec;
+            if (!fs::is_directory(dir, ec)) return false;
+        }
+
+        const bool native = StartNotify();
+        if (!native) {
+            PollChanges(true);
+        }
+
+        // Short waits keep shutdown and debounce latency low without busy-looping
+        const int waitMs = static_cast<int>(std::min<unsigned>(options.debounceMs / 2 + 1, 100));
+        Clock::time_point lastPoll = Clock::now();
+
+        while (!stop) {
+            if (native) {
+                ReadNotifyEvents(waitMs);
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+                if (Clock::now() - lastPoll >= std::chrono::milliseconds(options.pollMs)) {
+                    PollChanges(false);
+                    lastPoll = Clock::now();
+                }
+            }
+            ConvertReady(false);
+        }
+
+        ConvertReady(true);
+        return true;
+    }
+
+    bool FolderWatcher::IsOutfitFile(const std::string& path) const {
+        std::string ext = fs::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext == ".json" || ext == ".txt";
+    }
+
+    bool FolderWatcher::IsInOutputDir(const std::string& path) const {
+        std::error_code ec;
+        std::string output = fs::absolute(options.outputDir, ec).lexically_normal().generic_string();
+        std::string candidate = fs::absolute(path, ec).lexically_normal().generic_string();
+        if (!output.empty() && output.back() != '/') output += '/';
+        return candidate.compare(0, output.size(), output) == 0;
+    }
+
+    void FolderWatcher::MarkPending(const std::string& path, const std::string& root) {
+        if (!IsOutfitFile(path) || IsInOutputDir(path)) return;
+
+        PendingFile& file = pending[path];
+        file.root = root;
+        file.lastEvent = Clock::now();
+    }
+
+    void FolderWatcher::ConvertReady(bool flushAll) {
+        const Clock::time_point now = Clock::now();
+        const auto quiet = std::chrono::milliseconds(options.debounceMs);
+
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (flushAll || now - it->second.lastEvent >= quiet) {
+                ConvertFile(it->first, it->second.root);
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // One group sync per debounce round under the GROUP durability policy
+        FileHandler::FlushPendingWrites();
+    }
+
+    bool FolderWatcher::ConvertFile(const std::string& path, const std::string& root) {
+        // Removed or renamed away before the debounce expired
+        std::error_code ec;
+        if (!fs::is_regular_file(path, ec)) return false;
+
+        const std::string relativePath = fs::path(path).lexically_relative(root).generic_string();
+        if (HasOutputCollision(relativePath, root)) {
+            if (onConverted) onConverted(path, false);
+            return false;
+        }
+
+        FormatConverter::FormatType detected;
+        std::vector<std::string> outputs;
+        bool success;
+        try {
+            success = FanOutConverter::ConvertContent(
+                FileHandler::ReadFileContent(path), options.targetFormats, detected, outputs);
+        } catch (const std::exception&) {
+            // A malformed file fails on its own; the watcher keeps running
+            success = false;
+        }
+
+        for (size_t i = 0; success && i < options.targetFormats.size(); i++) {
+            std::string outputPath = BatchConverter::GetOutputPath(layout, relativePath, options.targetFormats[i]);
+            fs::create_directories(fs::path(outputPath).parent_path(), ec);
+            success = FileHandler::WriteFileContent(outputPath, outputs[i]);
+        }
+
+        if (onConverted) onConverted(path, success);
+        return success;
+    }
+
+    bool FolderWatcher::HasOutputCollision(const std::string& relativePath, const std::string& root) const {
+        // Outfit files in the same relative directory of every input root share
+        // the output directory; any of them with the same stem owns the output too
+        const fs::path relativeDir = fs::path(relativePath).parent_path();
+        const fs::path fileName = fs::path(relativePath).filename();
+        std::vector<std::string> candidates = { relativePath };
+        for (const auto& dir : options.inputDirs) {
+            std::error_code ec;
+            for (fs::directory_iterator it(fs::path(dir) / relativeDir, ec), end; !ec && it != end; it.increment(ec)) {
+                if (dir == root && it->path().filename() == fileName) continue;
+                if (!it->is_regular_file(ec) || !IsOutfitFile(it->path().string())) continue;
+                candidates.push_back((relativeDir / it->path().filename()).generic_string());
+            }
+        }
+        return BatchConverter::FindOutputCollisions(candidates)[0] != 0;
+    }
+
+    // ============== NATIVE NOTIFICATIONS ==============
+#ifdef __linux__
+    static const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY | IN_CREATE;
+
+    bool FolderWatcher::StartNotify() {
+        notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (notifyFd < 0) return false;
+
+        for (const auto& dir : options.inputDirs) {
+            AddWatchRecursive(dir, dir);
+        }
+        return true;
+    }
+
+    void FolderWatcher::AddWatchRecursive(const std::string& dir, const std::string& root) {
+        if (IsInOutputDir(dir + "/")) return;
+
+        int wd = inotify_add_watch(notifyFd, dir.c_str(), WATCH_MASK);
+        if (wd < 0) return;
+        watchDirs[wd] = std::make_pair(dir, root);
+
+        std::error_code ec;
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_directory(ec)) {
+                AddWatchRecursive(it->path().string(), root);
+            }
+        }
+    }
+
+    void FolderWatcher::ReadNotifyEvents(int timeoutMs) {
+        pollfd pfd;
+        pfd.fd = notifyFd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, timeoutMs) <= 0) return;
+
+        alignas(inotify_event) char buffer[64 * 1024];
+        ssize_t length;
+        while ((length = read(notifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                // Dropped events: treat everything as touched, conversion is idempotent
+                if (event->mask & IN_Q_OVERFLOW) {
+                    for (const auto& root : options.inputDirs) {
+                        for (const auto& file : BatchConverter::CollectInputFiles(root, options.outputDir)) {
+                            MarkPending((fs::path(root) / file).string(), root);
+                        }
+                    }
+                    continue;
+                }
+
+                auto watch = watchDirs.find(event->wd);
+                if (watch == watchDirs.end()) continue;
+                if (event->mask & IN_IGNORED) {
+                    watchDirs.erase(watch);
+                    continue;
+                }
+                if (event->len == 0) continue;
+
+                const std::string dir = watch->second.first;
+                const std::string root = watch->second.second;
+                const std::string path = dir + "/" + event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    // A directory moved or created in place may already hold files
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        AddWatchRecursive(path, root);
+                        for (const auto& file : BatchConverter::CollectInputFiles(path, options.outputDir)) {
+                            MarkPending((fs::path(path) / file).string(), root);
+                        }
+                    }
+                    continue;
+                }
+
+                MarkPending(path, root);
+            }
+        }
+    }
+#else
+    bool FolderWatcher::StartNotify() {
+        return false;
+    }
+
+    void FolderWatcher::AddWatchRecursive(const std::string&, const std::string&) {}
+
+    void FolderWatcher::ReadNotifyEvents(int) {}
+#endif
+
+    // ============== POLLING FALLBACK ==============
+    void FolderWatcher::PollChanges(bool initial) {
+        std::map<std::string, FileStamp> current;
+
+        for (const auto& root : options.inputDirs) {
+            for (const auto& file : BatchConverter::CollectInputFiles(root, options.outputDir)) {
+                const std::string path = (fs::path(root) / file).string();
+                std::error_code ec;
+
+                FileStamp stamp;
+                stamp.size = fs::file_size(path, ec);
+                stamp.mtime = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+                current[path] = stamp;
+
+                // Existing files are the baseline; only later changes are converted
+                if (initial) continue;
+
+                auto previous = snapshot.find(path);
+                if (previous == snapshot.end() || previous->second.size != stamp.size ||
+                    previous->second.mtime != stamp.mtime) {
+                    MarkPending(path, root);
+                }
+            }
+        }
+
+        snapshot.swap(current);
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,81 @@
+#pragma once
+#include "FormatConverter.h"
+#include "BatchConverter.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace OutfitConverter {
+
+    // ============== WATCH OPTIONS ==============
+    struct WatchOptions {
+        std::vector<std::string> inputDirs;
+        std::string outputDir;
+        std::vector<FormatConverter::FormatType> targetFormats;
+        unsigned debounceMs;    // Quiet period after the last event before converting
+        unsigned pollMs;        // Rescan interval when native notifications are unavailable
+
+        WatchOptions() : debounceMs(500), pollMs(1000) {}
+    };
+
+    // ============== FOLDER WATCHER ==============
+    // Long-running converter for drop folders. Uses inotify on Linux and
+    // falls back to periodic stat scans elsewhere. Files are converted once
+    // they have been quiet for debounceMs, so partial writes are not picked up,
+    // and outputs are written atomically into the batch output layout.
+    class FolderWatcher {
+    public:
+        typedef std::function<void(const std::string& inputPath, bool success)> ConvertCallback;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct PendingFile {
+            std::string root;           // Input directory the file belongs to
+            Clock::time_point lastEvent;
+        };
+
+        struct FileStamp {
+            uint64_t size;
+            int64_t mtime;
+        };
+
+        WatchOptions options;
+        BatchOptions layout;            // Output path layout shared with BatchConverter
+        ConvertCallback onConverted;
+        std::map<std::string, PendingFile> pending;
+
+        // inotify state (Linux)
+        int notifyFd;
+        std::map<int, std::pair<std::string, std::string>> watchDirs; // wd -> (dir, root)
+
+        // Polling fallback state
+        std::map<std::string, FileStamp> snapshot;
+
+        bool IsOutfitFile(const std::string& path) const;
+        bool IsInOutputDir(const std::string& path) const;
+        void MarkPending(const std::string& path, const std::string& root);
+        void ConvertReady(bool flushAll);
+        bool ConvertFile(const std::string& path, const std::string& root);
+        // Another input would be written to the same output (as BatchConverter::FindOutputCollisions)
+        bool HasOutputCollision(const std::string& relativePath, const std::string& root) const;
+
+        bool StartNotify();
+        void AddWatchRecursive(const std::string& dir, const std::string& root);
+        void ReadNotifyEvents(int timeoutMs);
+        void PollChanges(bool initial);
+
+    public:
+        explicit FolderWatcher(const WatchOptions& watchOptions);
+        ~FolderWatcher();
+
+        void SetCallback(ConvertCallback callback) { onConverted = callback; }
+
+        // Blocks until stop becomes true; pending files are flushed on exit
+        bool Run(const std::atomic<bool>& stop);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,161 @@
+#include "FormatClassifier.h"
+#include "FileHandler.h"
+#include <queue>
+#include <cctype>
+
+namespace OutfitConverter {
+
+    // ============== SIGNATURE TABLE ==============
+    // Weights are chosen so that one strong marker (or Stand's two line keys)
+    // reaches ACCEPT_SCORE, matching what the old sequential checks accepted.
+    FormatClassifier::FormatClassifier() : classCount(0) {
+        for (int& weight : formatWeight) weight = 0;
+
+        AddSignature("\"format\": \"Cherax Entity\"", FormatConverter::FormatType::CHERAX, 3);
+        AddSignature("\"baseFlags\":", FormatConverter::FormatType::CHERAX, 1);
+
+        AddSignature("\"blend_data\":", FormatConverter::FormatType::YIM, 3);
+        AddSignature("\"skin_first_id\":", FormatConverter::FormatType::YIM, 1);
+        AddSignature("\"drawable_id\":", FormatConverter::FormatType::YIM, 1);
+
+        AddSignature("\"component variation\":", FormatConverter::FormatType::LEXIS, 3);
+        AddSignature("\"prop variation\":", FormatConverter::FormatType::LEXIS, 1);
+
+        AddSignature("Model:", FormatConverter::FormatType::STAND, 1);
+        AddSignature("Hair Colour:", FormatConverter::FormatType::STAND, 2);
+        AddSignature("Gloves / Torso:", FormatConverter::FormatType::STAND, 1);
+
+        Build();
+    }
+
+    void FormatClassifier::AddSignature(const std::string& pattern,
+                                        FormatConverter::FormatType format, int weight) {
+        Signature signature;
+        for (char c : pattern) {
+            if (!std::isspace(static_cast<unsigned char>(c))) signature.pattern += c;
+        }
+        signature.format = format;
+        signature.weight = weight;
+        signatures.push_back(signature);
+        formatWeight[static_cast<int>(format)] += weight;
+    }
+
+    void FormatClassifier::Build() {
+        // Bytes that appear in no pattern share class 0; whitespace is skipped
+        for (int c = 0; c < 256; c++) {
+            charClass[c] = std::isspace(c) ? SKIP_CLASS : 0;
+        }
+        classCount = 1;
+        for (const auto& signature : signatures) {
+            for (char c : signature.pattern) {
+                unsigned char byte = static_cast<unsigned char>(c);
+                if (charClass[byte] == 0) charClass[byte] = static_cast<uint8_t>(classCount++);
+            }
+        }
+
+        // Trie over character classes (-1 = no edge yet)
+        transitions.assign(classCount, -1);
+        matches.assign(1, 0);
+        for (size_t i = 0; i < signatures.size(); i++) {
+            int32_t state = 0;
+            for (char c : signatures[i].pattern) {
+                size_t cls = charClass[static_cast<unsigned char>(c)];
+                if (transitions[state * classCount + cls] < 0) {
+                    transitions[state * classCount + cls] = static_cast<int32_t>(matches.size());
+                    transitions.resize(transitions.size() + classCount, -1);
+                    matches.push_back(0);
+                }
+                state = transitions[state * classCount + cls];
+            }
+            matches[state] |= 1ULL << i;
+        }
+
+        // Breadth-first failure links, folded into a complete DFA
+        std::vector<int32_t> fail(matches.size(), 0);
+        std::queue<int32_t> pending;
+        for (size_t cls = 0; cls < classCount; cls++) {
+            int32_t& next = transitions[cls];
+            if (next < 0) {
+                next = 0;
+            } else {
+                fail[next] = 0;
+                pending.push(next);
+            }
+        }
+
+        while (!pending.empty()) {
+            int32_t state = pending.front();
+            pending.pop();
+            matches[state] |= matches[fail[state]];
+
+            for (size_t cls = 0; cls < classCount; cls++) {
+                int32_t& next = transitions[state * classCount + cls];
+                int32_t fallback = transitions[fail[state] * classCount + cls];
+                if (next < 0) {
+                    next = fallback;
+                } else {
+                    fail[next] = fallback;
+                    pending.push(next);
+                }
+            }
+        }
+    }
+
+    const FormatClassifier& FormatClassifier::Instance() {
+        static const FormatClassifier classifier;
+        return classifier;
+    }
+
+    // ============== CLASSIFICATION ==============
+    Classification FormatClassifier::Classify(const char* data, size_t length) const {
+        const uint64_t all = (signatures.size() >= 64) ? ~0ULL : ((1ULL << signatures.size()) - 1);
+        uint64_t found = 0;
+        int32_t state = 0;
+
+        for (size_t i = 0; i < length; i++) {
+            uint8_t cls = charClass[static_cast<unsigned char>(data[i])];
+            if (cls == SKIP_CLASS) continue;
+            state = transitions[state * classCount + cls];
+            found |= matches[state];
+            if (found == all) break;
+        }
+
+        Classification result;
+        for (size_t i = 0; i < signatures.size(); i++) {
+            if (found & (1ULL << i)) {
+                result.scores[static_cast<int>(signatures[i].format)] += signatures[i].weight;
+            }
+        }
+
+        // Ties keep the historical precedence Cherax > Yim > Lexis > Stand
+        int best = 0;
+        int second = 0;
+        for (int f = 1; f < 4; f++) {
+            if (result.scores[f] > result.scores[best]) best = f;
+        }
+        for (int f = 0; f < 4; f++) {
+            if (f != best && result.scores[f] > second) second = result.scores[f];
+        }
+
+        const int bestScore = result.scores[best];
+        if (bestScore < ACCEPT_SCORE) return result;
+
+        result.format = static_cast<FormatConverter::FormatType>(best);
+        float coverage = static_cast<float>(bestScore) / static_cast<float>(formatWeight[best]);
+        float margin = static_cast<float>(bestScore - second) / static_cast<float>(bestScore);
+        result.confidence = coverage * margin;
+        return result;
+    }
+
+    Classification FormatClassifier::ClassifyFile(const std::string& filepath) const {
+        // See FormatConverter::DetectFormat for the prefix/fallback rationale
+        std::string prefix = FileHandler::ReadFilePrefix(filepath, FormatConverter::DETECT_PREFIX_BYTES);
+        Classification result = Classify(prefix);
+        if (result.format != FormatConverter::FormatType::UNKNOWN ||
+            prefix.size() < FormatConverter::DETECT_PREFIX_BYTES) {
+            return result;
+        }
+        return Classify(FileHandler::ReadFileContent(filepath));
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,62 @@
+#pragma once
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== CLASSIFICATION RESULT ==============
+    struct Classification {
+        FormatConverter::FormatType format;
+        float confidence;   // 0..1: signature coverage of the winner times its margin over the runner-up
+        int scores[4];      // Per-format signature weight matched, indexed by FormatType
+
+        Classification() : format(FormatConverter::FormatType::UNKNOWN), confidence(0.0f) {
+            for (int& score : scores) score = 0;
+        }
+    };
+
+    // ============== FORMAT CLASSIFIER ==============
+    // Aho-Corasick automaton over every format signature at once, so the input
+    // is scanned a single time no matter how many formats are supported.
+    // Whitespace is skipped on both the pattern and the input side, which makes
+    // "format":"Cherax Entity" and "format" : "Cherax Entity" match alike.
+    class FormatClassifier {
+    private:
+        struct Signature {
+            std::string pattern;
+            FormatConverter::FormatType format;
+            int weight;
+        };
+
+        static const uint8_t SKIP_CLASS = 0xFF;
+
+        std::vector<Signature> signatures;
+        uint8_t charClass[256];
+        size_t classCount;
+        std::vector<int32_t> transitions;   // state * classCount + class -> state
+        std::vector<uint64_t> matches;      // Signatures recognized on entering a state
+        int formatWeight[4];
+
+        FormatClassifier();
+        void AddSignature(const std::string& pattern, FormatConverter::FormatType format, int weight);
+        void Build();
+
+    public:
+        // Minimum matched weight before a format is reported at all
+        static const int ACCEPT_SCORE = 3;
+
+        static const FormatClassifier& Instance();
+
+        Classification Classify(const char* data, size_t length) const;
+        Classification Classify(const std::string& content) const {
+            return Classify(content.data(), content.size());
+        }
+
+        // Prefix sniff with full-file fallback, as in FormatConverter::DetectFormat
+        Classification ClassifyFile(const std::string& filepath) const;
+    };
+
+} // namespace OutfitConverter
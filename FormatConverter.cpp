@@ -1,6 +1,8 @@
 #include "FormatConverter.h"
 #include <algorithm>
 #include "FormatConverter.h"
+#include "FileHandler.h"
+#include "OutfitCodec.h"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
@@ -332,28 +334,62 @@ namespace OutfitConverter {
 
     // ============== FORMAT DETECTION ==============
     FormatConverter::FormatType FormatConverter::DetectFormat(const std::string& filepath) {
-        std::ifstream file(filepath);
-        if (!file.is_open()) return FormatType::UNKNOWN;
+        // Every marker sits near the top of files written by the supported
+        // tools, so a bounded prefix decides almost every file. Only when the
+        // prefix is inconclusive (no marker, or a marker straddles the cut)
+        // do we pay for reading and scanning the whole file.
+        std::string prefix = FileHandler::ReadFilePrefix(filepath, DETECT_PREFIX_BYTES);
+        FormatType format = DetectFormatFromContent(prefix);
+        if (format != FormatType::UNKNOWN || prefix.size() < DETECT_PREFIX_BYTES) {
+            return format;
+        }
+        return DetectFormatFromContent(FileHandler::ReadFileContent(filepath));
+    }
 
-        std::string content((std::istreambuf_iterator<char>(file)),
-                           std::istreambuf_iterator<char>());
-        file.close();
+    FormatConverter::FormatType FormatConverter::DetectFormatFromContent(const std::string& content) {
+        return CodecRegistry::Instance().Detect(content);
+    }
 
-        if (content.find("\"format\": \"Cherax Entity\"") != std::string::npos) {
-            return FormatType::CHERAX;
-        }
-        if (content.find("\"blend_data\"") != std::string::npos) {
-            return FormatType::YIM;
-        }
-        if (content.find("\"component variation\"") != std::string::npos) {
-            return FormatType::LEXIS;
-        }
-        if (content.find("Model:") != std::string::npos && 
-            content.find("Hair Colour") != std::string::npos) {
-            return FormatType::STAND;
-        }
+    // ============== FORMAT NAMES ==============
+    std::string FormatConverter::FormatTypeToName(FormatType format) {
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(format);
+        return codec ? codec->GetName() : "Unknown";
+    }
+
+    FormatConverter::FormatType FormatConverter::FormatTypeFromName(const std::string& name) {
+        return CodecRegistry::Instance().FindByName(name);
+    }
+
+    std::string FormatConverter::GetFormatExtension(FormatType format) {
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(format);
+        return codec ? codec->GetExtension() : "";
+    }
+
+    // ============== CANONICAL LOAD/SAVE ==============
+    bool FormatConverter::LoadAsYim(const std::string& filepath, FormatType format, YimOutfit& outfit) {
+        return ParseAsYim(FileHandler::ReadFileContent(filepath), format, outfit);
+    }
+
+    bool FormatConverter::ParseAsYim(const std::string& content, FormatType format, YimOutfit& outfit) {
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(format);
+        return codec && codec->Decode(content, outfit);
+    }
+
+    std::string FormatConverter::SerializeFromYim(const YimOutfit& outfit, FormatType format) {
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(format);
+        return codec ? codec->Encode(outfit) : "";
+    }
+
+    bool FormatConverter::ConvertFile(const std::string& inputPath,
+                                      const std::string& outputPath,
+                                      FormatType targetFormat) {
+        YimOutfit outfit;
+        if (!LoadAsYim(inputPath, DetectFormat(inputPath), outfit)) return false;
+
+        std::string content = SerializeFromYim(outfit, targetFormat);
+        if (content.empty()) return false;
 
-        return FormatType::UNKNOWN;
+        return FileHandler::WriteFileContent(outputPath, content);
     }
 
     // ============== VALIDATION ==============
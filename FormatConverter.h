@@ -48,7 +48,21 @@ namespace OutfitConverter {
             UNKNOWN
         };
 
+        // Single-pass signature scan (FormatClassifier); file detection reads
+        // at most DETECT_PREFIX_BYTES unless the prefix is inconclusive
+        static constexpr size_t DETECT_PREFIX_BYTES = 4096;
         static FormatType DetectFormat(const std::string& filepath);
+        static FormatType DetectFormatFromContent(const std::string& content);
+
+        // Format names ("Cherax", "YimMenu", "Lexis", "Stand") and file extensions
+        static std::string FormatTypeToName(FormatType format);
+        static FormatType FormatTypeFromName(const std::string& name);
+        static std::string GetFormatExtension(FormatType format);
+
+        // Load/save any format through the canonical (Yim) outfit
+        static bool LoadAsYim(const std::string& filepath, FormatType format, YimOutfit& outfit);
+        static bool ParseAsYim(const std::string& content, FormatType format, YimOutfit& outfit);
+        static std::string SerializeFromYim(const YimOutfit& outfit, FormatType format);
         
         // Universal conversion interface
         static bool ConvertFile(const std::string& inputPath, 
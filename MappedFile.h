@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== MAPPED FILE ==============
+    // Read-only memory mapping of a whole file (file mapping on Windows,
+    // mmap elsewhere). The view stays valid until Close or destruction.
+    class MappedFile {
+    private:
+        const uint8_t* data;
+        size_t size;
+#ifdef _WIN32
+        void* fileHandle;
+        void* mappingHandle;
+#endif
+
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Fails for missing files and files shorter than minSize
+        bool Open(const std::string& filepath, size_t minSize = 1);
+        void Close();
+
+        const uint8_t* Data() const { return data; }
+        size_t Size() const { return size; }
+        bool IsOpen() const { return data != nullptr; }
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,290 @@
+#include "OutfitBundle.h"
+#include "OutfitCodec.h"
+#include "FileHandler.h"
+#include <cctype>
+
+namespace OutfitConverter {
+
+    // ============== BUNDLE HELPERS ==============
+    const char* const OutfitBundle::STAND_DELIMITER = "---";
+
+    bool OutfitBundle::ParseLayout(const std::string& name, BundleLayout& layout) {
+        if (name == "array") layout = BundleLayout::JSON_ARRAY;
+        else if (name == "ndjson") layout = BundleLayout::NDJSON;
+        else if (name == "blocks") layout = BundleLayout::STAND_BLOCKS;
+        else return false;
+        return true;
+    }
+
+    bool OutfitBundle::IsTextFormat(FormatConverter::FormatType format) {
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(format);
+        return codec && codec->GetExtension() != ".json";
+    }
+
+    std::string OutfitBundle::CompactJson(const std::string& json) {
+        std::string compact;
+        compact.reserve(json.size());
+
+        bool inString = false;
+        bool escaped = false;
+        for (char c : json) {
+            if (inString) {
+                if (escaped) escaped = false;
+                else if (c == '\\') escaped = true;
+                else if (c == '"') inString = false;
+            } else if (c == '"') {
+                inString = true;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                continue;
+            }
+            compact += c;
+        }
+        return compact;
+    }
+
+    // ============== BUNDLE READER ==============
+    BundleReader::BundleReader()
+        : file(nullptr), position(0), endOfFile(false), failed(false), textBlocks(false),
+          format(FormatConverter::FormatType::UNKNOWN), count(0) {}
+
+    BundleReader::~BundleReader() {
+        Close();
+    }
+
+    bool BundleReader::Open(const std::string& filepath, FormatConverter::FormatType bundleFormat) {
+        Close();
+
+        file = std::fopen(filepath.c_str(), "rb");
+        if (!file) return false;
+
+        buffer.clear();
+        position = 0;
+        endOfFile = false;
+        failed = false;
+        format = bundleFormat;
+        count = 0;
+
+        if (format != FormatConverter::FormatType::UNKNOWN) {
+            textBlocks = OutfitBundle::IsTextFormat(format);
+            return true;
+        }
+
+        // Undeclared format: anything that does not open with JSON is Stand text
+        while (position < buffer.size() || FillBuffer()) {
+            char c = buffer[position];
+            if (!std::isspace(static_cast<unsigned char>(c))) {
+                textBlocks = c != '[' && c != '{';
+                return true;
+            }
+            position++;
+        }
+        textBlocks = false;
+        return !failed;
+    }
+
+    void BundleReader::Close() {
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        buffer.clear();
+        position = 0;
+    }
+
+    void BundleReader::CompactBuffer() {
+        if (position > 0) {
+            buffer.erase(0, position);
+            position = 0;
+        }
+    }
+
+    bool BundleReader::FillBuffer() {
+        if (!file || endOfFile) return false;
+
+        // Consumed bytes are dropped first; callers keep offsets relative to position
+        CompactBuffer();
+        const size_t used = buffer.size();
+        buffer.resize(used + CHUNK_BYTES);
+        const size_t read = std::fread(&buffer[used], 1, CHUNK_BYTES, file);
+        buffer.resize(used + read);
+
+        if (read == 0) {
+            endOfFile = true;
+            if (std::ferror(file)) failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool BundleReader::NextJsonRecord(std::string& record) {
+        // Array brackets and separators between top-level objects are skipped,
+        // which is what lets arrays, NDJSON and concatenated objects share a path
+        for (;;) {
+            if (position >= buffer.size() && !FillBuffer()) return false;
+
+            char c = buffer[position];
+            if (c == '{') break;
+            if (!std::isspace(static_cast<unsigned char>(c)) && c != ',' && c != '[' && c != ']') {
+                failed = true;
+                return false;
+            }
+            position++;
+        }
+
+        size_t offset = 0;
+        int depth = 0;
+        bool inString = false;
+        bool escaped = false;
+        for (;;) {
+            if (position + offset >= buffer.size()) {
+                if (!FillBuffer()) {
+                    failed = true;  // Truncated object
+                    return false;
+                }
+                continue;
+            }
+
+            char c = buffer[position + offset++];
+            if (inString) {
+                if (escaped) escaped = false;
+                else if (c == '\\') escaped = true;
+                else if (c == '"') inString = false;
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{') {
+                depth++;
+            } else if (c == '}' && --depth == 0) {
+                record.assign(buffer, position, offset);
+                position += offset;
+                return true;
+            }
+        }
+    }
+
+    bool BundleReader::NextStandRecord(std::string& record) {
+        record.clear();
+        bool hasContent = false;
+
+        for (;;) {
+            size_t newline = buffer.find('\n', position);
+            if (newline == std::string::npos) {
+                if (FillBuffer()) continue;
+                if (position >= buffer.size()) return hasContent;
+                newline = buffer.size();    // Last line without a terminator
+            }
+
+            std::string line = buffer.substr(position, newline - position);
+            position = newline < buffer.size() ? newline + 1 : newline;
+
+            size_t first = line.find_first_not_of(" \t\r");
+            bool blank = first == std::string::npos;
+            if (!blank && line.substr(first, line.find_last_not_of(" \t\r") - first + 1) ==
+                              OutfitBundle::STAND_DELIMITER) {
+                if (hasContent) return true;
+                continue;
+            }
+
+            record += line;
+            record += '\n';
+            if (!blank) hasContent = true;
+        }
+    }
+
+    bool BundleReader::NextRecord(std::string& record) {
+        if (!file || failed) return false;
+
+        bool found = textBlocks ? NextStandRecord(record) : NextJsonRecord(record);
+        if (found) count++;
+        return found;
+    }
+
+    bool BundleReader::Next(YimOutfit& outfit) {
+        std::string record;
+        if (!NextRecord(record)) return false;
+
+        if (format == FormatConverter::FormatType::UNKNOWN) {
+            format = CodecRegistry::Instance().Detect(record);
+        }
+
+        outfit = YimOutfit();
+        if (!FormatConverter::ParseAsYim(record, format, outfit)) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    // ============== BUNDLE WRITER ==============
+    BundleWriter::BundleWriter()
+        : file(nullptr), format(FormatConverter::FormatType::UNKNOWN),
+          layout(BundleLayout::JSON_ARRAY), count(0), failed(false) {}
+
+    BundleWriter::~BundleWriter() {
+        if (file) {
+            // Never closed: abandon the temp file, leaving any previous bundle intact
+            FileHandler::CommitAtomicWrite(file, tempPath, targetPath, false);
+        }
+    }
+
+    bool BundleWriter::Open(const std::string& filepath, FormatConverter::FormatType bundleFormat,
+                            BundleLayout bundleLayout) {
+        if (file || !CodecRegistry::Instance().Get(bundleFormat)) return false;
+
+        format = bundleFormat;
+        if (OutfitBundle::IsTextFormat(format)) {
+            layout = BundleLayout::STAND_BLOCKS;
+        } else {
+            layout = bundleLayout == BundleLayout::STAND_BLOCKS ? BundleLayout::JSON_ARRAY : bundleLayout;
+        }
+        targetPath = filepath;
+        count = 0;
+        failed = false;
+
+        file = FileHandler::BeginAtomicWrite(targetPath, tempPath);
+        if (!file) return false;
+
+        if (layout == BundleLayout::JSON_ARRAY) WriteRaw("[\n");
+        return !failed;
+    }
+
+    bool BundleWriter::WriteRaw(const std::string& text) {
+        if (!failed && std::fwrite(text.data(), 1, text.size(), file) != text.size()) {
+            failed = true;
+        }
+        return !failed;
+    }
+
+    bool BundleWriter::Write(const YimOutfit& outfit) {
+        if (!file || failed) return false;
+
+        std::string text = CodecRegistry::Instance().Get(format)->Encode(outfit);
+        switch (layout) {
+            case BundleLayout::JSON_ARRAY:
+                if (count > 0) WriteRaw(",\n");
+                WriteRaw(text);
+                break;
+            case BundleLayout::NDJSON:
+                WriteRaw(OutfitBundle::CompactJson(text) + "\n");
+                break;
+            case BundleLayout::STAND_BLOCKS:
+                if (count > 0) WriteRaw(std::string(OutfitBundle::STAND_DELIMITER) + "\n");
+                WriteRaw(text);
+                if (!text.empty() && text.back() != '\n') WriteRaw("\n");
+                break;
+        }
+
+        if (!failed) count++;
+        return !failed;
+    }
+
+    bool BundleWriter::Close() {
+        if (!file) return false;
+
+        if (layout == BundleLayout::JSON_ARRAY) WriteRaw(count > 0 ? "\n]\n" : "]\n");
+
+        bool success = FileHandler::CommitAtomicWrite(file, tempPath, targetPath, !failed);
+        file = nullptr;
+        return success;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,106 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "FormatConverter.h"
+#include <string>
+#include <cstdio>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== BUNDLE LAYOUT ==============
+    // JSON formats are bundled as an array or as one compact object per line
+    // (NDJSON); Stand outfits as text blocks separated by a delimiter line.
+    enum class BundleLayout {
+        JSON_ARRAY,
+        NDJSON,
+        STAND_BLOCKS
+    };
+
+    // ============== BUNDLE READER ==============
+    // Streams the outfits of a bundle file one at a time through a fixed-size
+    // read buffer, so memory use does not grow with the number of outfits.
+    // Arrays, NDJSON and plain concatenated objects are all accepted.
+    class BundleReader {
+    private:
+        std::FILE* file;
+        std::string buffer;
+        size_t position;
+        bool endOfFile;
+        bool failed;
+        bool textBlocks;
+        FormatConverter::FormatType format;
+        size_t count;
+
+        bool FillBuffer();
+        void CompactBuffer();
+        bool NextJsonRecord(std::string& record);
+        bool NextStandRecord(std::string& record);
+
+    public:
+        static const size_t CHUNK_BYTES = 64 * 1024;
+
+        BundleReader();
+        ~BundleReader();
+
+        BundleReader(const BundleReader&) = delete;
+        BundleReader& operator=(const BundleReader&) = delete;
+
+        // UNKNOWN detects the format from the first outfit in the bundle
+        bool Open(const std::string& filepath,
+                  FormatConverter::FormatType bundleFormat = FormatConverter::FormatType::UNKNOWN);
+        void Close();
+
+        // Raw text of the next outfit; false at the end of the bundle or on error
+        bool NextRecord(std::string& record);
+        bool Next(YimOutfit& outfit);
+
+        bool HasError() const { return failed; }
+        size_t GetCount() const { return count; }
+        FormatConverter::FormatType GetFormat() const { return format; }
+    };
+
+    // ============== BUNDLE WRITER ==============
+    // Appends outfits to a bundle as they are produced. The file goes through
+    // FileHandler's temp-file-and-rename path, so an unfinished bundle never
+    // replaces an existing one; destroying an unclosed writer discards it.
+    class BundleWriter {
+    private:
+        std::FILE* file;
+        std::string tempPath;
+        std::string targetPath;
+        FormatConverter::FormatType format;
+        BundleLayout layout;
+        size_t count;
+        bool failed;
+
+        bool WriteRaw(const std::string& text);
+
+    public:
+        BundleWriter();
+        ~BundleWriter();
+
+        BundleWriter(const BundleWriter&) = delete;
+        BundleWriter& operator=(const BundleWriter&) = delete;
+
+        // Stand always uses STAND_BLOCKS; JSON formats accept either JSON layout
+        bool Open(const std::string& filepath, FormatConverter::FormatType bundleFormat,
+                  BundleLayout bundleLayout = BundleLayout::JSON_ARRAY);
+        bool Write(const YimOutfit& outfit);
+        bool Close();
+
+        size_t GetCount() const { return count; }
+    };
+
+    // ============== BUNDLE HELPERS ==============
+    class OutfitBundle {
+    public:
+        static const char* const STAND_DELIMITER;
+
+        static bool ParseLayout(const std::string& name, BundleLayout& layout);
+        static bool IsTextFormat(FormatConverter::FormatType format);
+
+        // Strips insignificant whitespace so an object fits on one NDJSON line
+        static std::string CompactJson(const std::string& json);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,150 @@
+#include "OutfitCodec.h"
+#include "FileHandler.h"
+#include "FormatClassifier.h"
+#include <algorithm>
+#include <cctype>
+
+namespace OutfitConverter {
+
+    // ============== ENCODE CONTEXT ==============
+    const CheraxOutfit& EncodeContext::GetCherax() const {
+        if (!cherax) {
+            cherax = std::make_unique<CheraxOutfit>(FormatConverter::YimToCherax(outfit));
+        }
+        return *cherax;
+    }
+
+    // ============== BUILT-IN CODECS ==============
+    namespace {
+
+        class CheraxCodec : public OutfitCodec {
+        public:
+            std::string GetName() const override { return "Cherax"; }
+            std::string GetExtension() const override { return ".json"; }
+
+            bool Decode(const std::string& content, YimOutfit& outfit) const override {
+                CheraxOutfit cherax;
+                if (!FileHandler::ParseCheraxOutfit(content, cherax)) return false;
+                outfit = FormatConverter::CheraxToYim(cherax);
+                return true;
+            }
+
+            std::string Encode(const EncodeContext& context) const override {
+                return FileHandler::SerializeCheraxOutfit(context.GetCherax());
+            }
+        };
+
+        class YimCodec : public OutfitCodec {
+        public:
+            std::string GetName() const override { return "YimMenu"; }
+            std::string GetExtension() const override { return ".json"; }
+
+            bool Decode(const std::string& content, YimOutfit& outfit) const override {
+                return FileHandler::ParseYimOutfit(content, outfit);
+            }
+
+            std::string Encode(const EncodeContext& context) const override {
+                return FileHandler::SerializeYimOutfit(context.GetOutfit());
+            }
+        };
+
+        class LexisCodec : public OutfitCodec {
+        public:
+            std::string GetName() const override { return "Lexis"; }
+            std::string GetExtension() const override { return ".json"; }
+
+            bool Decode(const std::string& content, YimOutfit& outfit) const override {
+                LexisOutfit lexis;
+                if (!FileHandler::ParseLexisOutfit(content, lexis)) return false;
+                outfit = FormatConverter::LexisToYim(lexis);
+                return true;
+            }
+
+            std::string Encode(const EncodeContext& context) const override {
+                return FileHandler::SerializeLexisOutfit(FormatConverter::YimToLexis(context.GetOutfit()));
+            }
+        };
+
+        class StandCodec : public OutfitCodec {
+        public:
+            std::string GetName() const override { return "Stand"; }
+            std::string GetExtension() const override { return ".txt"; }
+
+            bool Decode(const std::string& content, YimOutfit& outfit) const override {
+                StandOutfit stand;
+                if (!FileHandler::ParseStandOutfit(content, stand)) return false;
+                outfit = FormatConverter::StandToYim(stand);
+                return true;
+            }
+
+            std::string Encode(const EncodeContext& context) const override {
+                // Shares the Cherax intermediate with the Cherax codec
+                return FileHandler::SerializeStandOutfit(FormatConverter::CheraxToStand(context.GetCherax()));
+            }
+        };
+
+    } // namespace
+
+    // ============== CODEC REGISTRY ==============
+    CodecRegistry::CodecRegistry() {
+        codecs.resize(static_cast<size_t>(FormatConverter::FormatType::UNKNOWN) + 1);
+        codecs[static_cast<size_t>(FormatConverter::FormatType::CHERAX)] = std::make_unique<CheraxCodec>();
+        codecs[static_cast<size_t>(FormatConverter::FormatType::YIM)] = std::make_unique<YimCodec>();
+        codecs[static_cast<size_t>(FormatConverter::FormatType::LEXIS)] = std::make_unique<LexisCodec>();
+        codecs[static_cast<size_t>(FormatConverter::FormatType::STAND)] = std::make_unique<StandCodec>();
+    }
+
+    CodecRegistry& CodecRegistry::Instance() {
+        static CodecRegistry registry;
+        return registry;
+    }
+
+    FormatConverter::FormatType CodecRegistry::Register(std::unique_ptr<OutfitCodec> codec) {
+        if (!codec) return FormatConverter::FormatType::UNKNOWN;
+        codecs.push_back(std::move(codec));
+        return static_cast<FormatConverter::FormatType>(codecs.size() - 1);
+    }
+
+    FormatConverter::FormatType CodecRegistry::FindByName(const std::string& name) const {
+        auto lower = [](std::string value) {
+            std::transform(value.begin(), value.end(), value.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return value;
+        };
+
+        std::string wanted = lower(name);
+        if (wanted == "yim") wanted = "yimmenu";
+
+        for (size_t i = 0; i < codecs.size(); i++) {
+            if (codecs[i] && lower(codecs[i]->GetName()) == wanted) {
+                return static_cast<FormatConverter::FormatType>(i);
+            }
+        }
+        return FormatConverter::FormatType::UNKNOWN;
+    }
+
+    std::vector<FormatConverter::FormatType> CodecRegistry::GetFormats() const {
+        std::vector<FormatConverter::FormatType> formats;
+        for (size_t i = 0; i < codecs.size(); i++) {
+            if (codecs[i]) formats.push_back(static_cast<FormatConverter::FormatType>(i));
+        }
+        return formats;
+    }
+
+    FormatConverter::FormatType CodecRegistry::Detect(const std::string& content) const {
+        Classification builtin = FormatClassifier::Instance().Classify(content);
+
+        // Only registered codecs past the built-in slots have their own sniffers
+        FormatConverter::FormatType best = builtin.format;
+        float bestConfidence = builtin.confidence;
+        for (size_t i = static_cast<size_t>(FormatConverter::FormatType::UNKNOWN) + 1; i < codecs.size(); i++) {
+            float confidence = codecs[i]->Sniff(content);
+            if (confidence > bestConfidence) {
+                best = static_cast<FormatConverter::FormatType>(i);
+                bestConfidence = confidence;
+            }
+        }
+        return best;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,76 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace OutfitConverter {
+
+    // ============== ENCODE CONTEXT ==============
+    // Shared state for serializing one canonical outfit to several codecs.
+    // Intermediate forms are built on first use and reused by later codecs.
+    class EncodeContext {
+    private:
+        const YimOutfit& outfit;
+        mutable std::unique_ptr<CheraxOutfit> cherax;
+
+    public:
+        explicit EncodeContext(const YimOutfit& source) : outfit(source) {}
+
+        const YimOutfit& GetOutfit() const { return outfit; }
+        const CheraxOutfit& GetCherax() const;
+    };
+
+    // ============== OUTFIT CODEC ==============
+    // A file format: recognizes its content, decodes it into the canonical
+    // (Yim) outfit and encodes the canonical outfit back to text.
+    class OutfitCodec {
+    public:
+        virtual ~OutfitCodec() {}
+
+        virtual std::string GetName() const = 0;
+        virtual std::string GetExtension() const = 0;
+
+        // Confidence 0..1 that content is in this format. The built-in codecs
+        // are recognized by FormatClassifier and return 0 here.
+        virtual float Sniff(const std::string& content) const { (void)content; return 0.0f; }
+
+        virtual bool Decode(const std::string& content, YimOutfit& outfit) const = 0;
+        virtual std::string Encode(const EncodeContext& context) const = 0;
+
+        std::string Encode(const YimOutfit& outfit) const {
+            return Encode(EncodeContext(outfit));
+        }
+    };
+
+    // ============== CODEC REGISTRY ==============
+    // Flat table indexed by FormatType value. The four built-in formats occupy
+    // their enum slots and the UNKNOWN slot stays empty, so additional codecs
+    // are addressed as FormatType values past UNKNOWN and flow through the
+    // batch, fan-out and CLI paths unchanged. Register codecs at startup,
+    // before any worker threads run.
+    class CodecRegistry {
+    private:
+        std::vector<std::unique_ptr<OutfitCodec>> codecs;
+
+        CodecRegistry();
+
+    public:
+        static CodecRegistry& Instance();
+
+        FormatConverter::FormatType Register(std::unique_ptr<OutfitCodec> codec);
+
+        const OutfitCodec* Get(FormatConverter::FormatType format) const {
+            size_t index = static_cast<size_t>(format);
+            return index < codecs.size() ? codecs[index].get() : nullptr;
+        }
+
+        FormatConverter::FormatType FindByName(const std::string& name) const;
+        std::vector<FormatConverter::FormatType> GetFormats() const;
+
+        // Built-in classifier first, then any registered codec sniffers
+        FormatConverter::FormatType Detect(const std::string& content) const;
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,322 @@
+#include "OutfitCorpus.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        const uint64_t GOLDEN = 0x9E3779B97F4A7C15ull;
+        const uint64_t LAYOUT_STREAM = 0x4C41594F55540000ull;
+
+        uint64_t Mix64(uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        // SplitMix64: tiny, fast, and the same sequence everywhere, unlike
+        // the std distributions
+        class Random {
+        private:
+            uint64_t state;
+
+        public:
+            explicit Random(uint64_t seed) : state(seed) {}
+
+            uint64_t Next() {
+                state += GOLDEN;
+                return Mix64(state);
+            }
+
+            // Inclusive range
+            int Uniform(int low, int high) {
+                return low + static_cast<int>(Next() % static_cast<uint64_t>(high - low + 1));
+            }
+
+            double Unit() {
+                return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+            }
+        };
+
+        // The state is a hash of both values: a plain index * GOLDEN offset
+        // would make outfit i + 1's stream outfit i's shifted by one draw
+        Random StreamFor(const CorpusOptions& options, size_t index, uint64_t stream) {
+            return Random(Mix64(Mix64(options.seed ^ stream) ^ Mix64(static_cast<uint64_t>(index))));
+        }
+
+        // Skewed toward low values, like real drawable usage
+        int SkewedDrawable(Random& random, int low, int high) {
+            return random.Uniform(low, random.Uniform(low, high));
+        }
+
+        void AppendWhitespace(std::string& out, Random& random, size_t maxBytes, const char* characters, int kinds) {
+            const size_t length = 1 + random.Next() % maxBytes;
+            for (size_t i = 0; i < length; i++) out += characters[random.Uniform(0, kinds - 1)];
+        }
+
+        // Re-emits serializer JSON compact or pretty (4-space indent), with
+        // optionally shuffled object members and whitespace runs between
+        // tokens. Input is trusted serializer output.
+        class JsonRewriter {
+        private:
+            const std::string& in;
+            size_t pos;
+            Random& random;
+            bool pretty;
+            bool shuffle;
+            size_t whitespace;
+
+            void SkipWhitespace() {
+                while (pos < in.size() && (in[pos] == ' ' || in[pos] == '\t' || in[pos] == '\r' || in[pos] == '\n')) pos++;
+            }
+
+            void Gap(std::string& out) {
+                if (whitespace > 0 && random.Uniform(0, 15) == 0) AppendWhitespace(out, random, whitespace, " \t\r\n", 4);
+            }
+
+            void Newline(std::string& out, int depth) {
+                if (!pretty) return;
+                out += '\n';
+                out.append(static_cast<size_t>(depth) * 4, ' ');
+            }
+
+            void String(std::string& out) {
+                const size_t start = pos++;
+                while (pos < in.size() && in[pos] != '"') pos += in[pos] == '\\' ? 2 : 1;
+                pos++;
+                out.append(in, start, pos - start);
+            }
+
+        public:
+            JsonRewriter(const std::string& input, Random& rng, bool prettyLayout, bool shuffleKeys, size_t whitespaceBytes)
+                : in(input), pos(0), random(rng), pretty(prettyLayout), shuffle(shuffleKeys), whitespace(whitespaceBytes) {}
+
+            void Value(std::string& out, int depth) {
+                SkipWhitespace();
+                if (pos >= in.size()) return;
+                const char open = in[pos];
+                if (open == '"') {
+                    String(out);
+                    return;
+                }
+                if (open != '{' && open != '[') {
+                    const size_t start = pos;
+                    while (pos < in.size() && in[pos] != ',' && in[pos] != '}' && in[pos] != ']' &&
+                           in[pos] != ' ' && in[pos] != '\t' && in[pos] != '\r' && in[pos] != '\n') pos++;
+                    out.append(in, start, pos - start);
+                    return;
+                }
+
+                const bool object = open == '{';
+                const char close = object ? '}' : ']';
+                std::vector<std::string> parts;
+                pos++;
+                while (true) {
+                    SkipWhitespace();
+                    if (pos >= in.size()) break;
+                    if (in[pos] == close) {
+                        pos++;
+                        break;
+                    }
+                    if (in[pos] == ',') {
+                        pos++;
+                        continue;
+                    }
+                    std::string part;
+                    if (object) {
+                        String(part);
+                        SkipWhitespace();
+                        pos++;  // ':'
+                        Gap(part);
+                        part += pretty ? ": " : ":";
+                        Gap(part);
+                    }
+                    Value(part, depth + 1);
+                    parts.push_back(std::move(part));
+                }
+
+                // Array order is data (Lexis slots), member order is not
+                if (object && shuffle) {
+                    for (size_t i = parts.size(); i > 1; i--) std::swap(parts[i - 1], parts[random.Next() % i]);
+                }
+
+                out += open;
+                for (size_t i = 0; i < parts.size(); i++) {
+                    if (i > 0) out += ',';
+                    Newline(out, depth + 1);
+                    Gap(out);
+                    out += parts[i];
+                    Gap(out);
+                }
+                if (!parts.empty()) Newline(out, depth);
+                out += close;
+            }
+        };
+
+        // Stand: shuffled lines, whitespace around keys and values, and runs
+        // of blank lines; the parser trims both sides of the first colon
+        std::string RewriteStand(const std::string& content, Random& random, bool shuffle, size_t whitespace) {
+            std::vector<std::string> lines;
+            size_t start = 0;
+            while (start < content.size()) {
+                size_t end = content.find('\n', start);
+                if (end == std::string::npos) end = content.size();
+                lines.push_back(content.substr(start, end - start));
+                start = end + 1;
+            }
+            if (shuffle) {
+                for (size_t i = lines.size(); i > 1; i--) std::swap(lines[i - 1], lines[random.Next() % i]);
+            }
+
+            std::string out;
+            for (const auto& line : lines) {
+                const size_t colon = line.find(':');
+                if (whitespace > 0 && colon != std::string::npos && random.Uniform(0, 3) == 0) {
+                    AppendWhitespace(out, random, whitespace, " \t", 2);
+                    out.append(line, 0, colon + 1);
+                    AppendWhitespace(out, random, whitespace, " \t", 2);
+                    out.append(line, colon + 1, std::string::npos);
+                    AppendWhitespace(out, random, whitespace, " \t", 2);
+                } else {
+                    out += line;
+                }
+                out += '\n';
+                if (whitespace > 0 && random.Uniform(0, 7) == 0) {
+                    AppendWhitespace(out, random, whitespace, " \t\n", 3);
+                    out += '\n';
+                }
+            }
+            return out;
+        }
+
+        size_t Digits(size_t value) {
+            size_t digits = 1;
+            while (value >= 10) {
+                value /= 10;
+                digits++;
+            }
+            return digits;
+        }
+
+        std::string Padded(size_t value, size_t width) {
+            std::string text = std::to_string(value);
+            return text.size() < width ? std::string(width - text.size(), '0') + text : text;
+        }
+    }
+
+    // ============== CORPUS GENERATOR ==============
+    YimOutfit CorpusGenerator::GenerateOutfit(const CorpusOptions& options, size_t index) {
+        Random random = StreamFor(options, index, 0);
+        YimOutfit outfit;
+
+        outfit.model = random.Uniform(0, 1) ? ComponentMapping::MODEL_MP_F_FREEMODE_01
+                                            : ComponentMapping::MODEL_MP_M_FREEMODE_01;
+
+        // Mixes in steps of 0.05, so they print and parse back exactly
+        BlendData& blend = outfit.blend_data;
+        blend.shape_first_id = random.Uniform(0, 45);
+        blend.shape_second_id = random.Uniform(0, 45);
+        blend.skin_first_id = random.Uniform(0, 45);
+        blend.skin_second_id = random.Uniform(0, 45);
+        blend.shape_mix = static_cast<float>(random.Uniform(0, 20)) / 20.0f;
+        blend.skin_mix = static_cast<float>(random.Uniform(0, 20)) / 20.0f;
+
+        // Every slot is written; a random subset of components is dressed
+        int slots[12];
+        for (int slot = 0; slot < 12; slot++) {
+            slots[slot] = slot;
+            outfit.components[slot] = Component();
+        }
+        const int low = std::max(0, std::min(options.minComponents, 12));
+        const int high = std::max(low, std::min(options.maxComponents, 12));
+        const int dressed = random.Uniform(low, high);
+        for (int i = 0; i < dressed; i++) {
+            std::swap(slots[i], slots[random.Uniform(i, 11)]);
+            const int palette = random.Uniform(0, 9) == 0 ? random.Uniform(1, 3) : 0;
+            outfit.components[slots[i]] = Component(SkewedDrawable(random, 1, 400), random.Uniform(0, 15), palette);
+        }
+
+        for (int slot = 0; slot < 9; slot++) {
+            outfit.props[slot] = random.Unit() < options.propRate
+                ? Prop(SkewedDrawable(random, 0, 150), random.Uniform(0, 9)) : Prop();
+        }
+        return outfit;
+    }
+
+    std::string CorpusGenerator::GenerateContent(const CorpusOptions& options, size_t index) {
+        std::string content = FormatConverter::SerializeFromYim(GenerateOutfit(options, index), options.format);
+
+        Random random = StreamFor(options, index, LAYOUT_STREAM);
+        bool shuffle = false;
+        size_t whitespace = 0;
+        if (random.Unit() < options.pathologicalRate) {
+            const int kind = random.Uniform(1, 3);
+            shuffle = (kind & 1) != 0;
+            whitespace = (kind & 2) != 0 ? std::max<size_t>(options.whitespaceBytes, 1) : 0;
+        }
+
+        if (options.format == FormatConverter::FormatType::STAND) {
+            return shuffle || whitespace > 0 ? RewriteStand(content, random, shuffle, whitespace) : content;
+        }
+        const bool pretty = options.layout == CorpusLayout::PRETTY;
+        if (pretty && !shuffle && whitespace == 0) return content;
+
+        std::string out;
+        out.reserve(content.size());
+        JsonRewriter(content, random, pretty, shuffle, whitespace).Value(out, 0);
+        if (pretty) out += '\n';
+        return out;
+    }
+
+    std::string CorpusGenerator::GetRelativePath(const CorpusOptions& options, size_t index) {
+        const size_t last = options.count > 0 ? options.count - 1 : 0;
+        std::string name = "o" + Padded(index, std::max<size_t>(7, Digits(last))) +
+                           FormatConverter::GetFormatExtension(options.format);
+        if (options.filesPerDirectory == 0) return name;
+        const size_t width = std::max<size_t>(4, Digits(last / options.filesPerDirectory));
+        return Padded(index / options.filesPerDirectory, width) + "/" + name;
+    }
+
+    CorpusResult CorpusGenerator::Write(const std::string& outputDir, const CorpusOptions& options, unsigned threads) {
+        CorpusResult result;
+        std::error_code ec;
+        fs::create_directories(outputDir, ec);
+        if (options.filesPerDirectory > 0) {
+            for (size_t index = 0; index < options.count; index += options.filesPerDirectory) {
+                fs::create_directories(fs::path(outputDir) / fs::path(GetRelativePath(options, index)).parent_path(), ec);
+            }
+        }
+
+        std::vector<char> written(options.count, 0);
+        std::atomic<uint64_t> bytes(0);
+        ParallelFor(options.count, threads, [&](size_t index, unsigned) {
+            const std::string content = GenerateContent(options, index);
+            const std::string path = (fs::path(outputDir) / GetRelativePath(options, index)).string();
+            std::FILE* file = std::fopen(path.c_str(), "wb");
+            if (!file) return;
+            const bool ok = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+            if (std::fclose(file) == 0 && ok) {
+                written[index] = 1;
+                bytes += content.size();
+            }
+        });
+
+        for (size_t index = 0; index < options.count; index++) {
+            if (written[index]) {
+                result.written++;
+            } else {
+                result.failed++;
+                result.failedItems.push_back(GetRelativePath(options, index));
+            }
+        }
+        result.bytes = bytes;
+        return result;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,69 @@
+#pragma once
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    enum class CorpusLayout {
+        PRETTY,     // As the serializers write it
+        COMPACT     // No whitespace between JSON tokens
+    };
+
+    struct CorpusOptions {
+        uint64_t seed;
+        size_t count;
+        FormatConverter::FormatType format;
+        CorpusLayout layout;
+
+        // Size distribution: non-default components per outfit, drawn
+        // uniformly from [minComponents, maxComponents] (0-12)
+        int minComponents;
+        int maxComponents;
+        double propRate;            // Chance of each prop slot being worn
+
+        // Share of outfits written in a pathological form: a random mix of
+        // whitespace runs of up to whitespaceBytes between tokens (between
+        // and around lines for Stand) and shuffled object keys (lines)
+        double pathologicalRate;
+        size_t whitespaceBytes;
+
+        size_t filesPerDirectory;   // Shards output into numbered subdirectories; 0 = flat
+
+        CorpusOptions() : seed(1), count(1000), format(FormatConverter::FormatType::YIM),
+            layout(CorpusLayout::PRETTY), minComponents(4), maxComponents(12), propRate(0.3),
+            pathologicalRate(0.0), whitespaceBytes(4096), filesPerDirectory(1000) {}
+    };
+
+    struct CorpusResult {
+        size_t written;
+        size_t failed;
+        uint64_t bytes;
+        std::vector<std::string> failedItems;
+
+        CorpusResult() : written(0), failed(0), bytes(0) {}
+    };
+
+    // ============== CORPUS GENERATOR ==============
+    // Seeded synthetic outfits for benchmarks. Outfit i depends only on the
+    // seed and i (its own generator is seeded from both), so a corpus is the
+    // same for any thread count, platform or standard library.
+    class CorpusGenerator {
+    public:
+        static YimOutfit GenerateOutfit(const CorpusOptions& options, size_t index);
+
+        // File content of outfit i in options.format and layout, including
+        // its pathological form when outfit i is drawn for one
+        static std::string GenerateContent(const CorpusOptions& options, size_t index);
+
+        // "0003/o0003412.json" for index 3412 with 1000 files per directory
+        static std::string GetRelativePath(const CorpusOptions& options, size_t index);
+
+        // Writes every file in parallel. Files are written in place rather
+        // than through FileHandler's temp-file-and-rename path, for speed.
+        static CorpusResult Write(const std::string& outputDir, const CorpusOptions& options, unsigned threads = 0);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,314 @@
+#include "OutfitDelta.h"
+#include "WardrobeContainer.h"
+#include "FileHandler.h"
+#include "ByteOrder.h"
+#include <cstring>
+
+namespace OutfitConverter {
+
+    // ============== FIELD COMPARISON ==============
+    namespace {
+
+        const uint8_t FLAG_MODEL = 1;
+        const uint8_t FLAG_BLEND = 2;
+
+        // Merge walk over two slot maps: onChange(slot, inA, inB) per differing slot
+        template<typename T, typename Fn>
+        void WalkSlots(const std::map<int, T>& a, const std::map<int, T>& b, Fn onChange) {
+            auto ia = a.begin();
+            auto ib = b.begin();
+            while (ia != a.end() || ib != b.end()) {
+                if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) {
+                    onChange(ia->first, &ia->second, static_cast<const T*>(nullptr));
+                    ++ia;
+                } else if (ia == a.end() || ib->first < ia->first) {
+                    onChange(ib->first, static_cast<const T*>(nullptr), &ib->second);
+                    ++ib;
+                } else {
+                    if (ia->second != ib->second) onChange(ia->first, &ia->second, &ib->second);
+                    ++ia;
+                    ++ib;
+                }
+            }
+        }
+
+        void AppendU16(std::string& out, uint16_t value) {
+            uint8_t bytes[2];
+            PutU16(bytes, value);
+            out.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        }
+
+        void AppendU32(std::string& out, uint32_t value) {
+            uint8_t bytes[4];
+            PutU32(bytes, value);
+            out.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        }
+
+        void AppendI32(std::string& out, int value) {
+            AppendU32(out, static_cast<uint32_t>(value));
+        }
+
+        void AppendF32(std::string& out, float value) {
+            uint8_t bytes[4];
+            PutF32(bytes, value);
+            out.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        }
+
+        // Bounds-checked cursor over a serialized delta
+        class Cursor {
+        private:
+            const std::string& data;
+            size_t& offset;
+            bool valid;
+
+        public:
+            Cursor(const std::string& source, size_t& position) : data(source), offset(position), valid(true) {}
+
+            bool Take(size_t bytes, const uint8_t*& out) {
+                if (!valid || bytes > data.size() - offset) {
+                    valid = false;
+                    return false;
+                }
+                out = reinterpret_cast<const uint8_t*>(data.data()) + offset;
+                offset += bytes;
+                return true;
+            }
+
+            uint8_t U8() { const uint8_t* p; return Take(1, p) ? p[0] : 0; }
+            uint16_t U16() { const uint8_t* p; return Take(2, p) ? GetU16(p) : 0; }
+            uint32_t U32() { const uint8_t* p; return Take(4, p) ? GetU32(p) : 0; }
+            int I32() { const uint8_t* p; return Take(4, p) ? GetI32(p) : 0; }
+            float F32() { const uint8_t* p; return Take(4, p) ? GetF32(p) : 0.0f; }
+            bool IsValid() const { return valid; }
+        };
+
+    } // namespace
+
+    // ============== DELTA CODEC ==============
+    OutfitDelta DeltaCodec::Encode(const YimOutfit& base, const YimOutfit& outfit, uint32_t baseId) {
+        OutfitDelta delta;
+        delta.baseId = baseId;
+
+        if (base.model != outfit.model) {
+            delta.modelChanged = true;
+            delta.model = outfit.model;
+        }
+        if (base.blend_data != outfit.blend_data) {
+            delta.blendChanged = true;
+            delta.blend = outfit.blend_data;
+        }
+
+        WalkSlots(base.components, outfit.components,
+            [&](int slot, const Component*, const Component* target) {
+                if (target) delta.components.emplace_back(slot, *target);
+                else delta.removedComponents.push_back(slot);
+            });
+        WalkSlots(base.props, outfit.props,
+            [&](int slot, const Prop*, const Prop* target) {
+                if (target) delta.props.emplace_back(slot, *target);
+                else delta.removedProps.push_back(slot);
+            });
+
+        return delta;
+    }
+
+    void DeltaCodec::Apply(const YimOutfit& base, const OutfitDelta& delta, YimOutfit& outfit) {
+        outfit = base;
+        if (delta.modelChanged) outfit.model = delta.model;
+        if (delta.blendChanged) outfit.blend_data = delta.blend;
+
+        for (int slot : delta.removedComponents) outfit.components.erase(slot);
+        for (const auto& change : delta.components) outfit.components[change.first] = change.second;
+        for (int slot : delta.removedProps) outfit.props.erase(slot);
+        for (const auto& change : delta.props) outfit.props[change.first] = change.second;
+    }
+
+    size_t DeltaCodec::Distance(const YimOutfit& a, const YimOutfit& b, size_t limit) {
+        size_t distance = (a.model != b.model ? 1 : 0) + (a.blend_data != b.blend_data ? 1 : 0);
+        if (distance > limit) return distance;
+
+        WalkSlots(a.components, b.components,
+            [&](int, const Component*, const Component*) { distance++; });
+        if (distance > limit) return distance;
+        WalkSlots(a.props, b.props,
+            [&](int, const Prop*, const Prop*) { distance++; });
+        return distance;
+    }
+
+    std::string DeltaCodec::Serialize(const OutfitDelta& delta) {
+        std::string out;
+        AppendU32(out, delta.baseId);
+        out += static_cast<char>((delta.modelChanged ? FLAG_MODEL : 0) | (delta.blendChanged ? FLAG_BLEND : 0));
+
+        if (delta.modelChanged) AppendU32(out, delta.model);
+        if (delta.blendChanged) {
+            const BlendData& blend = delta.blend;
+            AppendI32(out, blend.is_parent);
+            AppendI32(out, blend.shape_first_id);
+            AppendF32(out, blend.shape_mix);
+            AppendI32(out, blend.shape_second_id);
+            AppendI32(out, blend.shape_third_id);
+            AppendI32(out, blend.skin_first_id);
+            AppendF32(out, blend.skin_mix);
+            AppendI32(out, blend.skin_second_id);
+            AppendI32(out, blend.skin_third_id);
+            AppendF32(out, blend.third_mix);
+        }
+
+        AppendU16(out, static_cast<uint16_t>(delta.components.size()));
+        for (const auto& change : delta.components) {
+            AppendI32(out, change.first);
+            AppendI32(out, change.second.drawable);
+            AppendI32(out, change.second.texture);
+            AppendI32(out, change.second.palette);
+        }
+        AppendU16(out, static_cast<uint16_t>(delta.removedComponents.size()));
+        for (int slot : delta.removedComponents) AppendI32(out, slot);
+
+        AppendU16(out, static_cast<uint16_t>(delta.props.size()));
+        for (const auto& change : delta.props) {
+            AppendI32(out, change.first);
+            AppendI32(out, change.second.drawable);
+            AppendI32(out, change.second.texture);
+        }
+        AppendU16(out, static_cast<uint16_t>(delta.removedProps.size()));
+        for (int slot : delta.removedProps) AppendI32(out, slot);
+
+        return out;
+    }
+
+    bool DeltaCodec::Deserialize(const std::string& data, size_t& offset, OutfitDelta& delta) {
+        Cursor in(data, offset);
+        delta = OutfitDelta();
+
+        delta.baseId = in.U32();
+        const uint8_t flags = in.U8();
+        delta.modelChanged = (flags & FLAG_MODEL) != 0;
+        delta.blendChanged = (flags & FLAG_BLEND) != 0;
+
+        if (delta.modelChanged) delta.model = in.U32();
+        if (delta.blendChanged) {
+            BlendData& blend = delta.blend;
+            blend.is_parent = in.I32();
+            blend.shape_first_id = in.I32();
+            blend.shape_mix = in.F32();
+            blend.shape_second_id = in.I32();
+            blend.shape_third_id = in.I32();
+            blend.skin_first_id = in.I32();
+            blend.skin_mix = in.F32();
+            blend.skin_second_id = in.I32();
+            blend.skin_third_id = in.I32();
+            blend.third_mix = in.F32();
+        }
+
+        for (uint16_t n = in.U16(); in.IsValid() && n > 0; n--) {
+            int slot = in.I32();
+            int drawable = in.I32();
+            int texture = in.I32();
+            int palette = in.I32();
+            delta.components.emplace_back(slot, Component(drawable, texture, palette));
+        }
+        for (uint16_t n = in.U16(); in.IsValid() && n > 0; n--) {
+            delta.removedComponents.push_back(in.I32());
+        }
+        for (uint16_t n = in.U16(); in.IsValid() && n > 0; n--) {
+            int slot = in.I32();
+            int drawable = in.I32();
+            int texture = in.I32();
+            delta.props.emplace_back(slot, Prop(drawable, texture));
+        }
+        for (uint16_t n = in.U16(); in.IsValid() && n > 0; n--) {
+            delta.removedProps.push_back(in.I32());
+        }
+
+        return in.IsValid();
+    }
+
+    // ============== DELTA STORE ==============
+    const char DeltaStore::MAGIC[4] = { 'O', 'D', 'S', '1' };
+
+    size_t DeltaStore::AddBase(const YimOutfit& base) {
+        bases.push_back(base);
+        return bases.size() - 1;
+    }
+
+    size_t DeltaStore::Add(const YimOutfit& outfit) {
+        // Nearest base by change count; the running best bounds each comparison
+        size_t bestBase = bases.size();
+        size_t bestDistance = maxDistance;
+        for (size_t i = 0; i < bases.size() && bestDistance > 0; i++) {
+            size_t distance = DeltaCodec::Distance(bases[i], outfit, bestDistance);
+            if (distance < bestDistance || (distance == bestDistance && bestBase == bases.size())) {
+                bestBase = i;
+                bestDistance = distance;
+            }
+        }
+
+        if (bestBase == bases.size()) bestBase = AddBase(outfit);
+        entries.push_back(DeltaCodec::Encode(bases[bestBase], outfit, static_cast<uint32_t>(bestBase)));
+        return entries.size() - 1;
+    }
+
+    bool DeltaStore::Get(size_t index, YimOutfit& outfit) const {
+        if (index >= entries.size() || entries[index].baseId >= bases.size()) return false;
+        DeltaCodec::Apply(bases[entries[index].baseId], entries[index], outfit);
+        return true;
+    }
+
+    void DeltaStore::Clear() {
+        bases.clear();
+        entries.clear();
+    }
+
+    bool DeltaStore::Save(const std::string& filepath) const {
+        std::string content(32, '\0');
+        uint8_t* header = reinterpret_cast<uint8_t*>(&content[0]);
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        PutU32(header + 4, VERSION);
+        PutU64(header + 8, bases.size());
+        PutU64(header + 16, entries.size());
+
+        uint8_t record[WardrobeContainer::RECORD_SIZE];
+        for (const auto& base : bases) {
+            WardrobeContainer::EncodeRecord(base, WardrobeContainer::NO_NAME, 0, record);
+            content.append(reinterpret_cast<const char*>(record), sizeof(record));
+        }
+        for (const auto& entry : entries) {
+            content += DeltaCodec::Serialize(entry);
+        }
+
+        return FileHandler::WriteFileContent(filepath, content);
+    }
+
+    bool DeltaStore::Load(const std::string& filepath) {
+        Clear();
+
+        const std::string content = FileHandler::ReadFileContent(filepath);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(content.data());
+        if (content.size() < 32 || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || GetU32(data + 4) != VERSION) {
+            return false;
+        }
+
+        const uint64_t baseCount = GetU64(data + 8);
+        const uint64_t entryCount = GetU64(data + 16);
+        if (baseCount > (content.size() - 32) / WardrobeContainer::RECORD_SIZE) return false;
+
+        bases.resize(static_cast<size_t>(baseCount));
+        size_t offset = 32;
+        for (auto& base : bases) {
+            WardrobeContainer::DecodeRecord(data + offset, base);
+            offset += WardrobeContainer::RECORD_SIZE;
+        }
+
+        for (uint64_t i = 0; i < entryCount; i++) {
+            OutfitDelta delta;
+            if (!DeltaCodec::Deserialize(content, offset, delta) || delta.baseId >= bases.size()) {
+                Clear();
+                return false;
+            }
+            entries.push_back(std::move(delta));
+        }
+        return true;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,80 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== OUTFIT DELTA ==============
+    // The slots in which an outfit differs from a base outfit. Applying the
+    // delta to that base reproduces the outfit exactly; the change lists
+    // double as a ready-made "what changed" description.
+    struct OutfitDelta {
+        uint32_t baseId;
+        bool modelChanged;
+        uint32_t model;
+        bool blendChanged;
+        BlendData blend;
+        std::vector<std::pair<int, Component>> components;   // Changed or added, by slot
+        std::vector<int> removedComponents;
+        std::vector<std::pair<int, Prop>> props;
+        std::vector<int> removedProps;
+
+        OutfitDelta() : baseId(0), modelChanged(false), model(0), blendChanged(false) {}
+
+        size_t ChangeCount() const {
+            return (modelChanged ? 1 : 0) + (blendChanged ? 1 : 0) + components.size() +
+                   removedComponents.size() + props.size() + removedProps.size();
+        }
+        bool IsEmpty() const { return ChangeCount() == 0; }
+    };
+
+    class DeltaCodec {
+    public:
+        static OutfitDelta Encode(const YimOutfit& base, const YimOutfit& outfit, uint32_t baseId = 0);
+        static void Apply(const YimOutfit& base, const OutfitDelta& delta, YimOutfit& outfit);
+
+        // Number of changes Encode would produce; stops counting past limit
+        static size_t Distance(const YimOutfit& a, const YimOutfit& b, size_t limit = SIZE_MAX);
+
+        // Compact little-endian form: only changed fields are written
+        static std::string Serialize(const OutfitDelta& delta);
+        static bool Deserialize(const std::string& data, size_t& offset, OutfitDelta& delta);
+    };
+
+    // ============== DELTA STORE ==============
+    // Outfits stored as deltas against the nearest of a small set of bases.
+    // An outfit further than maxDistance changes from every base becomes a
+    // base itself (with an empty delta), so the base set grows only as
+    // genuinely new looks arrive.
+    class DeltaStore {
+    private:
+        std::vector<YimOutfit> bases;
+        std::vector<OutfitDelta> entries;
+        size_t maxDistance;
+
+    public:
+        static const char MAGIC[4];
+        static const uint32_t VERSION = 1;
+        static const size_t DEFAULT_MAX_DISTANCE = 8;
+
+        explicit DeltaStore(size_t maxChanges = DEFAULT_MAX_DISTANCE) : maxDistance(maxChanges) {}
+
+        size_t AddBase(const YimOutfit& base);
+        size_t Add(const YimOutfit& outfit);
+        bool Get(size_t index, YimOutfit& outfit) const;
+        void Clear();
+
+        size_t Size() const { return entries.size(); }
+        size_t GetBaseCount() const { return bases.size(); }
+        const YimOutfit& GetBase(size_t baseId) const { return bases[baseId]; }
+        const OutfitDelta& GetDelta(size_t index) const { return entries[index]; }
+
+        bool Save(const std::string& filepath) const;
+        bool Load(const std::string& filepath);
+    };
+
+} // namespace OutfitConverter
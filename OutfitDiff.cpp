@@ -0,0 +1,775 @@
+#include "OutfitDiff.h"
+#include "OutfitDelta.h"
+#include "FileHandler.h"
+#include "BatchConverter.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <sstream>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        const char* PATCH_HEADER = "# OutfitConverter patch v1";
+
+        uint8_t ChangedFields(int d1, int t1, int p1, int d2, int t2, int p2) {
+            return (d1 != d2 ? OutfitChange::FIELD_DRAWABLE : 0) |
+                   (t1 != t2 ? OutfitChange::FIELD_TEXTURE : 0) |
+                   (p1 != p2 ? OutfitChange::FIELD_PALETTE : 0);
+        }
+
+        // ============== VALUE TEXT ==============
+        std::string FloatText(float value) {
+            // 9 significant digits round-trip any float exactly
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+            return buffer;
+        }
+
+        std::string ComponentText(bool present, const Component& c) {
+            if (!present) return "-";
+            return std::to_string(c.drawable) + "," + std::to_string(c.texture) + "," + std::to_string(c.palette);
+        }
+
+        std::string PropText(bool present, const Prop& p) {
+            if (!present) return "-";
+            return std::to_string(p.drawable) + "," + std::to_string(p.texture);
+        }
+
+        std::string BlendText(const BlendData& b) {
+            return std::to_string(b.is_parent) + "," +
+                   std::to_string(b.shape_first_id) + "," + std::to_string(b.shape_second_id) + "," +
+                   std::to_string(b.shape_third_id) + "," + FloatText(b.shape_mix) + "," +
+                   std::to_string(b.skin_first_id) + "," + std::to_string(b.skin_second_id) + "," +
+                   std::to_string(b.skin_third_id) + "," + FloatText(b.skin_mix) + "," +
+                   FloatText(b.third_mix);
+        }
+
+        std::vector<std::string> Split(const std::string& text, char separator) {
+            std::vector<std::string> parts;
+            size_t start = 0;
+            while (true) {
+                size_t end = text.find(separator, start);
+                parts.push_back(text.substr(start, end == std::string::npos ? std::string::npos : end - start));
+                if (end == std::string::npos) break;
+                start = end + 1;
+            }
+            return parts;
+        }
+
+        bool ParseInt(const std::string& text, long long& value) {
+            if (text.empty()) return false;
+            char* end = nullptr;
+            value = std::strtoll(text.c_str(), &end, 10);
+            return *end == '\0';
+        }
+
+        bool ParseInts(const std::string& text, int* values, size_t count) {
+            std::vector<std::string> parts = Split(text, ',');
+            if (parts.size() != count) return false;
+            for (size_t i = 0; i < count; i++) {
+                long long value;
+                if (!ParseInt(parts[i], value)) return false;
+                values[i] = static_cast<int>(value);
+            }
+            return true;
+        }
+
+        bool ParseBlend(const std::string& text, BlendData& b) {
+            std::vector<std::string> parts = Split(text, ',');
+            if (parts.size() != 10) return false;
+            int* ints[] = { &b.is_parent, &b.shape_first_id, &b.shape_second_id, &b.shape_third_id,
+                            nullptr, &b.skin_first_id, &b.skin_second_id, &b.skin_third_id, nullptr, nullptr };
+            float* floats[] = { nullptr, nullptr, nullptr, nullptr, &b.shape_mix,
+                                nullptr, nullptr, nullptr, &b.skin_mix, &b.third_mix };
+            for (size_t i = 0; i < parts.size(); i++) {
+                if (ints[i]) {
+                    long long value;
+                    if (!ParseInt(parts[i], value)) return false;
+                    *ints[i] = static_cast<int>(value);
+                } else {
+                    char* end = nullptr;
+                    *floats[i] = std::strtof(parts[i].c_str(), &end);
+                    if (parts[i].empty() || *end != '\0') return false;
+                }
+            }
+            return true;
+        }
+
+        // ============== NATIVE PATCHING ==============
+        // A changed outfit is patched in its own format so fields the canonical
+        // form does not carry (Cherax baseFlags, Stand hair colours, Stand
+        // slots with no canonical slot) survive. Only the patched slots are
+        // copied from the patched outfit converted into that format.
+        struct StandSlot {
+            int slot;
+            int StandOutfit::* drawable;
+            int StandOutfit::* texture;     // Hair has none
+        };
+
+        const StandSlot STAND_COMPONENTS[] = {
+            { SLOT_HEAD, &StandOutfit::head, &StandOutfit::head_variation },
+            { SLOT_BEARD, &StandOutfit::mask, &StandOutfit::mask_variation },
+            { SLOT_HAIR, &StandOutfit::hair, nullptr },
+            { SLOT_TORSO, &StandOutfit::gloves_torso, &StandOutfit::gloves_torso_variation },
+            { SLOT_LEGS, &StandOutfit::pants, &StandOutfit::pants_variation },
+            { SLOT_FEET, &StandOutfit::shoes, &StandOutfit::shoes_variation },
+            { SLOT_SPECIAL, &StandOutfit::top, &StandOutfit::top_variation },
+            { SLOT_SPECIAL2, &StandOutfit::top2, &StandOutfit::top2_variation },
+            { SLOT_DECAL, &StandOutfit::decals, &StandOutfit::decals_variation }
+        };
+
+        const StandSlot STAND_PROPS[] = {
+            { PROP_HEAD, &StandOutfit::hat, &StandOutfit::hat_variation },
+            { PROP_EYES, &StandOutfit::glasses, &StandOutfit::glasses_variation },
+            { PROP_EARS, &StandOutfit::earwear, &StandOutfit::earwear_variation },
+            { PROP_LEFT_WRIST, &StandOutfit::watch, &StandOutfit::watch_variation },
+            { PROP_RIGHT_WRIST, &StandOutfit::bracelet, &StandOutfit::bracelet_variation }
+        };
+
+        template <size_t N>
+        void CopyStandSlot(const StandSlot (&table)[N], int slot, const StandOutfit& from, StandOutfit& to) {
+            for (const StandSlot& entry : table) {
+                if (entry.slot != slot) continue;
+                to.*entry.drawable = from.*entry.drawable;
+                if (entry.texture) to.*entry.texture = from.*entry.texture;
+            }
+        }
+
+        std::string CheraxName(const std::map<std::string, int>& names, int slot) {
+            for (const auto& pair : names) {
+                if (pair.second == slot) return pair.first;
+            }
+            return "";
+        }
+
+        template <typename T>
+        void CopyNamedSlot(const std::map<std::string, T>& from, std::map<std::string, T>& to, const std::string& name) {
+            if (name.empty()) return;
+            auto it = from.find(name);
+            if (it != from.end()) to[name] = it->second;
+            else to.erase(name);
+        }
+
+        void PatchSlots(CheraxOutfit& native, const YimOutfit& patched, const std::vector<OutfitChange>& changes) {
+            const CheraxOutfit target = FormatConverter::YimToCherax(patched);
+            for (const OutfitChange& change : changes) {
+                switch (change.kind) {
+                case OutfitChange::Kind::MODEL:
+                    native.model = target.model;
+                    break;
+                case OutfitChange::Kind::BLEND:
+                    break;
+                case OutfitChange::Kind::COMPONENT:
+                    CopyNamedSlot(target.components, native.components,
+                                  CheraxName(ComponentMapping::CHERAX_COMPONENT_MAP, change.slot));
+                    break;
+                case OutfitChange::Kind::PROP:
+                    CopyNamedSlot(target.props, native.props, CheraxName(ComponentMapping::CHERAX_PROP_MAP, change.slot));
+                    break;
+                }
+            }
+        }
+
+        void PatchSlots(YimOutfit& native, const YimOutfit& patched, const std::vector<OutfitChange>&) {
+            native = patched;
+        }
+
+        void PatchSlots(LexisOutfit& native, const YimOutfit& patched, const std::vector<OutfitChange>& changes) {
+            const LexisOutfit target = FormatConverter::YimToLexis(patched);
+            for (const OutfitChange& change : changes) {
+                const size_t slot = static_cast<size_t>(change.slot);
+                switch (change.kind) {
+                case OutfitChange::Kind::MODEL:
+                    native.model = target.model;
+                    break;
+                case OutfitChange::Kind::BLEND:
+                    break;
+                case OutfitChange::Kind::COMPONENT:
+                    if (slot < native.component.size() && slot < native.component_variation.size()) {
+                        native.component[slot] = target.component[slot];
+                        native.component_variation[slot] = target.component_variation[slot];
+                    }
+                    break;
+                case OutfitChange::Kind::PROP:
+                    if (slot < native.prop.size() && slot < native.prop_variation.size()) {
+                        native.prop[slot] = target.prop[slot];
+                        native.prop_variation[slot] = target.prop_variation[slot];
+                    }
+                    break;
+                }
+            }
+        }
+
+        void PatchSlots(StandOutfit& native, const YimOutfit& patched, const std::vector<OutfitChange>& changes) {
+            const StandOutfit target = FormatConverter::YimToStand(patched);
+            for (const OutfitChange& change : changes) {
+                switch (change.kind) {
+                case OutfitChange::Kind::MODEL:
+                    native.model_name = target.model_name;
+                    break;
+                case OutfitChange::Kind::BLEND:
+                    break;
+                case OutfitChange::Kind::COMPONENT:
+                    CopyStandSlot(STAND_COMPONENTS, change.slot, target, native);
+                    break;
+                case OutfitChange::Kind::PROP:
+                    CopyStandSlot(STAND_PROPS, change.slot, target, native);
+                    break;
+                }
+            }
+        }
+
+        YimOutfit ToCanonical(const CheraxOutfit& native) { return FormatConverter::CheraxToYim(native); }
+        YimOutfit ToCanonical(const YimOutfit& native) { return native; }
+        YimOutfit ToCanonical(const LexisOutfit& native) { return FormatConverter::LexisToYim(native); }
+        YimOutfit ToCanonical(const StandOutfit& native) { return FormatConverter::StandToYim(native); }
+
+        enum class NativePatch { WRITTEN, UNREADABLE, UNREPRESENTABLE };
+
+        // The edited outfit must read back exactly as the patched canonical
+        // outfit; anything else is a change the format cannot hold
+        template <typename Native>
+        NativePatch PatchNative(const std::string& content, bool (*parse)(const std::string&, Native&),
+                                std::string (*serialize)(const Native&), const YimOutfit& patched,
+                                const std::vector<OutfitChange>& changes, std::string& output) {
+            Native native;
+            if (!parse(content, native)) return NativePatch::UNREADABLE;
+            PatchSlots(native, patched, changes);
+            if (DeltaCodec::Distance(ToCanonical(native), patched, 0) != 0) return NativePatch::UNREPRESENTABLE;
+            output = serialize(native);
+            return NativePatch::WRITTEN;
+        }
+
+        NativePatch PatchNative(FormatConverter::FormatType format, const std::string& content, const YimOutfit& patched,
+                                const std::vector<OutfitChange>& changes, std::string& output) {
+            switch (format) {
+            case FormatConverter::FormatType::CHERAX:
+                return PatchNative(content, &FileHandler::ParseCheraxOutfit, &FileHandler::SerializeCheraxOutfit,
+                                   patched, changes, output);
+            case FormatConverter::FormatType::YIM:
+                return PatchNative(content, &FileHandler::ParseYimOutfit, &FileHandler::SerializeYimOutfit,
+                                   patched, changes, output);
+            case FormatConverter::FormatType::LEXIS:
+                return PatchNative(content, &FileHandler::ParseLexisOutfit, &FileHandler::SerializeLexisOutfit,
+                                   patched, changes, output);
+            case FormatConverter::FormatType::STAND:
+                return PatchNative(content, &FileHandler::ParseStandOutfit, &FileHandler::SerializeStandOutfit,
+                                   patched, changes, output);
+            default:
+                // Registered codecs only expose the canonical form
+                return NativePatch::UNREPRESENTABLE;
+            }
+        }
+
+        bool ParseChange(const std::vector<std::string>& fields, OutfitChange& change) {
+            // fields: "", kind, slot, before, after
+            if (fields.size() != 5) return false;
+            const std::string& kind = fields[1];
+            const std::string& before = fields[3];
+            const std::string& after = fields[4];
+            long long value;
+
+            if (kind == "model") {
+                change.kind = OutfitChange::Kind::MODEL;
+                if (!ParseInt(before, value)) return false;
+                change.beforeModel = static_cast<uint32_t>(value);
+                if (!ParseInt(after, value)) return false;
+                change.afterModel = static_cast<uint32_t>(value);
+                return true;
+            }
+            if (kind == "blend") {
+                change.kind = OutfitChange::Kind::BLEND;
+                return ParseBlend(before, change.beforeBlend) && ParseBlend(after, change.afterBlend);
+            }
+
+            if (!ParseInt(fields[2], value)) return false;
+            change.slot = static_cast<int>(value);
+            change.hadBefore = before != "-";
+            change.hasAfter = after != "-";
+            if (!change.hadBefore && !change.hasAfter) return false;
+
+            if (kind == "component") {
+                if (change.slot < 0 || change.slot > 11) return false;
+                change.kind = OutfitChange::Kind::COMPONENT;
+                int b[3] = { 0, 0, 0 }, a[3] = { 0, 0, 0 };
+                if (change.hadBefore && !ParseInts(before, b, 3)) return false;
+                if (change.hasAfter && !ParseInts(after, a, 3)) return false;
+                change.beforeComponent = Component(b[0], b[1], b[2]);
+                change.afterComponent = Component(a[0], a[1], a[2]);
+                change.fields = ChangedFields(b[0], b[1], b[2], a[0], a[1], a[2]);
+                return true;
+            }
+            if (kind == "prop") {
+                if (change.slot < 0 || change.slot > 8) return false;
+                change.kind = OutfitChange::Kind::PROP;
+                int b[2] = { -1, -1 }, a[2] = { -1, -1 };
+                if (change.hadBefore && !ParseInts(before, b, 2)) return false;
+                if (change.hasAfter && !ParseInts(after, a, 2)) return false;
+                change.beforeProp = Prop(b[0], b[1]);
+                change.afterProp = Prop(a[0], a[1]);
+                change.fields = ChangedFields(b[0], b[1], 0, a[0], a[1], 0);
+                return true;
+            }
+            return false;
+        }
+    }
+
+    // ============== OUTFIT DIFF ==============
+    void OutfitDiffer::Diff(const YimOutfit& before, const YimOutfit& after, std::vector<OutfitChange>& changes) {
+        changes.clear();
+        const OutfitDelta delta = DeltaCodec::Encode(before, after);
+
+        if (delta.modelChanged) {
+            OutfitChange change;
+            change.kind = OutfitChange::Kind::MODEL;
+            change.beforeModel = before.model;
+            change.afterModel = after.model;
+            changes.push_back(change);
+        }
+        if (delta.blendChanged) {
+            OutfitChange change;
+            change.kind = OutfitChange::Kind::BLEND;
+            change.beforeBlend = before.blend_data;
+            change.afterBlend = after.blend_data;
+            changes.push_back(change);
+        }
+
+        // Delta lists are slot-ordered; merge changed and removed back into one order
+        auto addComponent = [&](int slot) {
+            OutfitChange change;
+            change.kind = OutfitChange::Kind::COMPONENT;
+            change.slot = slot;
+            auto b = before.components.find(slot);
+            auto a = after.components.find(slot);
+            change.hadBefore = b != before.components.end();
+            change.hasAfter = a != after.components.end();
+            if (change.hadBefore) change.beforeComponent = b->second;
+            if (change.hasAfter) change.afterComponent = a->second;
+            const Component& x = change.beforeComponent;
+            const Component& y = change.afterComponent;
+            change.fields = ChangedFields(x.drawable, x.texture, x.palette, y.drawable, y.texture, y.palette);
+            changes.push_back(change);
+        };
+        auto addProp = [&](int slot) {
+            OutfitChange change;
+            change.kind = OutfitChange::Kind::PROP;
+            change.slot = slot;
+            auto b = before.props.find(slot);
+            auto a = after.props.find(slot);
+            change.hadBefore = b != before.props.end();
+            change.hasAfter = a != after.props.end();
+            if (change.hadBefore) change.beforeProp = b->second;
+            if (change.hasAfter) change.afterProp = a->second;
+            const Prop& x = change.beforeProp;
+            const Prop& y = change.afterProp;
+            change.fields = ChangedFields(x.drawable, x.texture, 0, y.drawable, y.texture, 0);
+            changes.push_back(change);
+        };
+
+        std::vector<int> slots;
+        for (const auto& entry : delta.components) slots.push_back(entry.first);
+        slots.insert(slots.end(), delta.removedComponents.begin(), delta.removedComponents.end());
+        std::sort(slots.begin(), slots.end());
+        for (int slot : slots) addComponent(slot);
+
+        slots.clear();
+        for (const auto& entry : delta.props) slots.push_back(entry.first);
+        slots.insert(slots.end(), delta.removedProps.begin(), delta.removedProps.end());
+        std::sort(slots.begin(), slots.end());
+        for (int slot : slots) addProp(slot);
+    }
+
+    bool OutfitDiffer::Apply(YimOutfit& outfit, const std::vector<OutfitChange>& changes, bool checkBefore) {
+        YimOutfit result = outfit;
+        for (const OutfitChange& change : changes) {
+            switch (change.kind) {
+            case OutfitChange::Kind::MODEL:
+                if (checkBefore && result.model != change.beforeModel) return false;
+                result.model = change.afterModel;
+                break;
+
+            case OutfitChange::Kind::BLEND:
+                if (checkBefore && result.blend_data != change.beforeBlend) return false;
+                result.blend_data = change.afterBlend;
+                break;
+
+            case OutfitChange::Kind::COMPONENT: {
+                auto it = result.components.find(change.slot);
+                if (checkBefore) {
+                    const bool present = it != result.components.end();
+                    if (present != change.hadBefore) return false;
+                    if (present && it->second != change.beforeComponent) return false;
+                }
+                if (change.hasAfter) result.components[change.slot] = change.afterComponent;
+                else if (it != result.components.end()) result.components.erase(it);
+                break;
+            }
+
+            case OutfitChange::Kind::PROP: {
+                auto it = result.props.find(change.slot);
+                if (checkBefore) {
+                    const bool present = it != result.props.end();
+                    if (present != change.hadBefore) return false;
+                    if (present && it->second != change.beforeProp) return false;
+                }
+                if (change.hasAfter) result.props[change.slot] = change.afterProp;
+                else if (it != result.props.end()) result.props.erase(it);
+                break;
+            }
+            }
+        }
+        outfit = result;
+        return true;
+    }
+
+    std::string OutfitDiffer::Describe(const OutfitChange& change) {
+        std::ostringstream out;
+        switch (change.kind) {
+        case OutfitChange::Kind::MODEL:
+            out << "model " << change.beforeModel << " -> " << change.afterModel;
+            return out.str();
+
+        case OutfitChange::Kind::BLEND:
+            out << "blend " << BlendText(change.beforeBlend) << " -> " << BlendText(change.afterBlend);
+            return out.str();
+
+        case OutfitChange::Kind::COMPONENT:
+        case OutfitChange::Kind::PROP:
+            break;
+        }
+
+        const bool component = change.kind == OutfitChange::Kind::COMPONENT;
+        out << (component ? "component " : "prop ") << change.slot;
+        if (!change.hadBefore || !change.hasAfter) {
+            out << (change.hasAfter ? " added " : " removed ")
+                << (component ? ComponentText(true, change.hasAfter ? change.afterComponent : change.beforeComponent)
+                              : PropText(true, change.hasAfter ? change.afterProp : change.beforeProp));
+            return out.str();
+        }
+
+        int before[3], after[3];
+        if (component) {
+            before[0] = change.beforeComponent.drawable; after[0] = change.afterComponent.drawable;
+            before[1] = change.beforeComponent.texture; after[1] = change.afterComponent.texture;
+            before[2] = change.beforeComponent.palette; after[2] = change.afterComponent.palette;
+        } else {
+            before[0] = change.beforeProp.drawable; after[0] = change.afterProp.drawable;
+            before[1] = change.beforeProp.texture; after[1] = change.afterProp.texture;
+            before[2] = after[2] = 0;
+        }
+        const char* names[] = { "drawable", "texture", "palette" };
+        const char* separator = ": ";
+        for (int i = 0; i < 3; i++) {
+            if (change.fields & (1 << i)) {
+                out << separator << names[i] << " " << before[i] << " -> " << after[i];
+                separator = ", ";
+            }
+        }
+        return out.str();
+    }
+
+    // ============== LIBRARY DIFF ==============
+    std::vector<LibraryDiffEntry> LibraryDiff::Run(const std::string& oldDir, const std::string& newDir,
+                                                   unsigned threads) {
+        const std::vector<std::string> oldFiles = BatchConverter::CollectInputFiles(oldDir, newDir);
+        const std::vector<std::string> newFiles = BatchConverter::CollectInputFiles(newDir, oldDir);
+
+        // Union of relative paths, each tagged with which side has it
+        std::vector<std::pair<std::string, int>> paths;
+        for (const std::string& file : oldFiles) paths.emplace_back(file, 1);
+        for (const std::string& file : newFiles) paths.emplace_back(file, 2);
+        std::sort(paths.begin(), paths.end());
+        std::vector<std::pair<std::string, int>> merged;
+        for (const auto& entry : paths) {
+            if (!merged.empty() && merged.back().first == entry.first) merged.back().second |= entry.second;
+            else merged.push_back(entry);
+        }
+
+        std::vector<LibraryDiffEntry> entries(merged.size());
+        std::vector<char> keep(merged.size(), 0);
+
+        ParallelFor(merged.size(), threads, [&](size_t index, unsigned) {
+            LibraryDiffEntry& entry = entries[index];
+            entry.path = merged[index].first;
+            const int sides = merged[index].second;
+
+            if (sides == 1) {
+                const std::string oldPath = (fs::path(oldDir) / entry.path).string();
+                YimOutfit removed;
+                keep[index] = 1;
+                if (!FormatConverter::LoadAsYim(oldPath, FormatConverter::DetectFormat(oldPath), removed)) {
+                    entry.status = LibraryDiffEntry::Status::FAILED;
+                    return;
+                }
+                entry.status = LibraryDiffEntry::Status::REMOVED;
+                entry.removed = OutfitFingerprint::Compute(removed);
+                return;
+            }
+
+            const std::string newPath = (fs::path(newDir) / entry.path).string();
+            entry.format = FormatConverter::DetectFormat(newPath);
+            YimOutfit before, after;
+            if (!FormatConverter::LoadAsYim(newPath, entry.format, after)) {
+                entry.status = LibraryDiffEntry::Status::FAILED;
+                keep[index] = 1;
+                return;
+            }
+
+            if (sides == 2) {
+                entry.status = LibraryDiffEntry::Status::ADDED;
+            } else {
+                const std::string oldPath = (fs::path(oldDir) / entry.path).string();
+                if (!FormatConverter::LoadAsYim(oldPath, FormatConverter::DetectFormat(oldPath), before)) {
+                    entry.status = LibraryDiffEntry::Status::FAILED;
+                    keep[index] = 1;
+                    return;
+                }
+                entry.status = LibraryDiffEntry::Status::CHANGED;
+            }
+
+            OutfitDiffer::Diff(before, after, entry.changes);
+            keep[index] = entry.status == LibraryDiffEntry::Status::ADDED || !entry.changes.empty();
+        });
+
+        std::vector<LibraryDiffEntry> result;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (keep[i]) result.push_back(std::move(entries[i]));
+        }
+        return result;
+    }
+
+    // ============== PATCH FORMAT ==============
+    std::string LibraryDiff::FormatPatch(const std::vector<LibraryDiffEntry>& entries) {
+        std::string out = PATCH_HEADER;
+        out += "\n";
+
+        for (const LibraryDiffEntry& entry : entries) {
+            switch (entry.status) {
+            case LibraryDiffEntry::Status::FAILED:
+                out += "# failed\t" + entry.path + "\n";
+                continue;
+            case LibraryDiffEntry::Status::REMOVED:
+                out += "- " + entry.path + "\t" + entry.removed.ToHex() + "\n";
+                continue;
+            case LibraryDiffEntry::Status::ADDED:
+                out += "+ " + entry.path + "\t" + FormatConverter::FormatTypeToName(entry.format) + "\n";
+                break;
+            case LibraryDiffEntry::Status::CHANGED:
+                out += "= " + entry.path + "\n";
+                break;
+            }
+
+            for (const OutfitChange& change : entry.changes) {
+                switch (change.kind) {
+                case OutfitChange::Kind::MODEL:
+                    out += "\tmodel\t-\t" + std::to_string(change.beforeModel) + "\t" +
+                           std::to_string(change.afterModel) + "\n";
+                    break;
+                case OutfitChange::Kind::BLEND:
+                    out += "\tblend\t-\t" + BlendText(change.beforeBlend) + "\t" +
+                           BlendText(change.afterBlend) + "\n";
+                    break;
+                case OutfitChange::Kind::COMPONENT:
+                    out += "\tcomponent\t" + std::to_string(change.slot) + "\t" +
+                           ComponentText(change.hadBefore, change.beforeComponent) + "\t" +
+                           ComponentText(change.hasAfter, change.afterComponent) + "\n";
+                    break;
+                case OutfitChange::Kind::PROP:
+                    out += "\tprop\t" + std::to_string(change.slot) + "\t" +
+                           PropText(change.hadBefore, change.beforeProp) + "\t" +
+                           PropText(change.hasAfter, change.afterProp) + "\n";
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    bool LibraryDiff::ParsePatch(const std::string& text, std::vector<LibraryDiffEntry>& entries) {
+        entries.clear();
+        std::istringstream in(text);
+        std::string line;
+
+        if (!std::getline(in, line)) return false;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line != PATCH_HEADER) return false;
+
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+
+            if (line[0] == '\t') {
+                // Change lines belong to the preceding added/changed outfit
+                if (entries.empty() || entries.back().status == LibraryDiffEntry::Status::REMOVED) return false;
+                OutfitChange change;
+                if (!ParseChange(Split(line, '\t'), change)) return false;
+                entries.back().changes.push_back(change);
+                continue;
+            }
+
+            if (line.size() < 3 || line[1] != ' ') return false;
+            LibraryDiffEntry entry;
+            entry.path = line.substr(2);
+            switch (line[0]) {
+            case '=':
+                entry.status = LibraryDiffEntry::Status::CHANGED;
+                break;
+            case '-': {
+                entry.status = LibraryDiffEntry::Status::REMOVED;
+                size_t tab = entry.path.find('\t');
+                if (tab == std::string::npos || !Fingerprint::FromHex(entry.path.substr(tab + 1), entry.removed)) {
+                    return false;
+                }
+                entry.path.resize(tab);
+                break;
+            }
+            case '+': {
+                entry.status = LibraryDiffEntry::Status::ADDED;
+                size_t tab = entry.path.find('\t');
+                if (tab == std::string::npos) return false;
+                entry.format = FormatConverter::FormatTypeFromName(entry.path.substr(tab + 1));
+                entry.path.resize(tab);
+                if (entry.format == FormatConverter::FormatType::UNKNOWN) return false;
+                break;
+            }
+            default:
+                return false;
+            }
+            if (entry.path.empty()) return false;
+            entries.push_back(entry);
+        }
+        return true;
+    }
+
+    // ============== PATCH APPLY ==============
+    PatchResult LibraryDiff::ApplyPatch(const std::vector<LibraryDiffEntry>& entries,
+                                        const std::string& libraryDir, bool force, unsigned threads) {
+        PatchResult result;
+        std::mutex resultMutex;
+
+        enum class Outcome { APPLIED, CONFLICT, FAILED };
+        auto report = [&](Outcome outcome, const std::string& path, const char* reason) {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            switch (outcome) {
+            case Outcome::APPLIED: result.applied++; return;
+            case Outcome::CONFLICT: result.conflicts++; break;
+            case Outcome::FAILED: result.failed++; break;
+            }
+            result.problems.push_back(path + ": " + reason);
+        };
+
+        ParallelFor(entries.size(), threads, [&](size_t index, unsigned) {
+            const LibraryDiffEntry& entry = entries[index];
+
+            // Paths come from a patch file; never let one escape the library
+            const fs::path relative(entry.path);
+            if (relative.is_absolute() || entry.path.find("..") != std::string::npos) {
+                report(Outcome::FAILED, entry.path, "path outside library");
+                return;
+            }
+            const std::string path = (fs::path(libraryDir) / relative).string();
+            std::error_code ec;
+
+            switch (entry.status) {
+            case LibraryDiffEntry::Status::FAILED:
+                return;
+
+            case LibraryDiffEntry::Status::REMOVED: {
+                if (!fs::exists(path, ec)) {
+                    report(Outcome::APPLIED, entry.path, "");
+                    return;
+                }
+                if (!force) {
+                    // Only delete the outfit the diff saw, not whatever took its path since
+                    YimOutfit existing;
+                    if (!FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), existing) ||
+                        OutfitFingerprint::Compute(existing) != entry.removed) {
+                        report(Outcome::CONFLICT, entry.path, "target differs from removed outfit");
+                        return;
+                    }
+                }
+                if (!fs::remove(path, ec)) {
+                    report(Outcome::FAILED, entry.path, "could not remove");
+                } else {
+                    report(Outcome::APPLIED, entry.path, "");
+                }
+                return;
+            }
+
+            case LibraryDiffEntry::Status::ADDED: {
+                YimOutfit outfit;
+                OutfitDiffer::Apply(outfit, entry.changes, false);
+                if (!force && fs::exists(path, ec)) {
+                    // Already added by an earlier run is fine; anything else is a clash
+                    YimOutfit existing;
+                    if (FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), existing) &&
+                        DeltaCodec::Distance(existing, outfit, 0) == 0) {
+                        report(Outcome::APPLIED, entry.path, "");
+                    } else {
+                        report(Outcome::CONFLICT, entry.path, "already exists");
+                    }
+                    return;
+                }
+                fs::create_directories(fs::path(path).parent_path(), ec);
+                const bool written = FileHandler::WriteFileContent(
+                    path, FormatConverter::SerializeFromYim(outfit, entry.format));
+                report(written ? Outcome::APPLIED : Outcome::FAILED, entry.path, "write failed");
+                return;
+            }
+
+            case LibraryDiffEntry::Status::CHANGED: {
+                // Written back in whatever format the target is in now
+                const std::string content = FileHandler::ReadFileContent(path);
+                const FormatConverter::FormatType format = FormatConverter::DetectFormatFromContent(content);
+                YimOutfit current;
+                if (!FormatConverter::ParseAsYim(content, format, current)) {
+                    report(Outcome::FAILED, entry.path, "could not load");
+                    return;
+                }
+
+                YimOutfit patched = current;
+                if (!OutfitDiffer::Apply(patched, entry.changes, !force)) {
+                    // Already carrying the patched values counts as applied
+                    YimOutfit target = current;
+                    OutfitDiffer::Apply(target, entry.changes, false);
+                    if (DeltaCodec::Distance(current, target, 0) == 0) {
+                        report(Outcome::APPLIED, entry.path, "");
+                    } else {
+                        report(Outcome::CONFLICT, entry.path, "target differs from patch base");
+                    }
+                    return;
+                }
+                if (DeltaCodec::Distance(current, patched, 0) == 0) {
+                    report(Outcome::APPLIED, entry.path, "");
+                    return;
+                }
+                std::string output;
+                switch (PatchNative(format, content, patched, entry.changes, output)) {
+                case NativePatch::UNREADABLE:
+                    report(Outcome::FAILED, entry.path, "could not load");
+                    return;
+                case NativePatch::UNREPRESENTABLE:
+                    report(Outcome::FAILED, entry.path, "change not representable in its format");
+                    return;
+                case NativePatch::WRITTEN:
+                    break;
+                }
+                const bool written = FileHandler::WriteFileContent(path, output);
+                report(written ? Outcome::APPLIED : Outcome::FAILED, entry.path, "write failed");
+                return;
+            }
+            }
+        });
+
+        std::sort(result.problems.begin(), result.problems.end());
+        return result;
+    }
+
+} // namespace OutfitConverter
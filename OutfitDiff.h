@@ -0,0 +1,96 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "FormatConverter.h"
+#include "OutfitFingerprint.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== OUTFIT CHANGE ==============
+    // One difference between two canonical outfits, with both sides kept so
+    // a patch can detect that its target moved on since the diff was taken.
+    struct OutfitChange {
+        enum class Kind { MODEL, BLEND, COMPONENT, PROP };
+
+        // Component/prop fields that differ, for display
+        static const uint8_t FIELD_DRAWABLE = 1;
+        static const uint8_t FIELD_TEXTURE = 2;
+        static const uint8_t FIELD_PALETTE = 4;
+
+        Kind kind;
+        int slot;                   // COMPONENT/PROP only
+        bool hadBefore;             // Slot present in the old outfit
+        bool hasAfter;              // Slot present in the new outfit
+        uint8_t fields;
+        Component beforeComponent, afterComponent;
+        Prop beforeProp, afterProp;
+        uint32_t beforeModel, afterModel;
+        BlendData beforeBlend, afterBlend;
+
+        OutfitChange() : kind(Kind::MODEL), slot(0), hadBefore(true), hasAfter(true), fields(0),
+            beforeModel(0), afterModel(0) {}
+    };
+
+    class OutfitDiffer {
+    public:
+        // Bounded by the slot count (12 components + 9 props), so constant per pair
+        static void Diff(const YimOutfit& before, const YimOutfit& after, std::vector<OutfitChange>& changes);
+
+        // checkBefore: refuse (and leave outfit untouched) if any "before"
+        // side no longer matches the outfit
+        static bool Apply(YimOutfit& outfit, const std::vector<OutfitChange>& changes, bool checkBefore);
+
+        static std::string Describe(const OutfitChange& change);
+    };
+
+    // ============== LIBRARY DIFF ==============
+    struct LibraryDiffEntry {
+        enum class Status { ADDED, REMOVED, CHANGED, FAILED };
+
+        std::string path;       // Relative to both library roots
+        Status status;
+        FormatConverter::FormatType format;     // Format of the new side (ADDED/CHANGED)
+        std::vector<OutfitChange> changes;
+        Fingerprint removed;    // REMOVED: the old outfit, so a patch only deletes what was diffed
+
+        LibraryDiffEntry() : status(Status::CHANGED), format(FormatConverter::FormatType::UNKNOWN) {}
+    };
+
+    struct PatchResult {
+        size_t applied;
+        size_t conflicts;
+        size_t failed;
+        std::vector<std::string> problems;
+
+        PatchResult() : applied(0), conflicts(0), failed(0) {}
+    };
+
+    class LibraryDiff {
+    public:
+        // Pairs files by relative path and diffs every pair in parallel;
+        // identical outfits are left out of the result
+        static std::vector<LibraryDiffEntry> Run(const std::string& oldDir, const std::string& newDir,
+                                                 unsigned threads = 0);
+
+        // Tab-separated text patch:
+        //   = path \t Format      changed outfit, followed by its change lines
+        //   + path \t Format      added outfit (changes from a default outfit)
+        //   - path \t fingerprint removed outfit
+        //   \t kind \t slot \t before \t after
+        static std::string FormatPatch(const std::vector<LibraryDiffEntry>& entries);
+        static bool ParsePatch(const std::string& text, std::vector<LibraryDiffEntry>& entries);
+
+        // Applies a patch to the library under libraryDir in parallel. Without
+        // force, entries whose target no longer matches the "before" side
+        // (for removals, the removed outfit's fingerprint) are reported as
+        // conflicts and left alone. Changed outfits are edited in their own
+        // format, touching only the patched slots; a change the format cannot
+        // hold (e.g. blend data in a Stand file) fails instead.
+        static PatchResult ApplyPatch(const std::vector<LibraryDiffEntry>& entries,
+                                      const std::string& libraryDir, bool force, unsigned threads = 0);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,300 @@
+#include "OutfitExport.h"
+#include "OutfitFilter.h"
+#include "OutfitTable.h"
+#include "OutfitView.h"
+#include "WardrobeContainer.h"
+#include "BatchConverter.h"
+#include "FileHandler.h"
+#include "Parallel.h"
+#include "ByteOrder.h"
+#include <filesystem>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        // Header
+        const size_t H_MAGIC = 0;
+        const size_t H_VERSION = 4;
+        const size_t H_HEADER_SIZE = 6;
+        const size_t H_COLUMNS = 8;
+        const size_t H_GROUP_ROWS = 12;
+        const size_t H_ROWS = 16;
+        const size_t H_GROUPS = 24;
+        const size_t H_SCHEMA_SIZE = 28;
+
+        const char* const BLEND_FIELDS[10] = {
+            "is_parent", "shape_first_id", "shape_mix", "shape_second_id", "shape_third_id",
+            "skin_first_id", "skin_mix", "skin_second_id", "skin_third_id", "third_mix"
+        };
+
+        // CSV field, quoted only when it has to be
+        void AppendCsvText(std::string& line, const std::string& text) {
+            if (text.find_first_of(",\"\r\n") == std::string::npos) {
+                line += text;
+                return;
+            }
+            line += '"';
+            for (char c : text) {
+                if (c == '"') line += '"';
+                line += c;
+            }
+            line += '"';
+        }
+
+        template <typename T>
+        void AppendNumber(std::string& line, T value) {
+            char buffer[32];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            line.append(buffer, result.ptr);
+        }
+
+        size_t Padding(size_t size) {
+            return (8 - size % 8) % 8;
+        }
+    }
+
+    // ============== TABLE WRITER ==============
+    const char TableWriter::MAGIC[4] = { 'O', 'C', 'F', '1' };
+
+    const std::vector<TableWriter::Column>& TableWriter::GetColumns() {
+        // Numeric columns in OutfitFilter field order, then the name
+        static const std::vector<Column> columns = [] {
+            std::vector<Column> list;
+            list.push_back({ "model", UINT32 });
+            for (size_t field = OutfitFilter::FIELD_COMPONENTS; field < OutfitFilter::FIELD_BLEND; field++) {
+                list.push_back({ OutfitTable::ColumnName(field), INT32 });
+            }
+            for (int i = 0; i < 10; i++) {
+                const bool mix = i == 2 || i == 6 || i == 9;
+                list.push_back({ std::string("blend.") + BLEND_FIELDS[i], mix ? FLOAT32 : INT32 });
+            }
+            list.push_back({ "name", STRING });
+            return list;
+        }();
+        return columns;
+    }
+
+    TableWriter::TableWriter()
+        : file(nullptr), format(TableFormat::CSV), groupRows(DEFAULT_GROUP_ROWS), count(0),
+          groupCount(0), schemaSize(0), failed(false), pendingRows(0) {}
+
+    TableWriter::~TableWriter() {
+        if (file) {
+            FileHandler::CommitAtomicWrite(file, tempPath, targetPath, false);
+        }
+    }
+
+    bool TableWriter::Write(const void* data, size_t size) {
+        if (!failed && size > 0) failed = std::fwrite(data, 1, size, file) != size;
+        return !failed;
+    }
+
+    bool TableWriter::Open(const std::string& filepath, TableFormat tableFormat, uint32_t rowsPerGroup) {
+        if (file) return false;
+
+        targetPath = filepath;
+        format = tableFormat;
+        groupRows = std::max<uint32_t>(rowsPerGroup, 1);
+        count = 0;
+        groupCount = 0;
+        failed = false;
+        pendingRows = 0;
+
+        file = FileHandler::BeginAtomicWrite(targetPath, tempPath);
+        if (!file) return false;
+
+        const std::vector<Column>& columns = GetColumns();
+        if (format == TableFormat::CSV) {
+            // Name first, then the numeric columns
+            line.clear();
+            AppendCsvText(line, columns.back().name);
+            for (size_t i = 0; i + 1 < columns.size(); i++) {
+                line += ',';
+                AppendCsvText(line, columns[i].name);
+            }
+            line += '\n';
+            return Write(line.data(), line.size());
+        }
+
+        // Placeholder header; the counts are filled in on Close
+        std::string schema;
+        for (const auto& column : columns) {
+            schema += static_cast<char>(column.type);
+            schema += static_cast<char>(column.name.size());
+            schema += column.name;
+        }
+        schema.append(Padding(schema.size()), '\0');
+        schemaSize = static_cast<uint32_t>(schema.size());
+
+        uint8_t header[HEADER_SIZE] = {};
+        Write(header, sizeof(header));
+        Write(schema.data(), schema.size());
+
+        columnData.assign(columns.size() - 1, std::vector<uint8_t>());
+        for (auto& data : columnData) data.reserve(static_cast<size_t>(groupRows) * 4);
+        nameOffsets.clear();
+        nameBytes.clear();
+        return !failed;
+    }
+
+    bool TableWriter::Add(const YimOutfit& outfit, const std::string& name) {
+        if (!file || failed) return false;
+
+        double fields[OutfitFilter::FIELD_COUNT];
+        OutfitFilter::Flatten(outfit, fields);
+        const std::vector<Column>& columns = GetColumns();
+
+        if (format == TableFormat::CSV) {
+            line.clear();
+            AppendCsvText(line, name);
+            for (size_t i = 0; i < OutfitFilter::FIELD_COUNT; i++) {
+                line += ',';
+                switch (columns[i].type) {
+                case UINT32: AppendNumber(line, static_cast<uint32_t>(fields[i])); break;
+                case FLOAT32: AppendNumber(line, static_cast<float>(fields[i])); break;
+                default: AppendNumber(line, static_cast<int32_t>(fields[i])); break;
+                }
+            }
+            line += '\n';
+            if (!Write(line.data(), line.size())) return false;
+            count++;
+            return true;
+        }
+
+        for (size_t i = 0; i < OutfitFilter::FIELD_COUNT; i++) {
+            uint8_t bytes[4];
+            switch (columns[i].type) {
+            case UINT32: PutU32(bytes, static_cast<uint32_t>(fields[i])); break;
+            case FLOAT32: PutF32(bytes, static_cast<float>(fields[i])); break;
+            default: PutI32(bytes, static_cast<int32_t>(fields[i])); break;
+            }
+            columnData[i].insert(columnData[i].end(), bytes, bytes + 4);
+        }
+        nameBytes += name;
+        nameOffsets.push_back(static_cast<uint32_t>(nameBytes.size()));
+        count++;
+        return ++pendingRows < groupRows || FlushGroup();
+    }
+
+    bool TableWriter::FlushGroup() {
+        if (pendingRows == 0) return !failed;
+
+        uint8_t groupHeader[8] = {};
+        PutU32(groupHeader, pendingRows);
+        Write(groupHeader, sizeof(groupHeader));
+        for (auto& data : columnData) {
+            Write(data.data(), data.size());
+            data.clear();
+        }
+
+        std::vector<uint8_t> offsets(nameOffsets.size() * 4);
+        for (size_t i = 0; i < nameOffsets.size(); i++) PutU32(offsets.data() + i * 4, nameOffsets[i]);
+        Write(offsets.data(), offsets.size());
+        Write(nameBytes.data(), nameBytes.size());
+
+        static const uint8_t ZEROS[8] = {};
+        Write(ZEROS, Padding(offsets.size() + nameBytes.size()));
+
+        nameOffsets.clear();
+        nameBytes.clear();
+        pendingRows = 0;
+        groupCount++;
+        return !failed;
+    }
+
+    bool TableWriter::Close() {
+        if (!file) return false;
+
+        if (format == TableFormat::COLUMNAR) {
+            FlushGroup();
+
+            uint8_t header[HEADER_SIZE] = {};
+            std::memcpy(header + H_MAGIC, MAGIC, sizeof(MAGIC));
+            PutU16(header + H_VERSION, VERSION);
+            PutU16(header + H_HEADER_SIZE, static_cast<uint16_t>(HEADER_SIZE));
+            PutU32(header + H_COLUMNS, static_cast<uint32_t>(GetColumns().size()));
+            PutU32(header + H_GROUP_ROWS, groupRows);
+            PutU64(header + H_ROWS, count);
+            PutU32(header + H_GROUPS, groupCount);
+            PutU32(header + H_SCHEMA_SIZE, schemaSize);
+
+            if (!failed) {
+                failed = std::fseek(file, 0, SEEK_SET) != 0 ||
+                         std::fwrite(header, 1, sizeof(header), file) != sizeof(header);
+            }
+        }
+
+        const bool success = FileHandler::CommitAtomicWrite(file, tempPath, targetPath, !failed);
+        file = nullptr;
+        return success;
+    }
+
+    // ============== TABLE EXPORT ==============
+    TableExportResult TableExport::Run(const std::string& inputPath, const std::string& outputPath,
+                                       TableFormat format, unsigned threads) {
+        TableExportResult result;
+
+        std::vector<std::string> files;
+        WardrobeFile wardrobe;
+        std::error_code ec;
+        const bool directory = fs::is_directory(inputPath, ec);
+        if (directory) {
+            files = BatchConverter::CollectInputFiles(inputPath);
+        } else if (!wardrobe.Open(inputPath)) {
+            result.failed++;
+            result.failedItems.push_back(inputPath);
+            return result;
+        }
+
+        TableWriter writer;
+        if (!writer.Open(outputPath, format)) {
+            result.failed++;
+            result.failedItems.push_back(outputPath);
+            return result;
+        }
+
+        // Parse in parallel a chunk at a time, write in library order
+        const size_t total = directory ? files.size() : wardrobe.GetCount();
+        const size_t CHUNK = 4096;
+        std::vector<YimOutfit> outfits;
+        std::vector<char> loaded;
+        for (size_t base = 0; base < total; base += CHUNK) {
+            const size_t chunk = std::min(CHUNK, total - base);
+            outfits.assign(chunk, YimOutfit());
+            loaded.assign(chunk, 0);
+
+            ParallelFor(chunk, threads, [&](size_t index, unsigned) {
+                if (!directory) {
+                    loaded[index] = wardrobe.Get(base + index, outfits[index]) ? 1 : 0;
+                    return;
+                }
+                OutfitView view;
+                loaded[index] = view.Open((fs::path(inputPath) / files[base + index]).string()) &&
+                                view.ToYim(outfits[index]) ? 1 : 0;
+            });
+
+            for (size_t i = 0; i < chunk; i++) {
+                const std::string name = directory ? files[base + i] : wardrobe.GetName(base + i);
+                if (loaded[i] && writer.Add(outfits[i], name)) {
+                    result.outfits++;
+                } else {
+                    result.failed++;
+                    result.failedItems.push_back(name.empty() ? "#" + std::to_string(base + i) : name);
+                }
+            }
+        }
+
+        if (!writer.Close()) {
+            result.failed++;
+            result.failedItems.push_back(outputPath);
+        }
+        return result;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,99 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    enum class TableFormat {
+        CSV,        // One header line, then one line per outfit
+        COLUMNAR    // Row groups of little-endian column arrays, see TableWriter
+    };
+
+    // ============== TABLE WRITER ==============
+    // Streams outfits to a flat table with one column per field: model,
+    // every component and prop field (OutfitFilter field order), the blend
+    // values, and the outfit name. Memory stays bounded by one row group.
+    //
+    // Columnar layout (all integers little-endian):
+    //
+    //   Header  (HEADER_SIZE bytes) magic "OCF1", u16 version, u16 header
+    //           size, u32 columns, u32 rows per group, u64 rows, u32 groups,
+    //           u32 schema size
+    //   Schema  per column: u8 type, u8 name length, name; zero padded to 8
+    //   Groups  u32 rows, u32 reserved, then each column's values for those
+    //           rows: 4 bytes each for numeric types; for strings, u32 end
+    //           offsets (one per row) followed by the bytes. Groups are zero
+    //           padded to 8. The string column comes last, so numeric
+    //           columns stay 4-byte aligned.
+    //
+    // Output is committed through FileHandler's temp-file-and-rename path.
+    class TableWriter {
+    public:
+        enum ColumnType : uint8_t { INT32 = 0, UINT32 = 1, FLOAT32 = 2, STRING = 3 };
+
+        static const char MAGIC[4];
+        static const uint16_t VERSION = 1;
+        static const uint32_t HEADER_SIZE = 32;
+        static const uint32_t DEFAULT_GROUP_ROWS = 16384;
+
+        struct Column {
+            std::string name;
+            ColumnType type;
+        };
+        static const std::vector<Column>& GetColumns();
+
+        TableWriter();
+        ~TableWriter();
+
+        TableWriter(const TableWriter&) = delete;
+        TableWriter& operator=(const TableWriter&) = delete;
+
+        bool Open(const std::string& filepath, TableFormat format, uint32_t groupRows = DEFAULT_GROUP_ROWS);
+        bool Add(const YimOutfit& outfit, const std::string& name = "");
+        bool Close();
+
+        uint64_t GetCount() const { return count; }
+
+    private:
+        std::FILE* file;
+        std::string tempPath;
+        std::string targetPath;
+        TableFormat format;
+        uint32_t groupRows;
+        uint64_t count;
+        uint32_t groupCount;
+        uint32_t schemaSize;
+        bool failed;
+
+        // Current row group (columnar only)
+        uint32_t pendingRows;
+        std::vector<std::vector<uint8_t>> columnData;
+        std::vector<uint32_t> nameOffsets;
+        std::string nameBytes;
+        std::string line;
+
+        bool Write(const void* data, size_t size);
+        bool FlushGroup();
+    };
+
+    struct TableExportResult {
+        size_t outfits;
+        size_t failed;
+        std::vector<std::string> failedItems;
+
+        TableExportResult() : outfits(0), failed(0) {}
+    };
+
+    class TableExport {
+    public:
+        // Exports a library directory (any format) or .owb wardrobe in
+        // library order, parsing a chunk at a time in parallel
+        static TableExportResult Run(const std::string& inputPath, const std::string& outputPath,
+                                     TableFormat format, unsigned threads = 0);
+    };
+
+} // namespace OutfitConverter
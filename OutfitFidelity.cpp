@@ -0,0 +1,241 @@
+#include "OutfitFidelity.h"
+#include "OutfitView.h"
+#include "WardrobeContainer.h"
+#include "BatchConverter.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        typedef FormatConverter::FormatType FormatType;
+
+        const int FORMATS = 4;
+        const size_t BLOCK = 256;
+
+        template <typename T> FormatType TypeOf();
+        template <> FormatType TypeOf<CheraxOutfit>() { return FormatType::CHERAX; }
+        template <> FormatType TypeOf<YimOutfit>() { return FormatType::YIM; }
+        template <> FormatType TypeOf<LexisOutfit>() { return FormatType::LEXIS; }
+        template <> FormatType TypeOf<StandOutfit>() { return FormatType::STAND; }
+
+        // The twelve FormatConverter functions, plus the Yim identity used to
+        // bring the corpus into Yim and read Yim results back
+        void Convert(const YimOutfit& from, YimOutfit& to) { to = from; }
+        void Convert(const YimOutfit& from, CheraxOutfit& to) { to = FormatConverter::YimToCherax(from); }
+        void Convert(const YimOutfit& from, LexisOutfit& to) { to = FormatConverter::YimToLexis(from); }
+        void Convert(const YimOutfit& from, StandOutfit& to) { to = FormatConverter::YimToStand(from); }
+        void Convert(const CheraxOutfit& from, YimOutfit& to) { to = FormatConverter::CheraxToYim(from); }
+        void Convert(const CheraxOutfit& from, LexisOutfit& to) { to = FormatConverter::CheraxToLexis(from); }
+        void Convert(const CheraxOutfit& from, StandOutfit& to) { to = FormatConverter::CheraxToStand(from); }
+        void Convert(const LexisOutfit& from, YimOutfit& to) { to = FormatConverter::LexisToYim(from); }
+        void Convert(const LexisOutfit& from, CheraxOutfit& to) { to = FormatConverter::LexisToCherax(from); }
+        void Convert(const LexisOutfit& from, StandOutfit& to) { to = FormatConverter::LexisToStand(from); }
+        void Convert(const StandOutfit& from, YimOutfit& to) { to = FormatConverter::StandToYim(from); }
+        void Convert(const StandOutfit& from, CheraxOutfit& to) { to = FormatConverter::StandToCherax(from); }
+        void Convert(const StandOutfit& from, LexisOutfit& to) { to = FormatConverter::StandToLexis(from); }
+
+        struct WorkerStats {
+            uint64_t forward;
+            uint64_t back;
+            size_t lossy;
+            size_t slotLoss[FidelityPath::SLOTS];
+
+            WorkerStats() : forward(0), back(0), lossy(0) {
+                for (size_t& count : slotLoss) count = 0;
+            }
+        };
+
+        uint64_t Nanoseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        // A -> B -> A over the corpus, a block of outfits per task. Each
+        // direction is timed over a whole block, not per call.
+        template <typename A, typename B>
+        void RunPath(const std::vector<YimOutfit>& outfits, unsigned threads, unsigned repeat,
+                     FidelityPath& path, ConverterTiming timings[FORMATS][FORMATS]) {
+            const size_t blocks = (outfits.size() + BLOCK - 1) / BLOCK;
+            std::vector<WorkerStats> stats(ResolveThreadCount(threads, blocks));
+
+            ParallelFor(blocks, threads, [&](size_t block, unsigned worker) {
+                const size_t begin = block * BLOCK;
+                const size_t count = std::min(BLOCK, outfits.size() - begin);
+                std::vector<A> source(count), result(count);
+                std::vector<B> middle(count);
+                for (size_t i = 0; i < count; i++) Convert(outfits[begin + i], source[i]);
+
+                WorkerStats& local = stats[worker];
+                for (unsigned pass = 0; pass < repeat; pass++) {
+                    const auto start = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < count; i++) Convert(source[i], middle[i]);
+                    const auto half = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < count; i++) Convert(middle[i], result[i]);
+                    const auto end = std::chrono::steady_clock::now();
+                    local.forward += Nanoseconds(start, half);
+                    local.back += Nanoseconds(half, end);
+                }
+
+                // Compare in canonical form, both sides read back through A
+                YimOutfit before, after;
+                for (size_t i = 0; i < count; i++) {
+                    Convert(source[i], before);
+                    Convert(result[i], after);
+                    const uint32_t lost = FidelityMatrix::CompareSlots(before, after);
+                    local.lossy += lost != 0;
+                    for (int slot = 0; slot < FidelityPath::SLOTS; slot++) local.slotLoss[slot] += (lost >> slot) & 1;
+                }
+            });
+
+            const int a = static_cast<int>(TypeOf<A>());
+            const int b = static_cast<int>(TypeOf<B>());
+            path.from = TypeOf<A>();
+            path.via = TypeOf<B>();
+            path.outfits = outfits.size();
+            for (const auto& local : stats) {
+                path.lossy += local.lossy;
+                for (int slot = 0; slot < FidelityPath::SLOTS; slot++) path.slotLoss[slot] += local.slotLoss[slot];
+                timings[a][b].nanoseconds += local.forward;
+                timings[b][a].nanoseconds += local.back;
+            }
+            timings[a][b].calls += outfits.size() * repeat;
+            timings[b][a].calls += outfits.size() * repeat;
+        }
+
+        template <typename A, typename B>
+        void RunPathIfDistinct(const std::vector<YimOutfit>& outfits, unsigned threads, unsigned repeat,
+                               FidelityResult& result, ConverterTiming timings[FORMATS][FORMATS]) {
+            if constexpr (!std::is_same<A, B>::value) {
+                FidelityPath path;
+                RunPath<A, B>(outfits, threads, repeat, path, timings);
+                result.paths.push_back(path);
+            }
+        }
+
+        template <typename A>
+        void RunFrom(const std::vector<YimOutfit>& outfits, unsigned threads, unsigned repeat,
+                     FidelityResult& result, ConverterTiming timings[FORMATS][FORMATS]) {
+            RunPathIfDistinct<A, CheraxOutfit>(outfits, threads, repeat, result, timings);
+            RunPathIfDistinct<A, YimOutfit>(outfits, threads, repeat, result, timings);
+            RunPathIfDistinct<A, LexisOutfit>(outfits, threads, repeat, result, timings);
+            RunPathIfDistinct<A, StandOutfit>(outfits, threads, repeat, result, timings);
+        }
+    }
+
+    // ============== FIDELITY MATRIX ==============
+    std::string FidelityMatrix::SlotName(int slot) {
+        if (slot == FidelityPath::SLOT_MODEL) return "model";
+        if (slot == FidelityPath::SLOT_BLEND) return "blend";
+        const bool component = slot < 12;
+        const int index = component ? slot : slot - 12;
+        std::string name = (component ? "component" : "prop") + std::to_string(index);
+        for (const auto& pair : component ? ComponentMapping::CHERAX_COMPONENT_MAP : ComponentMapping::CHERAX_PROP_MAP) {
+            if (pair.second == index) name = pair.first;
+        }
+        return name;
+    }
+
+    uint32_t FidelityMatrix::CompareSlots(const YimOutfit& before, const YimOutfit& after) {
+        uint32_t lost = 0;
+        for (int slot = 0; slot < 12; slot++) {
+            const auto a = before.components.find(slot);
+            const auto b = after.components.find(slot);
+            const Component x = a != before.components.end() ? a->second : Component();
+            const Component y = b != after.components.end() ? b->second : Component();
+            if (x != y) lost |= 1u << slot;
+        }
+        for (int slot = 0; slot < 9; slot++) {
+            const auto a = before.props.find(slot);
+            const auto b = after.props.find(slot);
+            const Prop x = a != before.props.end() ? a->second : Prop();
+            const Prop y = b != after.props.end() ? b->second : Prop();
+            if (x != y) lost |= 1u << (12 + slot);
+        }
+        if (before.model != after.model) lost |= 1u << FidelityPath::SLOT_MODEL;
+        if (before.blend_data != after.blend_data) lost |= 1u << FidelityPath::SLOT_BLEND;
+        return lost;
+    }
+
+    FidelityResult FidelityMatrix::Run(const std::vector<YimOutfit>& outfits, unsigned threads, unsigned repeat) {
+        FidelityResult result;
+        result.outfits = outfits.size();
+        repeat = std::max(repeat, 1u);
+
+        ConverterTiming timings[FORMATS][FORMATS];
+        RunFrom<CheraxOutfit>(outfits, threads, repeat, result, timings);
+        RunFrom<YimOutfit>(outfits, threads, repeat, result, timings);
+        RunFrom<LexisOutfit>(outfits, threads, repeat, result, timings);
+        RunFrom<StandOutfit>(outfits, threads, repeat, result, timings);
+
+        for (int from = 0; from < FORMATS; from++) {
+            for (int to = 0; to < FORMATS; to++) {
+                if (from == to) continue;
+                timings[from][to].from = static_cast<FormatType>(from);
+                timings[from][to].to = static_cast<FormatType>(to);
+                result.converters.push_back(timings[from][to]);
+            }
+        }
+        return result;
+    }
+
+    FidelityResult FidelityMatrix::Run(const std::string& inputPath, unsigned threads, unsigned repeat) {
+        std::vector<YimOutfit> corpus;
+        std::vector<std::string> failedItems;
+
+        std::vector<std::string> files;
+        WardrobeFile wardrobe;
+        std::error_code ec;
+        const bool directory = fs::is_directory(inputPath, ec);
+        if (directory) {
+            files = BatchConverter::CollectInputFiles(inputPath);
+        } else if (!wardrobe.Open(inputPath)) {
+            FidelityResult result;
+            result.failed++;
+            result.failedItems.push_back(inputPath);
+            return result;
+        }
+
+        // Parse in parallel a chunk at a time, keep library order
+        const size_t total = directory ? files.size() : wardrobe.GetCount();
+        const size_t CHUNK = 4096;
+        std::vector<YimOutfit> outfits;
+        std::vector<char> loaded;
+        corpus.reserve(total);
+        for (size_t base = 0; base < total; base += CHUNK) {
+            const size_t chunk = std::min(CHUNK, total - base);
+            outfits.assign(chunk, YimOutfit());
+            loaded.assign(chunk, 0);
+
+            ParallelFor(chunk, threads, [&](size_t index, unsigned) {
+                if (!directory) {
+                    loaded[index] = wardrobe.Get(base + index, outfits[index]) ? 1 : 0;
+                    return;
+                }
+                OutfitView view;
+                loaded[index] = view.Open((fs::path(inputPath) / files[base + index]).string()) &&
+                                view.ToYim(outfits[index]) ? 1 : 0;
+            });
+
+            for (size_t i = 0; i < chunk; i++) {
+                if (loaded[i]) {
+                    corpus.push_back(std::move(outfits[i]));
+                } else {
+                    const std::string name = directory ? files[base + i] : wardrobe.GetName(base + i);
+                    failedItems.push_back(name.empty() ? "#" + std::to_string(base + i) : name);
+                }
+            }
+        }
+
+        FidelityResult result = Run(corpus, threads, repeat);
+        result.failed = failedItems.size();
+        result.failedItems = std::move(failedItems);
+        return result;
+    }
+
+} // namespace OutfitConverter
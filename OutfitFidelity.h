@@ -0,0 +1,72 @@
+#pragma once
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== FIDELITY RESULT ==============
+    // Loss is counted per canonical slot: 0-11 components, 12-20 props, then
+    // the model and the blend data. A missing slot reads as its default, so
+    // padding a slot out is not a loss; changing any of its values is.
+    struct FidelityPath {
+        static const int SLOT_MODEL = 21;
+        static const int SLOT_BLEND = 22;
+        static const int SLOTS = 23;
+
+        FormatConverter::FormatType from;   // A in A -> B -> A
+        FormatConverter::FormatType via;    // B
+        size_t outfits;
+        size_t lossy;                       // Outfits with any slot lost
+        size_t slotLoss[SLOTS];
+
+        FidelityPath() : from(FormatConverter::FormatType::UNKNOWN), via(FormatConverter::FormatType::UNKNOWN),
+            outfits(0), lossy(0) {
+            for (size_t& count : slotLoss) count = 0;
+        }
+    };
+
+    // One FormatConverter function, e.g. CheraxToStand
+    struct ConverterTiming {
+        FormatConverter::FormatType from;
+        FormatConverter::FormatType to;
+        size_t calls;
+        uint64_t nanoseconds;   // Summed over workers, so per-thread throughput
+
+        ConverterTiming() : from(FormatConverter::FormatType::UNKNOWN), to(FormatConverter::FormatType::UNKNOWN),
+            calls(0), nanoseconds(0) {}
+    };
+
+    struct FidelityResult {
+        size_t outfits;
+        size_t failed;
+        std::vector<std::string> failedItems;
+        std::vector<FidelityPath> paths;            // Every ordered pair of the four formats
+        std::vector<ConverterTiming> converters;    // The twelve pairwise converters
+
+        FidelityResult() : outfits(0), failed(0) {}
+    };
+
+    // ============== FIDELITY MATRIX ==============
+    // Runs every A -> B -> A path across the four built-in formats through
+    // the FormatConverter functions. Each outfit of the corpus is first
+    // brought into format A (from its canonical form), so a path measures
+    // only what the B round trip loses.
+    class FidelityMatrix {
+    public:
+        // inputPath: library directory (any format) or .owb wardrobe.
+        // repeat: conversion passes, for steadier timings on small corpora.
+        static FidelityResult Run(const std::string& inputPath, unsigned threads = 0, unsigned repeat = 1);
+
+        static FidelityResult Run(const std::vector<YimOutfit>& outfits, unsigned threads = 0, unsigned repeat = 1);
+
+        // "Torso", "prop3", "model", "blend"
+        static std::string SlotName(int slot);
+
+        // Bit per FidelityPath slot whose value differs between the outfits
+        static uint32_t CompareSlots(const YimOutfit& before, const YimOutfit& after);
+    };
+
+} // namespace OutfitConverter
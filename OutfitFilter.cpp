@@ -0,0 +1,579 @@
+#include "OutfitFilter.h"
+#include "WardrobeContainer.h"
+#include "FormatConverter.h"
+#include "BatchConverter.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    // ============== FIELD TABLE ==============
+    namespace {
+
+        const int COMPONENT_SLOTS = 12;
+        const int PROP_SLOTS = 9;
+
+        const uint16_t FIELD_MODEL = OutfitFilter::FIELD_MODEL;
+        const uint16_t FIELD_COMPONENTS = OutfitFilter::FIELD_COMPONENTS;
+        const uint16_t FIELD_PROPS = OutfitFilter::FIELD_PROPS;
+        const uint16_t FIELD_BLEND = OutfitFilter::FIELD_BLEND;
+
+        const char* const BLEND_FIELDS[10] = {
+            "is_parent", "shape_first_id", "shape_mix", "shape_second_id", "shape_third_id",
+            "skin_first_id", "skin_mix", "skin_second_id", "skin_third_id", "third_mix"
+        };
+
+        bool IsFloatField(uint16_t field) {
+            const int blend = field - FIELD_BLEND;
+            return blend == 2 || blend == 6 || blend == 9;
+        }
+
+        // Lowercase with spaces, '/' and '_' removed, so "Special 2" and
+        // "Tuxedo/Jacket Bib" are written special2 and tuxedojacketbib
+        std::string NormalizeName(const std::string& text) {
+            std::string result;
+            for (unsigned char c : text) {
+                if (std::isalnum(c)) result += static_cast<char>(std::tolower(c));
+            }
+            return result;
+        }
+
+        bool ParseSlot(const std::string& name, const std::map<std::string, int>& names, int slots, int& slot) {
+            const std::string key = NormalizeName(name);
+            for (const auto& pair : names) {
+                if (NormalizeName(pair.first) == key) {
+                    slot = pair.second;
+                    return true;
+                }
+            }
+            if (name.empty() || !std::all_of(name.begin(), name.end(), ::isdigit)) return false;
+            slot = std::atoi(name.c_str());
+            return name.size() <= 2 && slot < slots;
+        }
+
+        bool IsInteger(double value) {
+            return value == std::floor(value) && value >= INT32_MIN && value <= INT32_MAX;
+        }
+    }
+
+    // ============== FILTER PARSER ==============
+    // Tokenizer and recursive descent parser. Builds a small expression
+    // tree, then emits it in postfix order and extracts index terms from
+    // the top-level AND chain.
+    class FilterParser {
+    public:
+        FilterParser(const std::string& text, OutfitFilter& target)
+            : source(text), filter(target), position(0) {}
+
+        bool Run(std::string& error) {
+            if (!Tokenize(error)) return false;
+            current = 0;
+            int root = ParseOr();
+            if (root >= 0 && Peek().type != Token::END) root = Fail("unexpected '" + Peek().text + "'");
+            if (root < 0) {
+                error = message;
+                return false;
+            }
+
+            filter.program.clear();
+            filter.indexTerms.clear();
+            size_t depth = 0, maxDepth = 0;
+            Emit(root, depth, maxDepth);
+            if (maxDepth > OutfitFilter::MAX_DEPTH) {
+                filter.program.clear();
+                filter.sets.clear();
+                error = "expression is too deeply nested";
+                return false;
+            }
+            CollectTerms(root);
+            return true;
+        }
+
+    private:
+        struct Token {
+            enum Type { WORD, NUMBER, OPERATOR, END };
+            Type type;
+            std::string text;
+            double number;
+            size_t column;
+        };
+
+        struct Node {
+            enum Type { LEAF, AND, OR, NOT };
+            Type type;
+            int left;
+            int right;
+            OutfitFilter::Instruction leaf;
+        };
+
+        const std::string& source;
+        OutfitFilter& filter;
+        size_t position;
+        std::vector<Token> tokens;
+        size_t current;
+        std::vector<Node> nodes;
+        std::string message;
+
+        // ---------- Tokenizer ----------
+        bool Tokenize(std::string& error) {
+            while (true) {
+                while (position < source.size() && std::isspace(static_cast<unsigned char>(source[position]))) position++;
+                Token token;
+                token.column = position + 1;
+                token.number = 0;
+                if (position >= source.size()) {
+                    token.type = Token::END;
+                    token.text = "end of expression";
+                    tokens.push_back(token);
+                    return true;
+                }
+
+                const char c = source[position];
+                if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                    const size_t start = position;
+                    while (position < source.size() &&
+                           (std::isalnum(static_cast<unsigned char>(source[position])) ||
+                            source[position] == '_' || source[position] == '.')) {
+                        position++;
+                    }
+                    token.type = Token::WORD;
+                    token.text = source.substr(start, position - start);
+                } else if (std::isdigit(static_cast<unsigned char>(c))) {
+                    // A '.' only continues the number when a digit follows,
+                    // so "10..20" lexes as 10, .., 20
+                    const size_t start = position;
+                    while (position < source.size() && std::isdigit(static_cast<unsigned char>(source[position]))) position++;
+                    if (position + 1 < source.size() && source[position] == '.' &&
+                        std::isdigit(static_cast<unsigned char>(source[position + 1]))) {
+                        position++;
+                        while (position < source.size() && std::isdigit(static_cast<unsigned char>(source[position]))) position++;
+                    }
+                    token.type = Token::NUMBER;
+                    token.text = source.substr(start, position - start);
+                    token.number = std::strtod(token.text.c_str(), nullptr);
+                } else {
+                    static const char* const OPERATORS[] = {
+                        "==", "!=", "<=", ">=", "&&", "||", "..", "<", ">", "=", "!", "(", ")", "[", "]", ",", "-"
+                    };
+                    token.type = Token::OPERATOR;
+                    for (const char* op : OPERATORS) {
+                        if (source.compare(position, std::strlen(op), op) == 0) {
+                            token.text = op;
+                            break;
+                        }
+                    }
+                    if (token.text.empty()) {
+                        error = "unexpected character '" + std::string(1, c) + "' at column " + std::to_string(token.column);
+                        return false;
+                    }
+                    position += token.text.size();
+                }
+                tokens.push_back(token);
+            }
+        }
+
+        // ---------- Parser ----------
+        const Token& Peek() const { return tokens[current]; }
+
+        bool IsKeyword(const Token& token, const char* keyword) const {
+            if (token.type != Token::WORD || token.text.size() != std::strlen(keyword)) return false;
+            for (size_t i = 0; i < token.text.size(); i++) {
+                if (std::tolower(static_cast<unsigned char>(token.text[i])) != keyword[i]) return false;
+            }
+            return true;
+        }
+
+        bool Accept(const char* op) {
+            if (Peek().type == Token::OPERATOR && Peek().text == op) {
+                current++;
+                return true;
+            }
+            return false;
+        }
+
+        bool AcceptKeyword(const char* keyword) {
+            if (IsKeyword(Peek(), keyword)) {
+                current++;
+                return true;
+            }
+            return false;
+        }
+
+        int Fail(const std::string& what) {
+            if (message.empty()) message = what + " at column " + std::to_string(Peek().column);
+            return -1;
+        }
+
+        int AddNode(Node::Type type, int left, int right) {
+            Node node;
+            node.type = type;
+            node.left = left;
+            node.right = right;
+            node.leaf = OutfitFilter::Instruction();
+            nodes.push_back(node);
+            return static_cast<int>(nodes.size() - 1);
+        }
+
+        int ParseOr() {
+            int left = ParseAnd();
+            while (left >= 0 && (AcceptKeyword("or") || Accept("||"))) {
+                const int right = ParseAnd();
+                if (right < 0) return -1;
+                left = AddNode(Node::OR, left, right);
+            }
+            return left;
+        }
+
+        int ParseAnd() {
+            int left = ParseNot();
+            while (left >= 0 && (AcceptKeyword("and") || Accept("&&"))) {
+                const int right = ParseNot();
+                if (right < 0) return -1;
+                left = AddNode(Node::AND, left, right);
+            }
+            return left;
+        }
+
+        int ParseNot() {
+            if (AcceptKeyword("not") || Accept("!")) {
+                const int operand = ParseNot();
+                return operand < 0 ? -1 : AddNode(Node::NOT, operand, -1);
+            }
+            if (Accept("(")) {
+                const int inner = ParseOr();
+                if (inner < 0) return -1;
+                if (!Accept(")")) return Fail("expected ')'");
+                return inner;
+            }
+            return ParseComparison();
+        }
+
+        bool ParseField(uint16_t& field) {
+            if (Peek().type != Token::WORD) return Fail("expected field name") >= 0;
+            const std::string text = Peek().text;
+            std::vector<std::string> parts;
+            size_t start = 0;
+            while (true) {
+                const size_t dot = text.find('.', start);
+                parts.push_back(text.substr(start, dot - start));
+                if (dot == std::string::npos) break;
+                start = dot + 1;
+            }
+
+            const std::string root = NormalizeName(parts[0]);
+            int slot = 0;
+            bool valid = false;
+            if (root == "model" && parts.size() == 1) {
+                field = FIELD_MODEL;
+                valid = true;
+            } else if ((root == "components" || root == "component") && (parts.size() == 2 || parts.size() == 3) &&
+                       ParseSlot(parts[1], ComponentMapping::CHERAX_COMPONENT_MAP, COMPONENT_SLOTS, slot)) {
+                const std::string attribute = parts.size() == 3 ? NormalizeName(parts[2]) : "drawable";
+                const int offset = attribute == "drawable" ? 0 : attribute == "texture" ? 1 : attribute == "palette" ? 2 : -1;
+                field = static_cast<uint16_t>(FIELD_COMPONENTS + slot * 3 + offset);
+                valid = offset >= 0;
+            } else if ((root == "props" || root == "prop") && (parts.size() == 2 || parts.size() == 3) &&
+                       ParseSlot(parts[1], ComponentMapping::CHERAX_PROP_MAP, PROP_SLOTS, slot)) {
+                const std::string attribute = parts.size() == 3 ? NormalizeName(parts[2]) : "drawable";
+                const int offset = attribute == "drawable" ? 0 : attribute == "texture" ? 1 : -1;
+                field = static_cast<uint16_t>(FIELD_PROPS + slot * 2 + offset);
+                valid = offset >= 0;
+            } else if (root == "blend" && parts.size() == 2) {
+                for (int i = 0; i < 10; i++) {
+                    if (NormalizeName(parts[1]) == NormalizeName(BLEND_FIELDS[i])) {
+                        field = static_cast<uint16_t>(FIELD_BLEND + i);
+                        valid = true;
+                    }
+                }
+            }
+            if (!valid) return Fail("unknown field '" + text + "'") >= 0;
+            current++;
+            return true;
+        }
+
+        bool ParseValue(uint16_t field, double& value) {
+            const bool negative = Accept("-");
+            if (Peek().type == Token::NUMBER) {
+                value = negative ? -Peek().number : Peek().number;
+            } else if (!negative && field == FIELD_MODEL && IsKeyword(Peek(), "male")) {
+                value = ComponentMapping::MODEL_MP_M_FREEMODE_01;
+            } else if (!negative && field == FIELD_MODEL && IsKeyword(Peek(), "female")) {
+                value = ComponentMapping::MODEL_MP_F_FREEMODE_01;
+            } else {
+                return Fail("expected value") >= 0;
+            }
+            // Blend mixes are stored as float; compare at the same precision
+            if (IsFloatField(field)) value = static_cast<float>(value);
+            current++;
+            return true;
+        }
+
+        int ParseComparison() {
+            OutfitFilter::Instruction leaf = OutfitFilter::Instruction();
+            if (!ParseField(leaf.field)) return -1;
+
+            if (AcceptKeyword("in")) {
+                if (!Accept("[")) return Fail("expected '['");
+                std::vector<double> values(1);
+                if (!ParseValue(leaf.field, values[0])) return -1;
+                if (Accept("..")) {
+                    leaf.op = OutfitFilter::Op::IN_RANGE;
+                    leaf.low = values[0];
+                    if (!ParseValue(leaf.field, leaf.high)) return -1;
+                } else {
+                    while (Accept(",")) {
+                        values.push_back(0);
+                        if (!ParseValue(leaf.field, values.back())) return -1;
+                    }
+                    std::sort(values.begin(), values.end());
+                    values.erase(std::unique(values.begin(), values.end()), values.end());
+                    leaf.op = OutfitFilter::Op::IN_SET;
+                    leaf.high = static_cast<double>(filter.sets.size());
+                    filter.sets.push_back(values);
+                }
+                if (!Accept("]")) return Fail("expected ']'");
+            } else {
+                static const struct { const char* text; OutfitFilter::Op op; } COMPARISONS[] = {
+                    { "==", OutfitFilter::Op::EQ }, { "=", OutfitFilter::Op::EQ }, { "!=", OutfitFilter::Op::NE },
+                    { "<", OutfitFilter::Op::LT }, { "<=", OutfitFilter::Op::LE },
+                    { ">", OutfitFilter::Op::GT }, { ">=", OutfitFilter::Op::GE }
+                };
+                bool found = false;
+                for (const auto& comparison : COMPARISONS) {
+                    if (Accept(comparison.text)) {
+                        leaf.op = comparison.op;
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) return Fail("expected comparison operator");
+                if (!ParseValue(leaf.field, leaf.low)) return -1;
+            }
+
+            const int node = AddNode(Node::LEAF, -1, -1);
+            nodes[node].leaf = leaf;
+            return node;
+        }
+
+        // ---------- Code generation ----------
+        void Emit(int index, size_t& depth, size_t& maxDepth) {
+            const Node& node = nodes[index];
+            OutfitFilter::Instruction instruction = OutfitFilter::Instruction();
+            switch (node.type) {
+            case Node::LEAF:
+                filter.program.push_back(node.leaf);
+                maxDepth = std::max(maxDepth, ++depth);
+                return;
+            case Node::NOT:
+                Emit(node.left, depth, maxDepth);
+                instruction.op = OutfitFilter::Op::NOT;
+                break;
+            case Node::AND:
+            case Node::OR:
+                Emit(node.left, depth, maxDepth);
+                Emit(node.right, depth, maxDepth);
+                instruction.op = node.type == Node::AND ? OutfitFilter::Op::AND : OutfitFilter::Op::OR;
+                depth--;
+                break;
+            }
+            filter.program.push_back(instruction);
+        }
+
+        // Leaves on the top-level AND chain that imply an indexed term.
+        // Only values the index stores qualify: missing components read 0
+        // and empty props (-1) are not indexed, so those never narrow.
+        void CollectTerms(int index) {
+            const Node& node = nodes[index];
+            if (node.type == Node::AND) {
+                CollectTerms(node.left);
+                CollectTerms(node.right);
+                return;
+            }
+            if (node.type != Node::LEAF) return;
+
+            const OutfitFilter::Instruction& leaf = node.leaf;
+            IndexTerm term;
+            bool usable = false;
+            if (leaf.field >= FIELD_COMPONENTS && leaf.field < FIELD_PROPS) {
+                const int slot = (leaf.field - FIELD_COMPONENTS) / 3;
+                const int offset = (leaf.field - FIELD_COMPONENTS) % 3;
+                if (leaf.op == OutfitFilter::Op::EQ && offset < 2 && leaf.low != 0 && IsInteger(leaf.low)) {
+                    const int32_t value = static_cast<int32_t>(leaf.low);
+                    term = offset == 0 ? IndexTerm(IndexTerm::Kind::COMPONENT, slot, value)
+                                       : IndexTerm(IndexTerm::Kind::COMPONENT, slot, IndexTerm::ANY, value);
+                    usable = true;
+                }
+            } else if (leaf.field >= FIELD_PROPS && leaf.field < FIELD_BLEND && (leaf.field - FIELD_PROPS) % 2 == 0) {
+                const int slot = (leaf.field - FIELD_PROPS) / 2;
+                term = IndexTerm(IndexTerm::Kind::PROP, slot);
+                switch (leaf.op) {
+                case OutfitFilter::Op::EQ:
+                    usable = leaf.low != -1 && IsInteger(leaf.low);
+                    if (usable) term.drawable = static_cast<int32_t>(leaf.low);
+                    break;
+                case OutfitFilter::Op::NE: usable = leaf.low == -1; break;
+                case OutfitFilter::Op::GT: usable = leaf.low >= -1; break;
+                case OutfitFilter::Op::GE: usable = leaf.low > -1; break;
+                case OutfitFilter::Op::IN_RANGE: usable = leaf.low > -1; break;
+                case OutfitFilter::Op::IN_SET: {
+                    const std::vector<double>& values = filter.sets[static_cast<size_t>(leaf.high)];
+                    usable = !std::binary_search(values.begin(), values.end(), -1.0);
+                    break;
+                }
+                default: break;
+                }
+            }
+            if (usable && std::find(filter.indexTerms.begin(), filter.indexTerms.end(), term) == filter.indexTerms.end()) {
+                filter.indexTerms.push_back(term);
+            }
+        }
+    };
+
+    // ============== OUTFIT FILTER ==============
+    bool OutfitFilter::Compile(const std::string& expression, std::string& error) {
+        program.clear();
+        sets.clear();
+        indexTerms.clear();
+        FilterParser parser(expression, *this);
+        return parser.Run(error);
+    }
+
+    void OutfitFilter::Flatten(const YimOutfit& outfit, double* fields) {
+        fields[FIELD_MODEL] = outfit.model;
+        for (int slot = 0; slot < COMPONENT_SLOTS; slot++) {
+            const auto it = outfit.components.find(slot);
+            const Component component = it != outfit.components.end() ? it->second : Component();
+            fields[FIELD_COMPONENTS + slot * 3] = component.drawable;
+            fields[FIELD_COMPONENTS + slot * 3 + 1] = component.texture;
+            fields[FIELD_COMPONENTS + slot * 3 + 2] = component.palette;
+        }
+        for (int slot = 0; slot < PROP_SLOTS; slot++) {
+            const auto it = outfit.props.find(slot);
+            const Prop prop = it != outfit.props.end() ? it->second : Prop();
+            fields[FIELD_PROPS + slot * 2] = prop.drawable;
+            fields[FIELD_PROPS + slot * 2 + 1] = prop.texture;
+        }
+        const BlendData& blend = outfit.blend_data;
+        const double blendValues[10] = {
+            static_cast<double>(blend.is_parent), static_cast<double>(blend.shape_first_id), blend.shape_mix,
+            static_cast<double>(blend.shape_second_id), static_cast<double>(blend.shape_third_id),
+            static_cast<double>(blend.skin_first_id), blend.skin_mix, static_cast<double>(blend.skin_second_id),
+            static_cast<double>(blend.skin_third_id), blend.third_mix
+        };
+        std::copy(blendValues, blendValues + 10, fields + FIELD_BLEND);
+    }
+
+    bool OutfitFilter::Matches(const YimOutfit& outfit) const {
+        if (program.empty()) return true;
+
+        double fields[FIELD_COUNT];
+        Flatten(outfit, fields);
+        bool stack[MAX_DEPTH];
+        size_t top = 0;
+        for (const Instruction& instruction : program) {
+            const double value = fields[instruction.field];
+            switch (instruction.op) {
+            case Op::EQ: stack[top++] = value == instruction.low; break;
+            case Op::NE: stack[top++] = value != instruction.low; break;
+            case Op::LT: stack[top++] = value < instruction.low; break;
+            case Op::LE: stack[top++] = value <= instruction.low; break;
+            case Op::GT: stack[top++] = value > instruction.low; break;
+            case Op::GE: stack[top++] = value >= instruction.low; break;
+            case Op::IN_RANGE: stack[top++] = value >= instruction.low && value <= instruction.high; break;
+            case Op::IN_SET: {
+                const std::vector<double>& values = sets[static_cast<size_t>(instruction.high)];
+                stack[top++] = std::binary_search(values.begin(), values.end(), value);
+                break;
+            }
+            case Op::AND: top--; stack[top - 1] = stack[top - 1] && stack[top]; break;
+            case Op::OR: top--; stack[top - 1] = stack[top - 1] || stack[top]; break;
+            case Op::NOT: stack[top - 1] = !stack[top - 1]; break;
+            }
+        }
+        return stack[0];
+    }
+
+    // ============== LIBRARY SELECT ==============
+    SelectResult LibrarySelect::Run(const std::string& inputPath, const OutfitFilter& filter,
+                                    const OutfitIndex* index, unsigned threads) {
+        SelectResult result;
+        const bool narrow = index != nullptr && !filter.GetIndexTerms().empty();
+        std::vector<uint32_t> candidates;
+        if (narrow) candidates = index->Query(filter.GetIndexTerms());
+
+        std::error_code ec;
+        if (!fs::is_directory(inputPath, ec)) {
+            WardrobeFile wardrobe;
+            if (!wardrobe.Open(inputPath)) {
+                result.failed = 1;
+                result.failedItems.push_back(inputPath);
+                return result;
+            }
+            if (!narrow) {
+                candidates.resize(wardrobe.GetCount());
+                for (size_t i = 0; i < candidates.size(); i++) candidates[i] = static_cast<uint32_t>(i);
+            }
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [&](uint32_t id) { return id >= wardrobe.GetCount(); }),
+                             candidates.end());
+
+            // Records decode straight from the mapping; no chunking needed
+            std::vector<char> matched(candidates.size(), 0);
+            ParallelFor(candidates.size(), threads, [&](size_t i, unsigned) {
+                YimOutfit outfit;
+                if (wardrobe.Get(candidates[i], outfit)) matched[i] = filter.Matches(outfit) ? 1 : 2;
+            });
+            result.scanned = candidates.size();
+            for (size_t i = 0; i < candidates.size(); i++) {
+                if (matched[i] == 1) {
+                    result.matches.push_back(wardrobe.GetName(candidates[i]));
+                } else if (matched[i] == 0) {
+                    result.failed++;
+                    result.failedItems.push_back(wardrobe.GetName(candidates[i]));
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::string> files;
+        if (narrow) {
+            for (uint32_t id : candidates) files.push_back(index->GetName(id));
+        } else {
+            files = BatchConverter::CollectInputFiles(inputPath);
+        }
+        result.scanned = files.size();
+
+        // Parse in parallel a chunk at a time; each outfit is parsed once
+        // and the whole program runs against its flattened fields
+        const size_t CHUNK = 4096;
+        std::vector<char> matched;
+        for (size_t base = 0; base < files.size(); base += CHUNK) {
+            const size_t chunk = std::min(CHUNK, files.size() - base);
+            matched.assign(chunk, 0);
+            ParallelFor(chunk, threads, [&](size_t i, unsigned) {
+                const std::string path = (fs::path(inputPath) / files[base + i]).string();
+                YimOutfit outfit;
+                if (FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), outfit)) {
+                    matched[i] = filter.Matches(outfit) ? 1 : 2;
+                }
+            });
+            for (size_t i = 0; i < chunk; i++) {
+                if (matched[i] == 1) {
+                    result.matches.push_back(files[base + i]);
+                } else if (matched[i] == 0) {
+                    result.failed++;
+                    result.failedItems.push_back(files[base + i]);
+                }
+            }
+        }
+        return result;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,85 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "OutfitIndex.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== OUTFIT FILTER ==============
+    // Boolean selection expressions over canonical outfits, e.g.
+    //
+    //   model == female AND props.Hat != -1 AND components.Legs.drawable in [10..20]
+    //
+    // Fields: model (numeric, or male/female), components.SLOT[.drawable|
+    // .texture|.palette], props.SLOT[.drawable|.texture], blend.FIELD. SLOT
+    // is a Cherax slot name (case, spaces and '/' ignored) or a slot number;
+    // the attribute defaults to drawable. Missing components read 0 and
+    // missing props -1, as in the outfit structures.
+    // Operators: == != < <= > >=, in [a..b], in [a, b, ...], AND/OR/NOT
+    // (also && || !), parentheses.
+    //
+    // Compile turns the expression into a flat postfix program over a fixed
+    // field table; Matches flattens the outfit once and runs the program.
+    class OutfitFilter {
+    public:
+        enum class Op : uint8_t { EQ, NE, LT, LE, GT, GE, IN_RANGE, IN_SET, AND, OR, NOT };
+
+        struct Instruction {
+            Op op;
+            uint16_t field;
+            double low;         // Comparison value, or range start
+            double high;        // Range end, or set index
+        };
+
+        // Field ids: model, then components (drawable, texture, palette per
+        // slot), props (drawable, texture per slot) and the 10 blend values
+        static const uint16_t FIELD_MODEL = 0;
+        static const uint16_t FIELD_COMPONENTS = 1;
+        static const uint16_t FIELD_PROPS = FIELD_COMPONENTS + 12 * 3;
+        static const uint16_t FIELD_BLEND = FIELD_PROPS + 9 * 2;
+        static const size_t FIELD_COUNT = FIELD_BLEND + 10;
+        static const size_t MAX_DEPTH = 64;
+
+        bool Compile(const std::string& expression, std::string& error);
+        bool IsCompiled() const { return !program.empty(); }
+
+        bool Matches(const YimOutfit& outfit) const;
+        static void Flatten(const YimOutfit& outfit, double* fields);
+
+        // Terms every matching outfit must have, for narrowing candidates
+        // with an OutfitIndex before Matches (empty: no narrowing possible)
+        const std::vector<IndexTerm>& GetIndexTerms() const { return indexTerms; }
+        const std::vector<Instruction>& GetProgram() const { return program; }
+        // Sorted values of an IN_SET instruction (its high field)
+        const std::vector<double>& GetSet(size_t index) const { return sets[index]; }
+
+    private:
+        std::vector<Instruction> program;
+        std::vector<std::vector<double>> sets;
+        std::vector<IndexTerm> indexTerms;
+
+        friend class FilterParser;
+    };
+
+    struct SelectResult {
+        size_t scanned;         // Outfits evaluated (after index narrowing)
+        size_t failed;
+        std::vector<std::string> matches;   // Names or relative paths, library order
+        std::vector<std::string> failedItems;
+
+        SelectResult() : scanned(0), failed(0) {}
+    };
+
+    class LibrarySelect {
+    public:
+        // Evaluates filter over a library directory or .owb wardrobe in
+        // parallel. With an index built from the same library, only its
+        // candidates for filter.GetIndexTerms() are loaded.
+        static SelectResult Run(const std::string& inputPath, const OutfitFilter& filter,
+                                const OutfitIndex* index = nullptr, unsigned threads = 0);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,169 @@
+#include "OutfitFingerprint.h"
+#include "WardrobeContainer.h"
+#include "FormatConverter.h"
+#include "BatchConverter.h"
+#include "ContentHash.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        const int COMPONENT_SLOTS = 12;
+
+        // Second FNV stream for the high half; any odd constant unrelated to the basis
+        const uint64_t HIGH_SEED = 0x9E3779B97F4A7C15ULL;
+
+        float NormalizeMix(float value) {
+            return value == 0.0f ? 0.0f : value;
+        }
+    }
+
+    std::string Fingerprint::ToHex() const {
+        return HashToHex(high) + HashToHex(low);
+    }
+
+    bool Fingerprint::FromHex(const std::string& hex, Fingerprint& fingerprint) {
+        if (hex.size() != 32) return false;
+        uint64_t halves[2] = { 0, 0 };
+        for (size_t i = 0; i < hex.size(); i++) {
+            const char c = hex[i];
+            int digit;
+            if (c >= '0' && c <= '9') digit = c - '0';
+            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+            else return false;
+            halves[i / 16] = (halves[i / 16] << 4) | static_cast<uint64_t>(digit);
+        }
+        fingerprint.high = halves[0];
+        fingerprint.low = halves[1];
+        return true;
+    }
+
+    // ============== FINGERPRINT ==============
+    YimOutfit OutfitFingerprint::Normalize(const YimOutfit& outfit, bool includeModel) {
+        YimOutfit normalized;
+        normalized.model = includeModel ? outfit.model : 0;
+        normalized.blend_data = outfit.blend_data;
+        normalized.blend_data.shape_mix = NormalizeMix(outfit.blend_data.shape_mix);
+        normalized.blend_data.skin_mix = NormalizeMix(outfit.blend_data.skin_mix);
+        normalized.blend_data.third_mix = NormalizeMix(outfit.blend_data.third_mix);
+
+        for (int slot = 0; slot < COMPONENT_SLOTS; slot++) {
+            auto it = outfit.components.find(slot);
+            normalized.components[slot] = it != outfit.components.end() ? it->second : Component();
+        }
+        for (const auto& pair : outfit.props) {
+            if (pair.second.drawable != -1) normalized.props.insert(pair);
+        }
+        return normalized;
+    }
+
+    Fingerprint OutfitFingerprint::Compute(const YimOutfit& outfit, bool includeModel) {
+        // The wardrobe record is already a fixed, little-endian canonical layout
+        uint8_t record[WardrobeContainer::RECORD_SIZE];
+        WardrobeContainer::EncodeRecord(Normalize(outfit, includeModel), WardrobeContainer::NO_NAME, 0, record);
+
+        Fingerprint fingerprint;
+        fingerprint.low = MixHash(HashBytes(record, sizeof(record)));
+        fingerprint.high = MixHash(HashBytes(record, sizeof(record), HIGH_SEED));
+        return fingerprint;
+    }
+
+    // ============== FINGERPRINT TABLE ==============
+    FingerprintTable::FingerprintTable(size_t expected) : count(0) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        slots.resize(capacity);
+    }
+
+    void FingerprintTable::Grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.resize(old.size() * 2);
+        count = 0;
+        for (const Slot& slot : old) {
+            if (slot.used) FindOrInsert(slot.key, slot.value);
+        }
+    }
+
+    uint32_t FingerprintTable::FindOrInsert(const Fingerprint& key, uint32_t value, bool* inserted) {
+        if ((count + 1) * 2 > slots.size()) Grow();
+
+        const size_t mask = slots.size() - 1;
+        for (size_t i = static_cast<size_t>(key.low) & mask; ; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (!slot.used) {
+                slot.key = key;
+                slot.value = value;
+                slot.used = true;
+                count++;
+                if (inserted) *inserted = true;
+                return value;
+            }
+            if (slot.key == key) {
+                if (inserted) *inserted = false;
+                return slot.value;
+            }
+        }
+    }
+
+    bool FingerprintTable::Find(const Fingerprint& key, uint32_t& value) const {
+        const size_t mask = slots.size() - 1;
+        for (size_t i = static_cast<size_t>(key.low) & mask; slots[i].used; i = (i + 1) & mask) {
+            if (slots[i].key == key) {
+                value = slots[i].value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ============== LIBRARY DEDUP ==============
+    DedupResult LibraryDedup::Run(const std::string& inputDir, unsigned threads, bool includeModel) {
+        DedupResult result;
+        const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputDir);
+        result.files = files.size();
+
+        std::vector<Fingerprint> fingerprints(files.size());
+        std::vector<char> loaded(files.size(), 0);
+        ParallelFor(files.size(), threads, [&](size_t index, unsigned) {
+            const std::string path = (fs::path(inputDir) / files[index]).string();
+            YimOutfit outfit;
+            if (FormatConverter::LoadAsYim(path, FormatConverter::DetectFormat(path), outfit)) {
+                fingerprints[index] = OutfitFingerprint::Compute(outfit, includeModel);
+                loaded[index] = 1;
+            }
+        });
+
+        // Grouping is a single cheap probe per file; files are sorted, so
+        // each group's paths come out sorted too
+        FingerprintTable table(files.size());
+        std::vector<std::vector<uint32_t>> members;
+        for (size_t i = 0; i < files.size(); i++) {
+            if (!loaded[i]) {
+                result.failed++;
+                result.failedItems.push_back(files[i]);
+                continue;
+            }
+            const uint32_t group = table.FindOrInsert(fingerprints[i], static_cast<uint32_t>(members.size()));
+            if (group == members.size()) members.emplace_back();
+            members[group].push_back(static_cast<uint32_t>(i));
+        }
+        result.unique = members.size();
+
+        for (const auto& group : members) {
+            if (group.size() < 2) continue;
+            DuplicateGroup duplicates;
+            duplicates.fingerprint = fingerprints[group[0]];
+            for (uint32_t index : group) duplicates.paths.push_back(files[index]);
+            result.groups.push_back(std::move(duplicates));
+        }
+        return result;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,92 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== OUTFIT FINGERPRINT ==============
+    // 128-bit hash of the normalized canonical outfit, so the same look saved
+    // in any of the four formats (or merely re-formatted) fingerprints the
+    // same. Use low alone where 64 bits are enough.
+    struct Fingerprint {
+        uint64_t high;
+        uint64_t low;
+
+        Fingerprint() : high(0), low(0) {}
+
+        bool operator==(const Fingerprint& other) const { return high == other.high && low == other.low; }
+        bool operator!=(const Fingerprint& other) const { return !(*this == other); }
+        bool operator<(const Fingerprint& other) const {
+            return high != other.high ? high < other.high : low < other.low;
+        }
+
+        std::string ToHex() const;
+        static bool FromHex(const std::string& hex, Fingerprint& fingerprint);
+    };
+
+    class OutfitFingerprint {
+    public:
+        // Normalization: every component slot present (missing = 0,0,0), empty
+        // prop slots (drawable -1) dropped, -0.0 blend mixes read as 0.0.
+        // YimMenu files written without a model load as the male freemode
+        // model, so cross-format grouping that includes them needs
+        // includeModel = false.
+        static YimOutfit Normalize(const YimOutfit& outfit, bool includeModel = true);
+        static Fingerprint Compute(const YimOutfit& outfit, bool includeModel = true);
+    };
+
+    // ============== FINGERPRINT TABLE ==============
+    // Open-addressing fingerprint -> value map for very large libraries.
+    // Fingerprints are already uniformly distributed, so low bits pick the
+    // bucket directly; the table stays at most half full.
+    class FingerprintTable {
+    private:
+        struct Slot {
+            Fingerprint key;
+            uint32_t value;
+            bool used;
+
+            Slot() : value(0), used(false) {}
+        };
+
+        std::vector<Slot> slots;
+        size_t count;
+
+        void Grow();
+
+    public:
+        explicit FingerprintTable(size_t expected = 0);
+
+        // Returns the stored value; inserts value first if key is new
+        uint32_t FindOrInsert(const Fingerprint& key, uint32_t value, bool* inserted = nullptr);
+        bool Find(const Fingerprint& key, uint32_t& value) const;
+
+        size_t Size() const { return count; }
+    };
+
+    // ============== LIBRARY DEDUP ==============
+    struct DuplicateGroup {
+        Fingerprint fingerprint;
+        std::vector<std::string> paths;     // Relative to the scanned root, sorted
+    };
+
+    struct DedupResult {
+        size_t files;
+        size_t unique;
+        size_t failed;
+        std::vector<DuplicateGroup> groups;     // Only fingerprints seen more than once
+        std::vector<std::string> failedItems;
+
+        DedupResult() : files(0), unique(0), failed(0) {}
+    };
+
+    class LibraryDedup {
+    public:
+        // Fingerprints every outfit under inputDir in parallel, then groups them
+        static DedupResult Run(const std::string& inputDir, unsigned threads = 0, bool includeModel = true);
+    };
+
+} // namespace OutfitConverter
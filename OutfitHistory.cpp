@@ -0,0 +1,426 @@
+#include "OutfitHistory.h"
+#include "OutfitDelta.h"
+#include "WardrobeContainer.h"
+#include "FileHandler.h"
+#include "ContentHash.h"
+#include "ByteOrder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    // ============== FRAME PAYLOAD ==============
+    namespace {
+
+        const uint8_t TYPE_SNAPSHOT = 1;
+        const uint8_t TYPE_DELTA = 2;
+        const size_t FRAME_HEADER = 8;
+        const size_t PAYLOAD_PREFIX = 1 + 8 + 8 + 2;   // type, sequence, timestamp, key length
+
+        const char* const INDEX_HEADER = "# OutfitConverter history index v1";
+
+        // std::fseek takes a long, which is 32 bits on Windows; logs may pass 2 GB
+        bool SeekTo(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+            return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+            return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+        uint32_t FrameChecksum(const std::string& payload) {
+            return static_cast<uint32_t>(HashBytes(payload.data(), payload.size()));
+        }
+
+        struct ParsedPayload {
+            uint8_t type;
+            HistoryEntry entry;
+            std::string key;
+            std::string body;
+        };
+
+        bool ParsePayload(const std::string& payload, ParsedPayload& parsed) {
+            if (payload.size() < PAYLOAD_PREFIX) return false;
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(payload.data());
+
+            parsed.type = data[0];
+            parsed.entry.sequence = GetU64(data + 1);
+            parsed.entry.timestamp = static_cast<int64_t>(GetU64(data + 9));
+            parsed.entry.snapshot = parsed.type == TYPE_SNAPSHOT;
+
+            const size_t keyLength = GetU16(data + 17);
+            if (payload.size() < PAYLOAD_PREFIX + keyLength) return false;
+            parsed.key.assign(payload, PAYLOAD_PREFIX, keyLength);
+            parsed.body.assign(payload, PAYLOAD_PREFIX + keyLength, std::string::npos);
+
+            if (parsed.type == TYPE_SNAPSHOT) return parsed.body.size() == WardrobeContainer::RECORD_SIZE;
+            return parsed.type == TYPE_DELTA;
+        }
+
+        // Applies a parsed frame on top of the outfit's previous state
+        bool ApplyPayload(const ParsedPayload& parsed, YimOutfit& state) {
+            if (parsed.type == TYPE_SNAPSHOT) {
+                WardrobeContainer::DecodeRecord(reinterpret_cast<const uint8_t*>(parsed.body.data()), state);
+                return true;
+            }
+
+            OutfitDelta delta;
+            size_t offset = 0;
+            if (!DeltaCodec::Deserialize(parsed.body, offset, delta)) return false;
+            YimOutfit previous = state;
+            DeltaCodec::Apply(previous, delta, state);
+            return true;
+        }
+
+    } // namespace
+
+    // ============== OUTFIT HISTORY LOG ==============
+    const char OutfitHistory::MAGIC[8] = { 'O', 'H', 'L', '1', '\r', '\n', 0x1A, '\n' };
+
+    OutfitHistory::OutfitHistory(size_t interval)
+        : file(nullptr), logSize(0), nextSequence(0),
+          snapshotInterval(std::max<size_t>(interval, 1)), indexDirty(false) {}
+
+    OutfitHistory::~OutfitHistory() {
+        Close();
+    }
+
+    bool OutfitHistory::Open(const std::string& filepath) {
+        Close();
+        logPath = filepath;
+
+        std::error_code ec;
+        uint64_t size = fs::exists(logPath, ec) ? fs::file_size(logPath, ec) : 0;
+        if (ec) return false;
+
+        // "a+": every write lands at the end no matter where the last read was
+        file = std::fopen(logPath.c_str(), "a+b");
+        if (!file) return false;
+
+        if (size == 0) {
+            if (std::fwrite(MAGIC, 1, sizeof(MAGIC), file) != sizeof(MAGIC) || std::fflush(file) != 0) {
+                Close();
+                return false;
+            }
+            logSize = sizeof(MAGIC);
+            nextSequence = 0;
+            indexDirty = true;
+            return true;
+        }
+
+        char magic[sizeof(MAGIC)];
+        if (!SeekTo(file, 0) || std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+            std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            Close();
+            return false;
+        }
+
+        logSize = size;
+        if (LoadIndex()) return true;
+        if (!ScanLog()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool OutfitHistory::Flush() {
+        if (!file) return false;
+
+        bool success = std::fflush(file) == 0;
+        if (FileHandler::GetDurability() != Durability::NONE) {
+            success &= FileHandler::SyncFile(file);
+        }
+        if (indexDirty) {
+            success &= SaveIndex();
+            indexDirty = !success;
+        }
+        return success;
+    }
+
+    void OutfitHistory::Close() {
+        if (file) {
+            Flush();
+            std::fclose(file);
+            file = nullptr;
+        }
+        index.clear();
+        logSize = 0;
+        nextSequence = 0;
+        indexDirty = false;
+    }
+
+    bool OutfitHistory::ReadFrame(uint64_t offset, std::string& payload, uint64_t* next) const {
+        if (offset + FRAME_HEADER > logSize) return false;
+
+        uint8_t header[FRAME_HEADER];
+        if (!SeekTo(file, offset) ||
+            std::fread(header, 1, sizeof(header), file) != sizeof(header)) {
+            return false;
+        }
+
+        const uint32_t length = GetU32(header);
+        if (length > MAX_FRAME_BYTES || offset + FRAME_HEADER + length > logSize) return false;
+
+        payload.resize(length);
+        if (length > 0 && std::fread(&payload[0], 1, length, file) != length) return false;
+        if (FrameChecksum(payload) != GetU32(header + 4)) return false;
+
+        if (next) *next = offset + FRAME_HEADER + length;
+        return true;
+    }
+
+    bool OutfitHistory::AppendFrame(const std::string& payload, uint64_t& offset) {
+        uint8_t header[FRAME_HEADER];
+        PutU32(header, static_cast<uint32_t>(payload.size()));
+        PutU32(header + 4, FrameChecksum(payload));
+
+        offset = logSize;
+        if (std::fseek(file, 0, SEEK_END) != 0 ||
+            std::fwrite(header, 1, sizeof(header), file) != sizeof(header) ||
+            std::fwrite(payload.data(), 1, payload.size(), file) != payload.size()) {
+            return false;
+        }
+        logSize += FRAME_HEADER + payload.size();
+
+        if (FileHandler::GetDurability() == Durability::PER_FILE) {
+            return FileHandler::SyncFile(file);
+        }
+        return true;
+    }
+
+    bool OutfitHistory::ScanLog() {
+        index.clear();
+        nextSequence = 0;
+
+        uint64_t offset = sizeof(MAGIC);
+        std::string payload;
+        ParsedPayload parsed;
+        uint64_t next = offset;
+        while (offset < logSize && ReadFrame(offset, payload, &next) && ParsePayload(payload, parsed)) {
+            IndexEntry& entry = index[parsed.key];
+            if (parsed.entry.snapshot) {
+                entry.snapshotOffset = offset;
+                entry.tail.clear();
+            } else {
+                entry.tail.push_back(offset);
+            }
+            entry.versions++;
+            nextSequence = parsed.entry.sequence + 1;
+            offset = next;
+        }
+
+        // An interrupted append leaves only the last frame bad: its header is
+        // cut short or its declared length reaches the end of the log. A bad
+        // frame with more log behind it is corruption; Open fails instead of
+        // truncating away the versions that follow.
+        if (offset < logSize) {
+            uint8_t header[FRAME_HEADER];
+            if (offset + FRAME_HEADER <= logSize) {
+                if (!SeekTo(file, offset) ||
+                    std::fread(header, 1, sizeof(header), file) != sizeof(header) ||
+                    offset + FRAME_HEADER + GetU32(header) < logSize) {
+                    return false;
+                }
+            }
+
+            std::fclose(file);
+            file = nullptr;
+            std::error_code ec;
+            fs::resize_file(logPath, offset, ec);
+            if (ec) return false;
+            file = std::fopen(logPath.c_str(), "a+b");
+            if (!file) return false;
+            logSize = offset;
+        }
+
+        indexDirty = true;
+        return true;
+    }
+
+    bool OutfitHistory::LoadIndex() {
+        std::string content = FileHandler::ReadFileContent(logPath + ".idx");
+        std::istringstream stream(content);
+        std::string line;
+        if (!std::getline(stream, line) || line != INDEX_HEADER) return false;
+
+        // log \t size \t nextSequence; a size mismatch means appends the index never saw
+        uint64_t indexedSize = 0;
+        if (!std::getline(stream, line) || line.rfind("log\t", 0) != 0) return false;
+        try {
+            size_t tab = line.find('\t', 4);
+            indexedSize = std::stoull(line.substr(4, tab - 4));
+            nextSequence = std::stoull(line.substr(tab + 1));
+        } catch (...) {
+            return false;
+        }
+        if (indexedSize != logSize) return false;
+
+        // key \t snapshotOffset \t versions \t tailOffset,...
+        index.clear();
+        while (std::getline(stream, line)) {
+            if (line.empty()) continue;
+
+            size_t first = line.find('\t');
+            size_t second = line.find('\t', first + 1);
+            size_t third = line.find('\t', second + 1);
+            if (first == std::string::npos || second == std::string::npos || third == std::string::npos) {
+                index.clear();
+                return false;
+            }
+
+            IndexEntry entry;
+            try {
+                entry.snapshotOffset = std::stoull(line.substr(first + 1, second - first - 1));
+                entry.versions = std::stoull(line.substr(second + 1, third - second - 1));
+                std::istringstream tail(line.substr(third + 1));
+                std::string offset;
+                while (std::getline(tail, offset, ',')) {
+                    if (!offset.empty()) entry.tail.push_back(std::stoull(offset));
+                }
+            } catch (...) {
+                index.clear();
+                return false;
+            }
+            index[line.substr(0, first)] = entry;
+        }
+
+        indexDirty = false;
+        return true;
+    }
+
+    bool OutfitHistory::SaveIndex() const {
+        std::vector<std::string> keys = GetKeys();
+
+        std::ostringstream oss;
+        oss << INDEX_HEADER << "\n";
+        oss << "log\t" << logSize << "\t" << nextSequence << "\n";
+        for (const auto& key : keys) {
+            const IndexEntry& entry = index.at(key);
+            oss << key << "\t" << entry.snapshotOffset << "\t" << entry.versions << "\t";
+            for (size_t i = 0; i < entry.tail.size(); i++) {
+                if (i > 0) oss << ",";
+                oss << entry.tail[i];
+            }
+            oss << "\n";
+        }
+
+        return FileHandler::WriteFileContent(logPath + ".idx", oss.str());
+    }
+
+    bool OutfitHistory::Record(const std::string& key, const YimOutfit& outfit) {
+        if (!file || key.empty() || key.size() > 0xFFFF || key.find_first_of("\t\r\n") != std::string::npos) {
+            return false;
+        }
+
+        auto it = index.find(key);
+        YimOutfit previous;
+        if (it != index.end()) {
+            if (!GetLatest(key, previous)) return false;
+            if (DeltaCodec::Distance(previous, outfit, 0) == 0) return true;
+        }
+
+        // Snapshot once the outfit already carries snapshotInterval - 1 deltas
+        const bool snapshot = it == index.end() || it->second.tail.size() >= snapshotInterval - 1;
+
+        const int64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        std::string payload(PAYLOAD_PREFIX, '\0');
+        uint8_t* prefix = reinterpret_cast<uint8_t*>(&payload[0]);
+        prefix[0] = snapshot ? TYPE_SNAPSHOT : TYPE_DELTA;
+        PutU64(prefix + 1, nextSequence);
+        PutU64(prefix + 9, static_cast<uint64_t>(timestamp));
+        PutU16(prefix + 17, static_cast<uint16_t>(key.size()));
+        payload += key;
+
+        if (snapshot) {
+            uint8_t record[WardrobeContainer::RECORD_SIZE];
+            WardrobeContainer::EncodeRecord(outfit, WardrobeContainer::NO_NAME, 0, record);
+            payload.append(reinterpret_cast<const char*>(record), sizeof(record));
+        } else {
+            payload += DeltaCodec::Serialize(DeltaCodec::Encode(previous, outfit));
+        }
+
+        uint64_t offset;
+        if (!AppendFrame(payload, offset)) return false;
+
+        IndexEntry& entry = index[key];
+        if (snapshot) {
+            entry.snapshotOffset = offset;
+            entry.tail.clear();
+        } else {
+            entry.tail.push_back(offset);
+        }
+        entry.versions++;
+        nextSequence++;
+        indexDirty = true;
+        return true;
+    }
+
+    bool OutfitHistory::GetLatest(const std::string& key, YimOutfit& outfit) const {
+        auto it = index.find(key);
+        if (!file || it == index.end()) return false;
+
+        std::string payload;
+        ParsedPayload parsed;
+        YimOutfit state;
+        if (!ReadFrame(it->second.snapshotOffset, payload) || !ParsePayload(payload, parsed) ||
+            !parsed.entry.snapshot || !ApplyPayload(parsed, state)) {
+            return false;
+        }
+
+        for (uint64_t offset : it->second.tail) {
+            if (!ReadFrame(offset, payload) || !ParsePayload(payload, parsed) || !ApplyPayload(parsed, state)) {
+                return false;
+            }
+        }
+
+        outfit = state;
+        return true;
+    }
+
+    uint64_t OutfitHistory::GetVersionCount(const std::string& key) const {
+        auto it = index.find(key);
+        return it != index.end() ? it->second.versions : 0;
+    }
+
+    std::vector<std::string> OutfitHistory::GetKeys() const {
+        std::vector<std::string> keys;
+        keys.reserve(index.size());
+        for (const auto& pair : index) keys.push_back(pair.first);
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    bool OutfitHistory::Replay(const std::string& key,
+                               const std::function<void(const HistoryEntry&, const YimOutfit&)>& visit) const {
+        if (!file || index.find(key) == index.end()) return false;
+
+        uint64_t offset = sizeof(MAGIC);
+        uint64_t next = offset;
+        std::string payload;
+        ParsedPayload parsed;
+        YimOutfit state;
+        while (offset < logSize) {
+            if (!ReadFrame(offset, payload, &next) || !ParsePayload(payload, parsed)) return false;
+            if (parsed.key == key) {
+                if (!ApplyPayload(parsed, state)) return false;
+                visit(parsed.entry, state);
+            }
+            offset = next;
+        }
+        return true;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,93 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== HISTORY RECORD ==============
+    struct HistoryEntry {
+        uint64_t sequence;      // Position in the log, across all outfits
+        int64_t timestamp;      // Milliseconds since the Unix epoch
+        bool snapshot;          // Full outfit rather than a delta
+
+        HistoryEntry() : sequence(0), timestamp(0), snapshot(false) {}
+    };
+
+    // ============== OUTFIT HISTORY LOG ==============
+    // Append-only log of outfit versions keyed by outfit id (typically the
+    // library-relative path). Each frame is
+    //
+    //   u32 payload length | u32 checksum | payload
+    //
+    // and each payload is either a full snapshot (.owb record layout) or a
+    // delta against the outfit's previous version. Every snapshotInterval
+    // versions of an outfit a snapshot is written instead of a delta, so the
+    // latest state is one snapshot plus at most snapshotInterval - 1 deltas.
+    //
+    // The index (<log>.idx) remembers, per outfit, where its last snapshot
+    // and the deltas after it live. It is rewritten on Flush/Close; if it is
+    // missing or older than the log, Open rebuilds it with one scan. A torn
+    // frame at the end of the log (crash mid-append) is truncated on Open; a
+    // bad frame anywhere before the end fails Open.
+    //
+    // Not thread-safe; one writer per log.
+    class OutfitHistory {
+    private:
+        struct IndexEntry {
+            uint64_t snapshotOffset;
+            std::vector<uint64_t> tail;     // Delta frames after the snapshot
+            uint64_t versions;
+
+            IndexEntry() : snapshotOffset(0), versions(0) {}
+        };
+
+        std::FILE* file;
+        std::string logPath;
+        uint64_t logSize;
+        uint64_t nextSequence;
+        size_t snapshotInterval;
+        bool indexDirty;
+        std::unordered_map<std::string, IndexEntry> index;
+
+        bool ReadFrame(uint64_t offset, std::string& payload, uint64_t* next = nullptr) const;
+        bool AppendFrame(const std::string& payload, uint64_t& offset);
+        bool ScanLog();
+        bool LoadIndex();
+        bool SaveIndex() const;
+
+    public:
+        static const char MAGIC[8];
+        static const size_t DEFAULT_SNAPSHOT_INTERVAL = 16;
+        static const uint32_t MAX_FRAME_BYTES = 1024 * 1024;
+
+        explicit OutfitHistory(size_t interval = DEFAULT_SNAPSHOT_INTERVAL);
+        ~OutfitHistory();
+
+        OutfitHistory(const OutfitHistory&) = delete;
+        OutfitHistory& operator=(const OutfitHistory&) = delete;
+
+        // Creates the log if it does not exist
+        bool Open(const std::string& filepath);
+        bool Flush();
+        void Close();
+
+        // Appends a version; unchanged outfits are not re-recorded.
+        // Keys must not contain tabs or newlines.
+        bool Record(const std::string& key, const YimOutfit& outfit);
+
+        bool GetLatest(const std::string& key, YimOutfit& outfit) const;
+        uint64_t GetVersionCount(const std::string& key) const;
+        std::vector<std::string> GetKeys() const;
+
+        // Full audit trail: every version of one outfit, oldest first
+        bool Replay(const std::string& key,
+                    const std::function<void(const HistoryEntry&, const YimOutfit&)>& visit) const;
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,601 @@
+#include "OutfitIndex.h"
+#include "WardrobeContainer.h"
+#include "OutfitView.h"
+#include "FormatConverter.h"
+#include "BatchConverter.h"
+#include "FileHandler.h"
+#include "Parallel.h"
+#include "ByteOrder.h"
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    // ============== FIELD OFFSETS ==============
+    namespace {
+
+        // Header
+        const size_t H_MAGIC = 0;
+        const size_t H_VERSION = 4;
+        const size_t H_HEADER_SIZE = 6;
+        const size_t H_BLOCK_SIZE = 8;
+        const size_t H_OUTFITS = 16;
+        const size_t H_TERMS = 24;
+        const size_t H_TERM_OFFSET = 32;
+        const size_t H_POSTINGS_OFFSET = 40;
+        const size_t H_POSTINGS_SIZE = 48;
+        const size_t H_NAMES_OFFSET = 56;
+
+        // Term record
+        const size_t T_KIND = 0;
+        const size_t T_SLOT = 1;
+        const size_t T_DRAWABLE = 4;
+        const size_t T_TEXTURE = 8;
+        const size_t T_COUNT = 12;
+        const size_t T_OFFSET = 16;
+        const size_t T_BYTES = 24;
+
+        const int COMPONENT_SLOTS = 12;
+        const int PROP_SLOTS = 9;
+        const int SHARDS = COMPONENT_SLOTS + PROP_SLOTS;
+
+        const size_t SKIP_ENTRY = 8;
+
+        uint64_t ValueKey(int32_t drawable, int32_t texture) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(drawable)) << 32) |
+                   static_cast<uint32_t>(texture);
+        }
+
+        void AppendVarint(std::string& out, uint32_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        bool ReadVarint(const uint8_t*& pos, const uint8_t* end, uint32_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 35 && pos < end; shift += 7) {
+                const uint8_t byte = *pos++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        // Skip table, then per block the gaps after its first id
+        void EncodePostings(const std::vector<uint32_t>& ids, std::string& out) {
+            const size_t blocks = (ids.size() + OutfitIndex::BLOCK_SIZE - 1) / OutfitIndex::BLOCK_SIZE;
+            std::string stream;
+            std::string skips(blocks * SKIP_ENTRY, '\0');
+
+            for (size_t i = 0; i < ids.size(); i++) {
+                if (i % OutfitIndex::BLOCK_SIZE == 0) {
+                    uint8_t* skip = reinterpret_cast<uint8_t*>(&skips[(i / OutfitIndex::BLOCK_SIZE) * SKIP_ENTRY]);
+                    PutU32(skip, ids[i]);
+                    PutU32(skip + 4, static_cast<uint32_t>(stream.size()));
+                } else {
+                    AppendVarint(stream, ids[i] - ids[i - 1]);
+                }
+            }
+            out += skips;
+            out += stream;
+        }
+
+        // ============== POSTING CURSOR ==============
+        // Walks either a compressed posting list in the mapping or a
+        // materialized id list (the union of a wildcard term's range).
+        class PostingCursor {
+        private:
+            const uint8_t* skips;
+            const uint8_t* stream;
+            const uint8_t* end;
+            const uint8_t* pos;
+            size_t count;
+            size_t blocks;
+            size_t block;
+            size_t inBlock;
+            std::vector<uint32_t> ids;
+            size_t index;
+            bool compressed;
+            bool valid;
+            uint32_t doc;
+
+            void LoadBlock(size_t b) {
+                block = b;
+                inBlock = 0;
+                doc = GetU32(skips + b * SKIP_ENTRY);
+                const uint32_t offset = GetU32(skips + b * SKIP_ENTRY + 4);
+                valid = offset <= static_cast<size_t>(end - stream);
+                pos = stream + offset;
+            }
+
+        public:
+            PostingCursor(const uint8_t* data, size_t bytes, size_t entries)
+                : skips(data), stream(nullptr), end(data + bytes), pos(nullptr), count(entries),
+                  blocks((entries + OutfitIndex::BLOCK_SIZE - 1) / OutfitIndex::BLOCK_SIZE),
+                  block(0), inBlock(0), index(0), compressed(true), valid(false), doc(0) {
+                stream = skips + blocks * SKIP_ENTRY;
+                if (count > 0 && stream <= end) LoadBlock(0);
+            }
+
+            explicit PostingCursor(std::vector<uint32_t> list)
+                : skips(nullptr), stream(nullptr), end(nullptr), pos(nullptr), count(list.size()), blocks(0),
+                  block(0), inBlock(0), ids(std::move(list)), index(0), compressed(false),
+                  valid(!ids.empty()), doc(ids.empty() ? 0 : ids[0]) {}
+
+            bool Valid() const { return valid; }
+            uint32_t Doc() const { return doc; }
+            size_t Count() const { return count; }
+
+            void Next() {
+                if (!valid) return;
+                if (!compressed) {
+                    valid = ++index < ids.size();
+                    if (valid) doc = ids[index];
+                    return;
+                }
+                if (block * OutfitIndex::BLOCK_SIZE + inBlock + 1 >= count) {
+                    valid = false;
+                } else if (++inBlock == OutfitIndex::BLOCK_SIZE) {
+                    LoadBlock(block + 1);
+                } else {
+                    uint32_t gap;
+                    valid = ReadVarint(pos, end, gap);
+                    doc += gap;
+                }
+            }
+
+            // Advance to the first id >= target
+            void SkipTo(uint32_t target) {
+                if (!valid || doc >= target) return;
+                if (!compressed) {
+                    auto it = std::lower_bound(ids.begin() + index, ids.end(), target);
+                    index = static_cast<size_t>(it - ids.begin());
+                    valid = it != ids.end();
+                    if (valid) doc = *it;
+                    return;
+                }
+
+                // Binary search the skip table for the last block starting at or before target
+                size_t lo = block + 1, hi = blocks;
+                while (lo < hi) {
+                    size_t mid = lo + (hi - lo) / 2;
+                    if (GetU32(skips + mid * SKIP_ENTRY) <= target) lo = mid + 1;
+                    else hi = mid;
+                }
+                if (lo - 1 > block) LoadBlock(lo - 1);
+                while (valid && doc < target) Next();
+            }
+        };
+
+        std::vector<uint32_t> Intersect(std::vector<PostingCursor>& cursors) {
+            std::vector<uint32_t> result;
+            if (cursors.empty()) return result;
+            std::sort(cursors.begin(), cursors.end(),
+                      [](const PostingCursor& a, const PostingCursor& b) { return a.Count() < b.Count(); });
+
+            PostingCursor& lead = cursors[0];
+            while (lead.Valid()) {
+                const uint32_t target = lead.Doc();
+                bool matched = true;
+                for (size_t i = 1; i < cursors.size(); i++) {
+                    cursors[i].SkipTo(target);
+                    if (!cursors[i].Valid()) return result;
+                    if (cursors[i].Doc() != target) {
+                        lead.SkipTo(cursors[i].Doc());
+                        matched = false;
+                        break;
+                    }
+                }
+                if (matched) {
+                    result.push_back(target);
+                    lead.Next();
+                }
+            }
+            return result;
+        }
+
+        bool Matches(const IndexTerm& pattern, const IndexTerm& term) {
+            return pattern.kind == term.kind && pattern.slot == term.slot &&
+                   (pattern.drawable == IndexTerm::ANY || pattern.drawable == term.drawable) &&
+                   (pattern.texture == IndexTerm::ANY || pattern.texture == term.texture);
+        }
+
+        std::string Lower(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        bool ParseNumber(const std::string& text, int32_t& value) {
+            if (text.empty()) return false;
+            char* end = nullptr;
+            long parsed = std::strtol(text.c_str(), &end, 10);
+            if (*end != '\0' || parsed <= INT32_MIN || parsed > INT32_MAX) return false;
+            value = static_cast<int32_t>(parsed);
+            return true;
+        }
+    }
+
+    // ============== INDEX TERM ==============
+    bool IndexTerm::operator<(const IndexTerm& other) const {
+        if (kind != other.kind) return kind < other.kind;
+        if (slot != other.slot) return slot < other.slot;
+        if (drawable != other.drawable) return drawable < other.drawable;
+        return texture < other.texture;
+    }
+
+    bool IndexTerm::Parse(const std::string& text, IndexTerm& term) {
+        const size_t equals = text.find('=');
+        const std::string name = Lower(text.substr(0, equals));
+        term = IndexTerm();
+
+        bool found = false;
+        for (const auto& pair : ComponentMapping::CHERAX_COMPONENT_MAP) {
+            if (Lower(pair.first) == name) {
+                term = IndexTerm(Kind::COMPONENT, pair.second);
+                found = true;
+            }
+        }
+        for (const auto& pair : ComponentMapping::CHERAX_PROP_MAP) {
+            if (Lower(pair.first) == name) {
+                term = IndexTerm(Kind::PROP, pair.second);
+                found = true;
+            }
+        }
+        if (!found) {
+            int32_t slot;
+            if (name.compare(0, 9, "component") == 0 && ParseNumber(name.substr(9), slot) &&
+                slot >= 0 && slot < COMPONENT_SLOTS) {
+                term = IndexTerm(Kind::COMPONENT, slot);
+            } else if (name.compare(0, 4, "prop") == 0 && ParseNumber(name.substr(4), slot) &&
+                       slot >= 0 && slot < PROP_SLOTS) {
+                term = IndexTerm(Kind::PROP, slot);
+            } else {
+                return false;
+            }
+        }
+
+        if (equals == std::string::npos) return true;
+        const std::string value = text.substr(equals + 1);
+        const size_t colon = value.find(':');
+        if (!ParseNumber(value.substr(0, colon), term.drawable)) return false;
+        return colon == std::string::npos || ParseNumber(value.substr(colon + 1), term.texture);
+    }
+
+    std::string IndexTerm::ToString() const {
+        std::string text = (kind == Kind::COMPONENT ? "component" : "prop") + std::to_string(slot);
+        if (drawable != ANY) {
+            text += "=" + std::to_string(drawable);
+            if (texture != ANY) text += ":" + std::to_string(texture);
+        } else if (texture != ANY) {
+            text += "=*:" + std::to_string(texture);
+        }
+        return text;
+    }
+
+    // ============== INDEX BUILD ==============
+    const char OutfitIndex::MAGIC[4] = { 'O', 'I', 'X', '1' };
+
+    IndexBuildResult OutfitIndex::Build(const std::string& inputPath, const std::string& indexPath,
+                                        unsigned threads) {
+        IndexBuildResult result;
+
+        // Outfit ids are positions in names; loadOutfit fills one outfit by id
+        std::vector<std::string> names;
+        WardrobeFile wardrobe;
+        std::error_code ec;
+        const bool directory = fs::is_directory(inputPath, ec);
+        if (directory) {
+            names = BatchConverter::CollectInputFiles(inputPath);
+        } else if (wardrobe.Open(inputPath)) {
+            names.resize(wardrobe.GetCount());
+            for (size_t i = 0; i < names.size(); i++) names[i] = wardrobe.GetName(i);
+        } else {
+            result.failed++;
+            result.failedItems.push_back(inputPath);
+            return result;
+        }
+
+        // Only slots are indexed, so files are decoded through a view that
+        // skips the model and blend data
+        auto loadOutfit = [&](size_t id, YimOutfit& outfit) {
+            if (!directory) return wardrobe.Get(id, outfit);
+            OutfitView view;
+            return view.Open((fs::path(inputPath) / names[id]).string()) &&
+                   view.ToYim(outfit, OutfitView::FIELD_COMPONENTS | OutfitView::FIELD_PROPS);
+        };
+
+        // One shard per slot; shard order is term order (components, then props)
+        std::vector<std::unordered_map<uint64_t, std::vector<uint32_t>>> shards(SHARDS);
+
+        const size_t CHUNK = 4096;
+        std::vector<YimOutfit> outfits;
+        std::vector<char> loaded;
+        for (size_t base = 0; base < names.size(); base += CHUNK) {
+            const size_t chunk = std::min(CHUNK, names.size() - base);
+            outfits.assign(chunk, YimOutfit());
+            loaded.assign(chunk, 0);
+
+            ParallelFor(chunk, threads, [&](size_t index, unsigned) {
+                loaded[index] = loadOutfit(base + index, outfits[index]) ? 1 : 0;
+            });
+
+            // Each shard appends ids in order, so every posting list stays sorted
+            ParallelFor(SHARDS, threads, [&](size_t shard, unsigned) {
+                const bool component = shard < static_cast<size_t>(COMPONENT_SLOTS);
+                const int slot = static_cast<int>(component ? shard : shard - COMPONENT_SLOTS);
+                for (size_t i = 0; i < chunk; i++) {
+                    if (!loaded[i]) continue;
+                    const uint32_t id = static_cast<uint32_t>(base + i);
+                    if (component) {
+                        auto it = outfits[i].components.find(slot);
+                        if (it == outfits[i].components.end()) continue;
+                        shards[shard][ValueKey(it->second.drawable, it->second.texture)].push_back(id);
+                    } else {
+                        auto it = outfits[i].props.find(slot);
+                        if (it == outfits[i].props.end() || it->second.drawable == -1) continue;
+                        shards[shard][ValueKey(it->second.drawable, it->second.texture)].push_back(id);
+                    }
+                }
+            });
+
+            for (size_t i = 0; i < chunk; i++) {
+                if (loaded[i]) {
+                    result.outfits++;
+                } else {
+                    result.failed++;
+                    result.failedItems.push_back(names[base + i]);
+                }
+            }
+        }
+
+        // Encode every shard's terms and postings independently, then concatenate
+        std::vector<std::string> shardTerms(SHARDS), shardPostings(SHARDS);
+        ParallelFor(SHARDS, threads, [&](size_t shard, unsigned) {
+            std::vector<IndexTerm> terms;
+            const bool component = shard < static_cast<size_t>(COMPONENT_SLOTS);
+            const int slot = static_cast<int>(component ? shard : shard - COMPONENT_SLOTS);
+            for (const auto& entry : shards[shard]) {
+                terms.emplace_back(component ? IndexTerm::Kind::COMPONENT : IndexTerm::Kind::PROP, slot,
+                                   static_cast<int32_t>(entry.first >> 32), static_cast<int32_t>(entry.first));
+            }
+            std::sort(terms.begin(), terms.end());
+
+            std::string& records = shardTerms[shard];
+            std::string& postings = shardPostings[shard];
+            records.assign(terms.size() * TERM_SIZE, '\0');
+            for (size_t i = 0; i < terms.size(); i++) {
+                const std::vector<uint32_t>& ids = shards[shard][ValueKey(terms[i].drawable, terms[i].texture)];
+                const size_t offset = postings.size();
+                EncodePostings(ids, postings);
+
+                uint8_t* record = reinterpret_cast<uint8_t*>(&records[i * TERM_SIZE]);
+                record[T_KIND] = static_cast<uint8_t>(terms[i].kind);
+                record[T_SLOT] = terms[i].slot;
+                PutI32(record + T_DRAWABLE, terms[i].drawable);
+                PutI32(record + T_TEXTURE, terms[i].texture);
+                PutU32(record + T_COUNT, static_cast<uint32_t>(ids.size()));
+                PutU64(record + T_OFFSET, offset);       // Shard-relative until concatenated
+                PutU32(record + T_BYTES, static_cast<uint32_t>(postings.size() - offset));
+            }
+            shards[shard].clear();
+        });
+
+        std::string terms;
+        std::string postings;
+        for (size_t shard = 0; shard < static_cast<size_t>(SHARDS); shard++) {
+            const uint64_t shift = postings.size();
+            for (size_t at = 0; at < shardTerms[shard].size(); at += TERM_SIZE) {
+                uint8_t* record = reinterpret_cast<uint8_t*>(&shardTerms[shard][at]);
+                PutU64(record + T_OFFSET, GetU64(record + T_OFFSET) + shift);
+            }
+            terms += shardTerms[shard];
+            postings += shardPostings[shard];
+            shardTerms[shard].clear();
+            shardPostings[shard].clear();
+        }
+        result.terms = terms.size() / TERM_SIZE;
+
+        std::string nameOffsets(4 * (names.size() + 1), '\0');
+        std::string nameBytes;
+        for (size_t i = 0; i < names.size(); i++) {
+            PutU32(reinterpret_cast<uint8_t*>(&nameOffsets[4 * i]), static_cast<uint32_t>(nameBytes.size()));
+            nameBytes += names[i];
+        }
+        PutU32(reinterpret_cast<uint8_t*>(&nameOffsets[4 * names.size()]), static_cast<uint32_t>(nameBytes.size()));
+
+        uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header + H_MAGIC, MAGIC, sizeof(MAGIC));
+        PutU16(header + H_VERSION, VERSION);
+        PutU16(header + H_HEADER_SIZE, HEADER_SIZE);
+        PutU32(header + H_BLOCK_SIZE, BLOCK_SIZE);
+        PutU64(header + H_OUTFITS, names.size());
+        PutU64(header + H_TERMS, result.terms);
+        PutU64(header + H_TERM_OFFSET, HEADER_SIZE);
+        PutU64(header + H_POSTINGS_OFFSET, HEADER_SIZE + terms.size());
+        PutU64(header + H_POSTINGS_SIZE, postings.size());
+        PutU64(header + H_NAMES_OFFSET, HEADER_SIZE + terms.size() + postings.size());
+
+        std::string tempPath;
+        std::FILE* file = FileHandler::BeginAtomicWrite(indexPath, tempPath);
+        bool success = file != nullptr;
+        if (file) {
+            success = std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                      std::fwrite(terms.data(), 1, terms.size(), file) == terms.size() &&
+                      std::fwrite(postings.data(), 1, postings.size(), file) == postings.size() &&
+                      std::fwrite(nameOffsets.data(), 1, nameOffsets.size(), file) == nameOffsets.size() &&
+                      std::fwrite(nameBytes.data(), 1, nameBytes.size(), file) == nameBytes.size();
+            success = FileHandler::CommitAtomicWrite(file, tempPath, indexPath, success);
+        }
+        if (!success) {
+            result.failed++;
+            result.failedItems.push_back(indexPath);
+        }
+        return result;
+    }
+
+    // ============== INDEX FILE ==============
+    OutfitIndex::OutfitIndex()
+        : outfitCount(0), termCount(0), termOffset(0), postingsOffset(0), postingsSize(0), namesOffset(0) {}
+
+    OutfitIndex::~OutfitIndex() {
+        Close();
+    }
+
+    bool OutfitIndex::Open(const std::string& filepath) {
+        Close();
+        if (!mapping.Open(filepath, HEADER_SIZE) || !ValidateHeader()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool OutfitIndex::ValidateHeader() {
+        const uint8_t* data = mapping.Data();
+        const uint64_t size = mapping.Size();
+        if (std::memcmp(data + H_MAGIC, MAGIC, sizeof(MAGIC)) != 0 || GetU16(data + H_VERSION) != VERSION ||
+            GetU32(data + H_BLOCK_SIZE) != BLOCK_SIZE) {
+            return false;
+        }
+
+        const uint64_t outfits = GetU64(data + H_OUTFITS);
+        const uint64_t terms = GetU64(data + H_TERMS);
+        const uint64_t termsAt = GetU64(data + H_TERM_OFFSET);
+        const uint64_t postingsAt = GetU64(data + H_POSTINGS_OFFSET);
+        const uint64_t postingBytes = GetU64(data + H_POSTINGS_SIZE);
+        const uint64_t namesAt = GetU64(data + H_NAMES_OFFSET);
+
+        // Sections must lie inside the mapping before anything is read from them
+        if (termsAt < HEADER_SIZE || termsAt > size || terms > (size - termsAt) / TERM_SIZE ||
+            postingsAt > size || postingBytes > size - postingsAt || namesAt > size ||
+            outfits >= (size - namesAt) / 4) {
+            return false;
+        }
+
+        outfitCount = static_cast<size_t>(outfits);
+        termCount = static_cast<size_t>(terms);
+        termOffset = static_cast<size_t>(termsAt);
+        postingsOffset = static_cast<size_t>(postingsAt);
+        postingsSize = static_cast<size_t>(postingBytes);
+        namesOffset = static_cast<size_t>(namesAt);
+        return true;
+    }
+
+    void OutfitIndex::Close() {
+        mapping.Close();
+        outfitCount = termCount = 0;
+    }
+
+    std::string OutfitIndex::GetName(size_t outfitId) const {
+        if (outfitId >= outfitCount) return "";
+        const uint8_t* offsets = mapping.Data() + namesOffset;
+        const size_t bytesAt = namesOffset + 4 * (outfitCount + 1);
+        const uint32_t start = GetU32(offsets + 4 * outfitId);
+        const uint32_t end = GetU32(offsets + 4 * (outfitId + 1));
+        if (start > end || end > mapping.Size() - bytesAt) return "";
+        return std::string(reinterpret_cast<const char*>(mapping.Data() + bytesAt + start), end - start);
+    }
+
+    // ============== QUERIES ==============
+    const uint8_t* OutfitIndex::TermRecord(size_t index) const {
+        return mapping.Data() + termOffset + index * TERM_SIZE;
+    }
+
+    IndexTerm OutfitIndex::TermAt(size_t index) const {
+        const uint8_t* record = TermRecord(index);
+        return IndexTerm(static_cast<IndexTerm::Kind>(record[T_KIND]), record[T_SLOT],
+                         GetI32(record + T_DRAWABLE), GetI32(record + T_TEXTURE));
+    }
+
+    size_t OutfitIndex::LowerBound(const IndexTerm& key) const {
+        size_t lo = 0, hi = termCount;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (TermAt(mid) < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    void OutfitIndex::Range(const IndexTerm& pattern, size_t& first, size_t& last) const {
+        // ANY sorts first, so a wildcard drawable spans the whole slot and a
+        // wildcard texture spans the drawable
+        IndexTerm low = pattern;
+        IndexTerm high = pattern;
+        if (pattern.drawable == IndexTerm::ANY) {
+            low.texture = IndexTerm::ANY;
+            high.drawable = INT32_MAX;
+            high.texture = INT32_MAX;
+        } else if (pattern.texture == IndexTerm::ANY) {
+            high.texture = INT32_MAX;
+        }
+        first = LowerBound(low);
+        last = first;
+        while (last < termCount && !(high < TermAt(last))) last++;
+    }
+
+    size_t OutfitIndex::EstimateCount(const IndexTerm& term) const {
+        size_t first, last, total = 0;
+        Range(term, first, last);
+        for (size_t i = first; i < last; i++) {
+            if (Matches(term, TermAt(i))) total += GetU32(TermRecord(i) + T_COUNT);
+        }
+        return total;
+    }
+
+    std::vector<uint32_t> OutfitIndex::Lookup(const IndexTerm& term) const {
+        std::vector<uint32_t> ids;
+        size_t first, last;
+        Range(term, first, last);
+
+        size_t lists = 0;
+        for (size_t i = first; i < last; i++) {
+            if (!Matches(term, TermAt(i))) continue;
+            const uint8_t* record = TermRecord(i);
+            const uint64_t offset = GetU64(record + T_OFFSET);
+            const uint32_t bytes = GetU32(record + T_BYTES);
+            if (offset > postingsSize || bytes > postingsSize - offset) continue;
+
+            PostingCursor cursor(mapping.Data() + postingsOffset + offset, bytes, GetU32(record + T_COUNT));
+            for (; cursor.Valid(); cursor.Next()) ids.push_back(cursor.Doc());
+            lists++;
+        }
+
+        // An outfit has one value per slot, so lists never overlap; only order needs fixing
+        if (lists > 1) std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::vector<uint32_t> OutfitIndex::Query(const std::vector<IndexTerm>& terms) const {
+        std::vector<PostingCursor> cursors;
+        for (const IndexTerm& term : terms) {
+            size_t first, last;
+            Range(term, first, last);
+
+            // Exact terms are walked in place; wildcard ranges are materialized
+            if (last - first == 1 && Matches(term, TermAt(first)) && term.drawable != IndexTerm::ANY &&
+                term.texture != IndexTerm::ANY) {
+                const uint8_t* record = TermRecord(first);
+                const uint64_t offset = GetU64(record + T_OFFSET);
+                const uint32_t bytes = GetU32(record + T_BYTES);
+                if (offset > postingsSize || bytes > postingsSize - offset) return {};
+                cursors.emplace_back(mapping.Data() + postingsOffset + offset, bytes, GetU32(record + T_COUNT));
+            } else {
+                cursors.emplace_back(Lookup(term));
+            }
+            if (!cursors.back().Valid()) return {};
+        }
+        return Intersect(cursors);
+    }
+
+} // namespace OutfitConverter
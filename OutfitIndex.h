@@ -0,0 +1,111 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+
+namespace OutfitConverter {
+
+    // ============== INDEX TERM ==============
+    // One (slot kind, slot, drawable, texture) key. In queries drawable
+    // and/or texture may be ANY, which matches every indexed value.
+    struct IndexTerm {
+        enum class Kind : uint8_t { COMPONENT = 0, PROP = 1 };
+        static const int32_t ANY = INT32_MIN;
+
+        Kind kind;
+        uint8_t slot;
+        int32_t drawable;
+        int32_t texture;
+
+        IndexTerm() : kind(Kind::COMPONENT), slot(0), drawable(ANY), texture(ANY) {}
+        IndexTerm(Kind k, int s, int32_t d = ANY, int32_t t = ANY)
+            : kind(k), slot(static_cast<uint8_t>(s)), drawable(d), texture(t) {}
+
+        bool operator<(const IndexTerm& other) const;
+        bool operator==(const IndexTerm& other) const {
+            return kind == other.kind && slot == other.slot &&
+                   drawable == other.drawable && texture == other.texture;
+        }
+
+        // SLOT[=DRAWABLE[:TEXTURE]] where SLOT is a Cherax slot name
+        // ("Torso", "Hat", case-insensitive) or component<N> / prop<N>
+        static bool Parse(const std::string& text, IndexTerm& term);
+        std::string ToString() const;
+    };
+
+    struct IndexBuildResult {
+        size_t outfits;
+        size_t terms;
+        size_t failed;
+        std::vector<std::string> failedItems;
+
+        IndexBuildResult() : outfits(0), terms(0), failed(0) {}
+    };
+
+    // ============== OUTFIT INDEX ==============
+    // Persistent inverted index: term -> sorted outfit ids. Outfit ids are
+    // positions in the indexed library (sorted relative paths, or record
+    // numbers of a .owb). Layout:
+    //
+    //   Header   (HEADER_SIZE bytes)
+    //   Terms    (termCount * TERM_SIZE) sorted, binary searched
+    //   Postings per term: skip table (first id + byte offset per block of
+    //            BLOCK_SIZE ids), then varint gaps for the rest of each block
+    //   Names    u32 offset per outfit + 1, then the name bytes
+    //
+    // Empty prop slots (drawable -1) are not indexed. The file is mapped
+    // read-only, so queries may run from several threads at once.
+    class OutfitIndex {
+    private:
+        MappedFile mapping;
+        size_t outfitCount;
+        size_t termCount;
+        size_t termOffset;
+        size_t postingsOffset;
+        size_t postingsSize;
+        size_t namesOffset;
+
+        bool ValidateHeader();
+        const uint8_t* TermRecord(size_t index) const;
+        IndexTerm TermAt(size_t index) const;
+        // First term not less than key
+        size_t LowerBound(const IndexTerm& key) const;
+        void Range(const IndexTerm& pattern, size_t& first, size_t& last) const;
+
+    public:
+        static const char MAGIC[4];
+        static const uint16_t VERSION = 1;
+        static const uint32_t HEADER_SIZE = 64;
+        static const uint32_t TERM_SIZE = 32;
+        static const uint32_t BLOCK_SIZE = 128;
+
+        OutfitIndex();
+        ~OutfitIndex();
+
+        OutfitIndex(const OutfitIndex&) = delete;
+        OutfitIndex& operator=(const OutfitIndex&) = delete;
+
+        // Indexes a library directory or a .owb wardrobe in parallel
+        static IndexBuildResult Build(const std::string& inputPath, const std::string& indexPath,
+                                      unsigned threads = 0);
+
+        bool Open(const std::string& filepath);
+        void Close();
+
+        size_t GetOutfitCount() const { return outfitCount; }
+        size_t GetTermCount() const { return termCount; }
+        std::string GetName(size_t outfitId) const;
+
+        // Outfits matching term (ANY fields union every matching term)
+        std::vector<uint32_t> Lookup(const IndexTerm& term) const;
+        // Upper bound on Lookup(term).size(), from the term table alone
+        size_t EstimateCount(const IndexTerm& term) const;
+        // Outfits matching every term; rarest terms are intersected first
+        std::vector<uint32_t> Query(const std::vector<IndexTerm>& terms) const;
+    };
+
+} // namespace OutfitConverter
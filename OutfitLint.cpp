@@ -0,0 +1,275 @@
+#include "OutfitLint.h"
+#include "OutfitValidation.h"
+#include "OutfitCodec.h"
+#include "OutfitDelta.h"
+#include "FormatClassifier.h"
+#include "BatchConverter.h"
+#include "FileHandler.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        const char* const ISSUE_NAMES[] = {
+            "unreadable", "unknown-format", "malformed", "out-of-range",
+            "ambiguous", "extension-mismatch", "lossy"
+        };
+        const int ISSUE_COUNT = sizeof(ISSUE_NAMES) / sizeof(ISSUE_NAMES[0]);
+
+        std::string Lowercase(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        std::string LossyNames(uint32_t lossyFormats, const char* separator) {
+            std::string text;
+            for (uint32_t format = 0; format < 32; format++) {
+                if (!(lossyFormats & (1u << format))) continue;
+                if (!text.empty()) text += separator;
+                text += FormatConverter::FormatTypeToName(static_cast<FormatConverter::FormatType>(format));
+            }
+            return text;
+        }
+
+        // CSV field, quoted only when it has to be
+        void AppendCsvText(std::string& line, const std::string& text) {
+            if (text.find_first_of(",\"\r\n") == std::string::npos) {
+                line += text;
+                return;
+            }
+            line += '"';
+            for (char c : text) {
+                if (c == '"') line += '"';
+                line += c;
+            }
+            line += '"';
+        }
+
+        // Brackets balanced and nested, strings closed, nothing after the
+        // top-level value. The JSON parsers are lenient and would otherwise
+        // accept truncated files as outfits with default slots.
+        bool IsJsonScalar(const std::string& token) {
+            if (token == "true" || token == "false" || token == "null") return true;
+            if (token.empty() || !(token[0] == '-' || std::isdigit(static_cast<unsigned char>(token[0])))) return false;
+            char* end = nullptr;
+            std::strtod(token.c_str(), &end);
+            return end == token.c_str() + token.size();
+        }
+
+        bool IsWellFormedJson(const std::string& content) {
+            std::string open;
+            bool inString = false;
+            bool closed = false;
+            for (size_t i = 0; i < content.size(); i++) {
+                const char ch = content[i];
+                if (inString) {
+                    if (ch == '\\') i++;
+                    else if (ch == '"') inString = false;
+                    continue;
+                }
+                if (std::isspace(static_cast<unsigned char>(ch))) continue;
+                if (closed) return false;
+                if (ch == '"') inString = true;
+                else if (ch == '{' || ch == '[') open += ch;
+                else if (ch == '}' || ch == ']') {
+                    if (open.empty() || open.back() != (ch == '}' ? '{' : '[')) return false;
+                    open.pop_back();
+                    closed = open.empty();
+                }
+                else if (open.empty()) return false;
+                else if (ch != ',' && ch != ':') {
+                    // Bare token: must be a number or a literal
+                    size_t end = i;
+                    while (end < content.size() && !std::isspace(static_cast<unsigned char>(content[end])) &&
+                           std::strchr(",:]}", content[end]) == nullptr) {
+                        end++;
+                    }
+                    if (!IsJsonScalar(content.substr(i, end - i))) return false;
+                    i = end - 1;
+                }
+            }
+            return closed;
+        }
+
+        std::string FormatConfidence(float confidence) {
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%.3f", confidence);
+            return buffer;
+        }
+    }
+
+    // ============== LIBRARY LINT ==============
+    LintRecord LibraryLint::Check(const std::string& content, const std::string& path, const OutfitLimits& limits,
+                                  const std::vector<FormatConverter::FormatType>& targets) {
+        LintRecord record;
+        record.path = path;
+        if (content.empty()) {
+            record.issues |= LintRecord::UNREADABLE;
+            return record;
+        }
+
+        // Classification: the winner as DetectFormat sees it, plus any
+        // runner-up that would have been accepted on its own
+        const Classification classification = FormatClassifier::Instance().Classify(content);
+        record.format = CodecRegistry::Instance().Detect(content);
+        record.confidence = classification.confidence;
+        int accepted = 0;
+        for (int score : classification.scores) {
+            if (score >= FormatClassifier::ACCEPT_SCORE) accepted++;
+        }
+        if (accepted > 1) record.issues |= LintRecord::AMBIGUOUS;
+
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(record.format);
+        if (!codec) {
+            record.issues |= LintRecord::UNKNOWN_FORMAT;
+            return record;
+        }
+        if (record.format != classification.format) record.confidence = codec->Sniff(content);
+        if (Lowercase(fs::path(path).extension().string()) != Lowercase(codec->GetExtension())) {
+            record.issues |= LintRecord::EXTENSION_MISMATCH;
+        }
+
+        YimOutfit outfit;
+        const bool json = Lowercase(codec->GetExtension()) == ".json";
+        bool decoded = false;
+        try {
+            decoded = (!json || IsWellFormedJson(content)) && codec->Decode(content, outfit);
+        } catch (const std::exception&) {
+            decoded = false;
+        }
+        if (!decoded) {
+            record.issues |= LintRecord::MALFORMED;
+            return record;
+        }
+
+        record.violations = BatchValidator::Check(outfit, limits);
+        if (record.violations != 0) record.issues |= LintRecord::OUT_OF_RANGE;
+
+        // One encode context, so Cherax and Stand share their intermediate
+        const EncodeContext context(outfit);
+        const std::vector<FormatConverter::FormatType> formats =
+            targets.empty() ? CodecRegistry::Instance().GetFormats() : targets;
+        for (FormatConverter::FormatType target : formats) {
+            const OutfitCodec* targetCodec = CodecRegistry::Instance().Get(target);
+            if (!targetCodec) continue;
+
+            YimOutfit roundTrip;
+            const std::string encoded = targetCodec->Encode(context);
+            if (encoded.empty() || !targetCodec->Decode(encoded, roundTrip) ||
+                DeltaCodec::Distance(outfit, roundTrip, 1) != 0) {
+                record.lossyFormats |= 1u << static_cast<uint32_t>(target);
+            }
+        }
+        if (record.lossyFormats != 0) record.issues |= LintRecord::LOSSY;
+        return record;
+    }
+
+    LintResult LibraryLint::Run(const std::string& inputDir, const OutfitLimits& limits,
+                                const std::vector<FormatConverter::FormatType>& targets, unsigned threads) {
+        LintResult result;
+        const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputDir);
+        result.records.resize(files.size());
+
+        ParallelFor(files.size(), threads, [&](size_t index, unsigned) {
+            const std::string content = FileHandler::ReadFileContent((fs::path(inputDir) / files[index]).string());
+            // A file that still throws (e.g. while round-tripping) is reported,
+            // not allowed to end the whole run
+            try {
+                result.records[index] = Check(content, files[index], limits, targets);
+            } catch (const std::exception&) {
+                LintRecord record;
+                record.path = files[index];
+                record.issues = LintRecord::MALFORMED;
+                result.records[index] = record;
+            }
+        });
+
+        result.scanned = files.size();
+        for (const auto& record : result.records) {
+            if (record.issues & LintRecord::ERRORS) result.errors++;
+            else if (record.issues != 0) result.warnings++;
+        }
+        return result;
+    }
+
+    std::string LibraryLint::DescribeIssues(uint32_t issues) {
+        std::string text;
+        for (int i = 0; i < ISSUE_COUNT; i++) {
+            if (!(issues & (1u << i))) continue;
+            if (!text.empty()) text += ", ";
+            text += ISSUE_NAMES[i];
+        }
+        return text;
+    }
+
+    std::string LibraryLint::FormatReport(const LintResult& result, LintReportFormat format) {
+        std::string report;
+        report.reserve(result.records.size() * 96);
+
+        if (format == LintReportFormat::CSV) {
+            report += "path,format,confidence,issues,violations,lossy\n";
+            for (const auto& record : result.records) {
+                AppendCsvText(report, record.path);
+                report += ',';
+                AppendCsvText(report, FormatConverter::FormatTypeToName(record.format));
+                report += ',';
+                report += FormatConfidence(record.confidence);
+                report += ',';
+                AppendCsvText(report, DescribeIssues(record.issues));
+                report += ',';
+                AppendCsvText(report, record.violations ? BatchValidator::Describe(record.violations) : "");
+                report += ',';
+                AppendCsvText(report, LossyNames(record.lossyFormats, ", "));
+                report += '\n';
+            }
+            return report;
+        }
+
+        // One file per line keeps the report greppable and diffable
+        report += "{\n  \"summary\": {\"scanned\": " + std::to_string(result.scanned) +
+                  ", \"errors\": " + std::to_string(result.errors) +
+                  ", \"warnings\": " + std::to_string(result.warnings) + "},\n  \"files\": [";
+        for (size_t i = 0; i < result.records.size(); i++) {
+            const LintRecord& record = result.records[i];
+            report += i == 0 ? "\n    " : ",\n    ";
+            report += "{\"path\": \"" + FileHandler::EscapeJsonString(record.path) + "\"";
+            report += ", \"format\": \"" + FormatConverter::FormatTypeToName(record.format) + "\"";
+            report += ", \"confidence\": " + FormatConfidence(record.confidence);
+            report += ", \"issues\": [";
+            bool first = true;
+            for (int bit = 0; bit < ISSUE_COUNT; bit++) {
+                if (!(record.issues & (1u << bit))) continue;
+                report += first ? "\"" : ", \"";
+                report += ISSUE_NAMES[bit];
+                report += "\"";
+                first = false;
+            }
+            report += "]";
+            if (record.violations != 0) {
+                report += ", \"violations\": \"" + BatchValidator::Describe(record.violations) + "\"";
+            }
+            if (record.lossyFormats != 0) {
+                report += ", \"lossy\": [\"" + LossyNames(record.lossyFormats, "\", \"") + "\"]";
+            }
+            report += "}";
+        }
+        report += result.records.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return report;
+    }
+
+    bool LibraryLint::WriteReport(const std::string& filepath, const LintResult& result, LintReportFormat format) {
+        return FileHandler::WriteFileContent(filepath, FormatReport(result, format));
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,69 @@
+#pragma once
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    class OutfitLimits;
+
+    // ============== LINT RECORD ==============
+    struct LintRecord {
+        // Issues. The first four are errors, the rest warnings.
+        static const uint32_t UNREADABLE = 1;
+        static const uint32_t UNKNOWN_FORMAT = 2;      // No format passes the classifier
+        static const uint32_t MALFORMED = 4;           // Fails to decode, or JSON that is not well-formed
+        static const uint32_t OUT_OF_RANGE = 8;        // Outside the limits, see BatchValidator
+        static const uint32_t AMBIGUOUS = 16;          // A second format also passes the classifier
+        static const uint32_t EXTENSION_MISMATCH = 32; // Extension differs from the detected format's
+        static const uint32_t LOSSY = 64;              // Changes on a round trip through a target format
+        static const uint32_t ERRORS = UNREADABLE | UNKNOWN_FORMAT | MALFORMED | OUT_OF_RANGE;
+
+        std::string path;       // Relative to the library root
+        FormatConverter::FormatType format;
+        float confidence;       // Classification confidence
+        uint32_t issues;
+        uint64_t violations;    // BatchValidator bits (OUT_OF_RANGE)
+        uint32_t lossyFormats;  // Bit per FormatType whose round trip changes the outfit (LOSSY)
+
+        LintRecord() : format(FormatConverter::FormatType::UNKNOWN), confidence(0.0f), issues(0),
+            violations(0), lossyFormats(0) {}
+    };
+
+    struct LintResult {
+        size_t scanned;
+        size_t errors;      // Files with any error issue
+        size_t warnings;    // Files with only warning issues
+        std::vector<LintRecord> records;    // Every file, in library order
+
+        LintResult() : scanned(0), errors(0), warnings(0) {}
+    };
+
+    enum class LintReportFormat {
+        JSON,   // {"summary": {...}, "files": [{...}, ...]}
+        CSV     // path,format,confidence,issues,violations,lossy
+    };
+
+    // ============== LIBRARY LINT ==============
+    // Checks every file of a library in parallel: classification, decoding,
+    // limits, and a round trip of the decoded outfit through each target
+    // format (encode, then decode with the same codec).
+    class LibraryLint {
+    public:
+        // targets: formats to round-trip through; empty means every registered format
+        static LintResult Run(const std::string& inputDir, const OutfitLimits& limits,
+                              const std::vector<FormatConverter::FormatType>& targets, unsigned threads = 0);
+
+        static LintRecord Check(const std::string& content, const std::string& path, const OutfitLimits& limits,
+                                const std::vector<FormatConverter::FormatType>& targets);
+
+        // "malformed, ambiguous"
+        static std::string DescribeIssues(uint32_t issues);
+
+        static std::string FormatReport(const LintResult& result, LintReportFormat format);
+        static bool WriteReport(const std::string& filepath, const LintResult& result, LintReportFormat format);
+    };
+
+} // namespace OutfitConverter
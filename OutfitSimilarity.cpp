@@ -0,0 +1,367 @@
+#include "OutfitSimilarity.h"
+#include "WardrobeContainer.h"
+#include "FormatConverter.h"
+#include "BatchConverter.h"
+#include "ContentHash.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    namespace {
+
+        const int COMPONENT_SLOTS = 12;
+        const int SLOTS = 21;
+        const size_t BLOCK = 16384;     // Outfits per parallel scan task
+        const uint64_t LOW7 = 0x7F7F7F7F7F7F7F7FULL;
+        const uint64_t HIGH1 = 0x8080808080808080ULL;
+
+        // ============== POPCOUNT ==============
+#if defined(_MSC_VER) && defined(_M_X64)
+        inline uint32_t PopCount(uint64_t x) { return static_cast<uint32_t>(__popcnt64(x)); }
+#elif defined(__GNUC__)
+        inline uint32_t PopCount(uint64_t x) { return static_cast<uint32_t>(__builtin_popcountll(x)); }
+#else
+        inline uint32_t PopCount(uint64_t x) {
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<uint32_t>((x * 0x0101010101010101ULL) >> 56);
+        }
+#endif
+
+        // Better match first: higher score, then lower id
+        bool Better(const SimilarityMatch& a, const SimilarityMatch& b) {
+            return a.score != b.score ? a.score > b.score : a.id < b.id;
+        }
+
+        struct ScanContext {
+            const OutfitSignature* signatures;
+            const int32_t* values;
+            const uint32_t* models;
+            const uint8_t* wordWeight;
+            const uint8_t* slotWeight;
+            OutfitSignature query;
+            const int32_t* queryValues;
+            uint32_t model;
+            bool sameModel;
+            int64_t exclude;
+            size_t k;
+            // Highest k-th best score any block has reached; a bound below it
+            // cannot make the global top k
+            std::atomic<uint32_t>* floor;
+        };
+
+        inline uint32_t Exact(const int32_t* a, const int32_t* b, const uint8_t* slotWeight) {
+            uint32_t score = 0;
+            for (int slot = 0; slot < SLOTS; slot++) {
+                const int32_t* x = a + 2 * slot;
+                const int32_t* y = b + 2 * slot;
+                if (x[0] == INT32_MIN || y[0] == INT32_MIN || x[0] != y[0]) continue;
+                score += slotWeight[slot] * (x[1] == y[1] ? 2u : 1u);
+            }
+            return score;
+        }
+
+        // Keeps the k best of [begin, end) in heap (worst on top). Always
+        // inlined so each dispatch target below gets its own popcount code.
+#if defined(__GNUC__)
+        __attribute__((always_inline))
+#endif
+        inline void ScanBody(const ScanContext& ctx, size_t begin, size_t end, std::vector<SimilarityMatch>& heap) {
+            // Locals, so heap writes cannot force reloads of the query every iteration
+            uint64_t query[8];
+            uint64_t occupied[8];       // High bit of every nonzero query byte
+            uint32_t wordWeight[8];
+            for (int w = 0; w < 8; w++) {
+                query[w] = ctx.query.words[w];
+                occupied[w] = (((query[w] & LOW7) + LOW7) | query[w]) & HIGH1;
+                wordWeight[w] = ctx.wordWeight[w];
+            }
+            const OutfitSignature* signatures = ctx.signatures;
+            const size_t k = ctx.k;
+
+            // Smallest bound that can still matter: one above this block's k-th
+            // best once the heap is full (ids only grow within a block, so an
+            // equal bound loses the tie), and never below the shared floor
+            uint32_t cutoff = 0;
+
+            for (size_t i = begin; i < end; i++) {
+                if ((i & 1023) == 0) cutoff = std::max(cutoff, ctx.floor->load(std::memory_order_relaxed));
+
+                const uint64_t* words = signatures[i].words;
+                uint32_t bound = 0;
+                for (int w = 0; w < 8; w++) {
+                    // High bit set in every byte equal to the query's (SWAR zero-byte test)
+                    const uint64_t diff = words[w] ^ query[w];
+                    const uint64_t equal = ~(((diff & LOW7) + LOW7) | diff | LOW7);
+                    bound += wordWeight[w] * PopCount(equal & occupied[w]);
+                }
+                if (bound < cutoff) continue;
+
+                if (ctx.sameModel && ctx.models[i] != ctx.model) continue;
+                if (static_cast<int64_t>(i) == ctx.exclude) continue;
+
+                SimilarityMatch match;
+                match.id = static_cast<uint32_t>(i);
+                match.score = Exact(ctx.values + i * 2 * SLOTS, ctx.queryValues, ctx.slotWeight);
+                if (heap.size() < k) {
+                    heap.push_back(match);
+                    std::push_heap(heap.begin(), heap.end(), Better);
+                } else if (Better(match, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), Better);
+                    heap.back() = match;
+                    std::push_heap(heap.begin(), heap.end(), Better);
+                }
+                if (heap.size() == k && heap.front().score + 1 > cutoff) {
+                    const uint32_t worst = heap.front().score;
+                    cutoff = worst + 1;
+                    uint32_t current = ctx.floor->load(std::memory_order_relaxed);
+                    while (current < worst &&
+                           !ctx.floor->compare_exchange_weak(current, worst, std::memory_order_relaxed)) {}
+                }
+            }
+        }
+
+        void ScanGeneric(const ScanContext& ctx, size_t begin, size_t end, std::vector<SimilarityMatch>& heap) {
+            ScanBody(ctx, begin, end, heap);
+        }
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        // Same loop built for the POPCNT instruction, chosen at run time so
+        // the default build still runs on CPUs without it
+        __attribute__((target("popcnt")))
+        void ScanPopcnt(const ScanContext& ctx, size_t begin, size_t end, std::vector<SimilarityMatch>& heap) {
+            ScanBody(ctx, begin, end, heap);
+        }
+
+        bool HasPopcnt() {
+            static const bool supported = __builtin_cpu_supports("popcnt");
+            return supported;
+        }
+#endif
+
+        void Scan(const ScanContext& ctx, size_t begin, size_t end, std::vector<SimilarityMatch>& heap) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            if (HasPopcnt()) {
+                ScanPopcnt(ctx, begin, end, heap);
+                return;
+            }
+#endif
+            ScanGeneric(ctx, begin, end, heap);
+        }
+    }
+
+    // ============== SLOT WEIGHTS ==============
+    SlotWeights::SlotWeights() {
+        std::fill(component, component + 12, static_cast<uint8_t>(1));
+        std::fill(prop, prop + 9, static_cast<uint8_t>(1));
+        component[SLOT_JACKET] = 4;
+        component[SLOT_TORSO] = 3;
+        component[SLOT_LEGS] = 3;
+        component[SLOT_FEET] = 3;
+        component[SLOT_HAIR] = 2;
+        component[SLOT_SPECIAL] = 2;
+        prop[PROP_HEAD] = 2;
+        prop[PROP_EYES] = 2;
+    }
+
+    // ============== SIMILARITY INDEX ==============
+    SimilarityIndex::SimilarityIndex(const SlotWeights& slotWeights) : weights(slotWeights) {
+        std::memset(wordWeight, 0, sizeof(wordWeight));
+        std::memset(slotWord, 0, sizeof(slotWord));
+        std::memset(slotShift, 0, sizeof(slotShift));
+
+        // Four 16-bit lanes per word, heaviest slots first; a word never mixes
+        // weights. With weights 1..4 this needs at most 8 words.
+        int word = -1;
+        int lane = 4;
+        for (int weight = SlotWeights::MAX_WEIGHT; weight >= 1; weight--) {
+            lane = 4;
+            for (int slot = 0; slot < SLOTS; slot++) {
+                const uint8_t w = slot < COMPONENT_SLOTS ? weights.component[slot]
+                                                         : weights.prop[slot - COMPONENT_SLOTS];
+                if (std::min<int>(w, SlotWeights::MAX_WEIGHT) != weight) continue;
+                if (lane == 4) {
+                    word++;
+                    lane = 0;
+                    wordWeight[word] = static_cast<uint8_t>(weight);
+                }
+                slotWord[slot] = static_cast<uint8_t>(word);
+                slotShift[slot] = static_cast<uint8_t>(16 * lane++);
+            }
+        }
+        for (int i = 0; i < 12; i++) weights.component[i] = std::min(weights.component[i], SlotWeights::MAX_WEIGHT);
+        for (int i = 0; i < 9; i++) weights.prop[i] = std::min(weights.prop[i], SlotWeights::MAX_WEIGHT);
+    }
+
+    void SimilarityIndex::Flatten(const YimOutfit& outfit, int32_t* slotValues) const {
+        for (int slot = 0; slot < SLOTS; slot++) {
+            slotValues[2 * slot] = ABSENT;
+            slotValues[2 * slot + 1] = 0;
+        }
+        for (const auto& pair : outfit.components) {
+            if (pair.first < 0 || pair.first >= COMPONENT_SLOTS || pair.second.drawable == ABSENT) continue;
+            slotValues[2 * pair.first] = pair.second.drawable;
+            slotValues[2 * pair.first + 1] = pair.second.texture;
+        }
+        for (const auto& pair : outfit.props) {
+            const int slot = COMPONENT_SLOTS + pair.first;
+            if (pair.first < 0 || slot >= SLOTS || pair.second.drawable == -1 || pair.second.drawable == ABSENT) {
+                continue;
+            }
+            slotValues[2 * slot] = pair.second.drawable;
+            slotValues[2 * slot + 1] = pair.second.texture;
+        }
+    }
+
+    OutfitSignature SimilarityIndex::Sign(const YimOutfit& outfit) const {
+        int32_t slotValues[2 * SLOTS];
+        Flatten(outfit, slotValues);
+
+        OutfitSignature signature;
+        std::memset(signature.words, 0, sizeof(signature.words));
+        for (int slot = 0; slot < SLOTS; slot++) {
+            const uint8_t w = slot < COMPONENT_SLOTS ? weights.component[slot] : weights.prop[slot - COMPONENT_SLOTS];
+            const int32_t drawable = slotValues[2 * slot];
+            if (w == 0 || drawable == ABSENT) continue;
+
+            const uint64_t slotKey = static_cast<uint64_t>(slot) << 56;
+            const uint64_t drawableKey = MixHash(slotKey | static_cast<uint32_t>(drawable));
+            const uint64_t fullKey = MixHash(drawableKey ^ static_cast<uint32_t>(slotValues[2 * slot + 1]));
+
+            // Nonzero bytes, so an occupied lane never equals an empty one
+            const uint64_t lane = (1 + drawableKey % 255) | ((1 + fullKey % 255) << 8);
+            signature.words[slotWord[slot]] |= lane << slotShift[slot];
+        }
+        return signature;
+    }
+
+    uint32_t SimilarityIndex::ExactScore(const int32_t* a, const int32_t* b) const {
+        uint8_t slotWeight[SLOTS];
+        std::memcpy(slotWeight, weights.component, 12);
+        std::memcpy(slotWeight + 12, weights.prop, 9);
+        return Exact(a, b, slotWeight);
+    }
+
+    uint32_t SimilarityIndex::Score(const YimOutfit& a, const YimOutfit& b) const {
+        int32_t x[2 * SLOTS], y[2 * SLOTS];
+        Flatten(a, x);
+        Flatten(b, y);
+        return ExactScore(x, y);
+    }
+
+    void SimilarityIndex::Reserve(size_t count) {
+        signatures.reserve(count);
+        values.reserve(count * 2 * SLOTS);
+        models.reserve(count);
+    }
+
+    uint32_t SimilarityIndex::Add(const YimOutfit& outfit) {
+        const size_t at = values.size();
+        values.resize(at + 2 * SLOTS);
+        Flatten(outfit, values.data() + at);
+        signatures.push_back(Sign(outfit));
+        models.push_back(outfit.model);
+        return static_cast<uint32_t>(models.size() - 1);
+    }
+
+    void SimilarityIndex::Clear() {
+        signatures.clear();
+        values.clear();
+        models.clear();
+    }
+
+    bool SimilarityIndex::AddLibrary(const std::string& inputPath, std::vector<std::string>& names,
+                                     unsigned threads) {
+        std::error_code ec;
+        if (!fs::is_directory(inputPath, ec)) {
+            WardrobeFile wardrobe;
+            if (!wardrobe.Open(inputPath)) return false;
+            Reserve(Size() + wardrobe.GetCount());
+            YimOutfit outfit;
+            for (size_t i = 0; i < wardrobe.GetCount(); i++) {
+                wardrobe.Get(i, outfit);
+                Add(outfit);
+                names.push_back(wardrobe.GetName(i));
+            }
+            return true;
+        }
+
+        // Parse in parallel a chunk at a time; unreadable files are left out
+        const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputPath);
+        const size_t CHUNK = 4096;
+        std::vector<YimOutfit> outfits;
+        std::vector<char> loaded;
+        bool complete = true;
+        for (size_t base = 0; base < files.size(); base += CHUNK) {
+            const size_t chunk = std::min(CHUNK, files.size() - base);
+            outfits.assign(chunk, YimOutfit());
+            loaded.assign(chunk, 0);
+            ParallelFor(chunk, threads, [&](size_t index, unsigned) {
+                const std::string path = (fs::path(inputPath) / files[base + index]).string();
+                loaded[index] = FormatConverter::LoadAsYim(
+                    path, FormatConverter::DetectFormat(path), outfits[index]) ? 1 : 0;
+            });
+            for (size_t i = 0; i < chunk; i++) {
+                if (!loaded[i]) {
+                    complete = false;
+                    continue;
+                }
+                Add(outfits[i]);
+                names.push_back(files[base + i]);
+            }
+        }
+        return complete;
+    }
+
+    std::vector<SimilarityMatch> SimilarityIndex::TopK(const YimOutfit& query, size_t k, unsigned threads,
+                                                       bool sameModel, int64_t exclude) const {
+        std::vector<SimilarityMatch> result;
+        if (k == 0 || models.empty()) return result;
+
+        int32_t queryValues[2 * SLOTS];
+        Flatten(query, queryValues);
+        uint8_t slotWeight[SLOTS];
+        std::memcpy(slotWeight, weights.component, 12);
+        std::memcpy(slotWeight + 12, weights.prop, 9);
+
+        ScanContext ctx;
+        ctx.signatures = signatures.data();
+        ctx.values = values.data();
+        ctx.models = models.data();
+        ctx.wordWeight = wordWeight;
+        ctx.slotWeight = slotWeight;
+        ctx.query = Sign(query);
+        ctx.queryValues = queryValues;
+        ctx.model = query.model;
+        ctx.sameModel = sameModel;
+        ctx.exclude = exclude;
+        ctx.k = k;
+        std::atomic<uint32_t> floor(0);
+        ctx.floor = &floor;
+
+        // Each block keeps its own top k; the blocks' winners are merged
+        const size_t blocks = (models.size() + BLOCK - 1) / BLOCK;
+        std::vector<std::vector<SimilarityMatch>> heaps(blocks);
+        ParallelFor(blocks, threads, [&](size_t block, unsigned) {
+            heaps[block].reserve(k);
+            Scan(ctx, block * BLOCK, std::min(models.size(), (block + 1) * BLOCK), heaps[block]);
+        });
+
+        for (const auto& heap : heaps) result.insert(result.end(), heap.begin(), heap.end());
+        std::sort(result.begin(), result.end(), Better);
+        if (result.size() > k) result.resize(k);
+        return result;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,83 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+
+namespace OutfitConverter {
+
+    // ============== SLOT WEIGHTS ==============
+    // Importance of each slot in similarity scores, 0 (ignored) to MAX_WEIGHT.
+    // Defaults favour the slots that define a look (jacket, torso, legs, feet).
+    struct SlotWeights {
+        static constexpr uint8_t MAX_WEIGHT = 4;
+
+        uint8_t component[12];
+        uint8_t prop[9];
+
+        SlotWeights();
+    };
+
+    // ============== OUTFIT SIGNATURE ==============
+    // One cache line per outfit. Every weighted slot owns a 16-bit lane
+    // holding a nonzero 8-bit hash of its drawable and one of its
+    // drawable+texture (empty slots stay zero). Lanes are grouped so each
+    // word holds slots of a single weight; the weighted popcount of equal
+    // bytes is then an upper bound on the exact score.
+    struct OutfitSignature {
+        uint64_t words[8];
+    };
+
+    struct SimilarityMatch {
+        uint32_t id;
+        uint32_t score;
+    };
+
+    // ============== SIMILARITY INDEX ==============
+    // Exact score of two outfits: per slot present in both, 2 * weight when
+    // drawable and texture match, weight when only the drawable does.
+    // TopK scans signatures with hardware popcount where available and only
+    // computes exact scores for outfits whose bound can still make the top k,
+    // so results are exact.
+    class SimilarityIndex {
+    private:
+        static const int SLOTS = 21;        // 12 components, then 9 props
+        static const int32_t ABSENT = INT32_MIN;
+
+        SlotWeights weights;
+        uint8_t wordWeight[8];
+        uint8_t slotWord[SLOTS];
+        uint8_t slotShift[SLOTS];
+
+        std::vector<OutfitSignature> signatures;
+        std::vector<int32_t> values;        // Per outfit: SLOTS x (drawable, texture)
+        std::vector<uint32_t> models;
+
+        void Flatten(const YimOutfit& outfit, int32_t* slotValues) const;
+        uint32_t ExactScore(const int32_t* a, const int32_t* b) const;
+
+    public:
+        explicit SimilarityIndex(const SlotWeights& slotWeights = SlotWeights());
+
+        void Reserve(size_t count);
+        uint32_t Add(const YimOutfit& outfit);
+        void Clear();
+        size_t Size() const { return models.size(); }
+
+        // Adds every outfit of a library directory or .owb wardrobe in id
+        // order; names receives each outfit's relative path or record name
+        bool AddLibrary(const std::string& inputPath, std::vector<std::string>& names, unsigned threads = 0);
+
+        OutfitSignature Sign(const YimOutfit& outfit) const;
+        uint32_t Score(const YimOutfit& a, const YimOutfit& b) const;
+
+        // Best k matches, highest score first (ties by lower id). sameModel
+        // restricts matches to the query's model; exclude skips one id
+        // (typically the query itself).
+        std::vector<SimilarityMatch> TopK(const YimOutfit& query, size_t k, unsigned threads = 0,
+                                          bool sameModel = false, int64_t exclude = -1) const;
+    };
+
+} // namespace OutfitConverter
@@ -14,6 +14,11 @@ namespace OutfitConverter {
 
         Component() : drawable(0), texture(0), palette(0) {}
         Component(int d, int t, int p = 0) : drawable(d), texture(t), palette(p) {}
+
+        bool operator==(const Component& other) const {
+            return drawable == other.drawable && texture == other.texture && palette == other.palette;
+        }
+        bool operator!=(const Component& other) const { return !(*this == other); }
     };
 
     struct Prop {
@@ -22,6 +27,11 @@ namespace OutfitConverter {
 
         Prop() : drawable(-1), texture(-1) {}
         Prop(int d, int t) : drawable(d), texture(t) {}
+
+        bool operator==(const Prop& other) const {
+            return drawable == other.drawable && texture == other.texture;
+        }
+        bool operator!=(const Prop& other) const { return !(*this == other); }
     };
 
     // ============== CHERAX FORMAT ==============
@@ -64,6 +74,16 @@ namespace OutfitConverter {
         BlendData() : is_parent(0), shape_first_id(0), shape_mix(0.0f),
             shape_second_id(0), shape_third_id(0), skin_first_id(31),
             skin_mix(0.5f), skin_second_id(43), skin_third_id(0), third_mix(0.0f) {}
+
+        // Exact, mixes included: any change to the stored floats is a change
+        bool operator==(const BlendData& other) const {
+            return is_parent == other.is_parent &&
+                   shape_first_id == other.shape_first_id && shape_second_id == other.shape_second_id &&
+                   shape_third_id == other.shape_third_id && skin_first_id == other.skin_first_id &&
+                   skin_second_id == other.skin_second_id && skin_third_id == other.skin_third_id &&
+                   shape_mix == other.shape_mix && skin_mix == other.skin_mix && third_mix == other.third_mix;
+        }
+        bool operator!=(const BlendData& other) const { return !(*this == other); }
     };
 
     struct YimOutfit {
@@ -0,0 +1,352 @@
+#include "OutfitTable.h"
+#include "OutfitIndex.h"
+#include "OutfitView.h"
+#include "WardrobeContainer.h"
+#include "FormatConverter.h"
+#include "BatchConverter.h"
+#include "Parallel.h"
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    // ============== COLUMN KERNELS ==============
+    namespace {
+
+        // Bounds wide enough for any int32 or uint32 column value
+        const int64_t UNBOUNDED_LOW = -(int64_t(1) << 40);
+        const int64_t UNBOUNDED_HIGH = int64_t(1) << 40;
+
+        const char* const ATTRIBUTES[3] = { "drawable", "texture", "palette" };
+
+        template <typename T>
+        ColumnStats MinMaxKernel(const T* values, size_t count, const uint8_t* mask) {
+            ColumnStats stats;
+            T low = std::numeric_limits<T>::max();
+            T high = std::numeric_limits<T>::min();
+            size_t selected = count;
+            if (mask == nullptr) {
+                for (size_t i = 0; i < count; i++) {
+                    low = std::min(low, values[i]);
+                    high = std::max(high, values[i]);
+                }
+            } else {
+                // Branch-free: unselected rows contribute the identity
+                selected = 0;
+                for (size_t i = 0; i < count; i++) {
+                    const bool on = mask[i] != 0;
+                    low = std::min(low, on ? values[i] : std::numeric_limits<T>::max());
+                    high = std::max(high, on ? values[i] : std::numeric_limits<T>::min());
+                    selected += on;
+                }
+            }
+            stats.count = selected;
+            if (selected > 0) {
+                stats.min = low;
+                stats.max = high;
+            }
+            return stats;
+        }
+
+        template <typename T>
+        void HistogramKernel(const T* values, size_t count, const uint8_t* mask,
+                             const ColumnStats& stats, std::vector<ValueCount>& result) {
+            if (stats.count == 0) return;
+
+            // Dense counting when the value range is small (slot values are),
+            // sorting otherwise
+            const uint64_t range = static_cast<uint64_t>(stats.max - stats.min) + 1;
+            if (range <= (uint64_t(1) << 22)) {
+                std::vector<uint32_t> counts(static_cast<size_t>(range), 0);
+                const int64_t base = stats.min;
+                if (mask == nullptr) {
+                    for (size_t i = 0; i < count; i++) counts[static_cast<size_t>(values[i] - base)]++;
+                } else {
+                    for (size_t i = 0; i < count; i++) {
+                        const int64_t value = mask[i] ? static_cast<int64_t>(values[i]) : base;
+                        counts[static_cast<size_t>(value - base)] += mask[i] != 0;
+                    }
+                }
+                for (size_t i = 0; i < counts.size(); i++) {
+                    if (counts[i] > 0) result.push_back({ base + static_cast<int64_t>(i), counts[i] });
+                }
+                return;
+            }
+
+            std::vector<T> sorted;
+            sorted.reserve(stats.count);
+            for (size_t i = 0; i < count; i++) {
+                if (mask == nullptr || mask[i]) sorted.push_back(values[i]);
+            }
+            std::sort(sorted.begin(), sorted.end());
+            for (size_t i = 0; i < sorted.size();) {
+                size_t j = i;
+                while (j < sorted.size() && sorted[j] == sorted[i]) j++;
+                result.push_back({ static_cast<int64_t>(sorted[i]), j - i });
+                i = j;
+            }
+        }
+
+        // mask[i] = low <= values[i] <= high, as one unsigned compare
+        template <typename T>
+        size_t RangeKernel(const T* values, size_t count, int64_t low, int64_t high, uint8_t* mask) {
+            if (low > high) {
+                std::fill(mask, mask + count, 0);
+                return 0;
+            }
+            const uint64_t span = static_cast<uint64_t>(high - low);
+            size_t selected = 0;
+            for (size_t i = 0; i < count; i++) {
+                const uint8_t on = static_cast<uint64_t>(static_cast<int64_t>(values[i]) - low) <= span;
+                mask[i] = on;
+                selected += on;
+            }
+            return selected;
+        }
+
+        // Integer range equivalent to comparing an integer column with a
+        // (possibly fractional) filter constant
+        void ComparisonRange(OutfitFilter::Op op, double value, int64_t& low, int64_t& high) {
+            low = UNBOUNDED_LOW;
+            high = UNBOUNDED_HIGH;
+            const double clamped = std::max(std::min(value, double(UNBOUNDED_HIGH)), double(UNBOUNDED_LOW));
+            const int64_t floorValue = static_cast<int64_t>(std::floor(clamped));
+            const int64_t ceilValue = static_cast<int64_t>(std::ceil(clamped));
+            switch (op) {
+            case OutfitFilter::Op::EQ:
+            case OutfitFilter::Op::NE:
+                low = ceilValue;
+                high = floorValue;      // Empty for fractional values
+                break;
+            case OutfitFilter::Op::LT: high = ceilValue - 1; break;
+            case OutfitFilter::Op::LE: high = floorValue; break;
+            case OutfitFilter::Op::GT: low = floorValue + 1; break;
+            case OutfitFilter::Op::GE: low = ceilValue; break;
+            default: break;
+            }
+        }
+    }
+
+    // ============== COLUMNS ==============
+    bool OutfitTable::ParseColumn(const std::string& name, size_t& column) {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (lower == "model") {
+            column = MODEL_COLUMN;
+            return true;
+        }
+        if (name.find('=') != std::string::npos) return false;
+
+        int attribute = 0;
+        std::string slotName = name;
+        const size_t dot = lower.rfind('.');
+        if (dot != std::string::npos) {
+            const std::string suffix = lower.substr(dot + 1);
+            attribute = -1;
+            for (int i = 0; i < 3; i++) {
+                if (suffix == ATTRIBUTES[i]) attribute = i;
+            }
+            if (attribute < 0) return false;
+            slotName = name.substr(0, dot);
+        }
+
+        IndexTerm term;
+        if (!IndexTerm::Parse(slotName, term)) return false;
+        if (term.kind == IndexTerm::Kind::COMPONENT) {
+            column = ComponentColumn(term.slot, attribute);
+            return true;
+        }
+        if (attribute == 2) return false;   // Props have no palette
+        column = PropColumn(term.slot, attribute);
+        return true;
+    }
+
+    std::string OutfitTable::ColumnName(size_t column) {
+        if (column == MODEL_COLUMN) return "model";
+        const bool component = column < OutfitFilter::FIELD_PROPS;
+        const size_t offset = column - (component ? OutfitFilter::FIELD_COMPONENTS : OutfitFilter::FIELD_PROPS);
+        const int slot = static_cast<int>(offset / (component ? 3 : 2));
+        const int attribute = static_cast<int>(offset % (component ? 3 : 2));
+
+        std::string name = (component ? "component" : "prop") + std::to_string(slot);
+        for (const auto& pair : component ? ComponentMapping::CHERAX_COMPONENT_MAP : ComponentMapping::CHERAX_PROP_MAP) {
+            if (pair.second == slot) name = pair.first;
+        }
+        return name + "." + ATTRIBUTES[attribute];
+    }
+
+    // ============== LOADING ==============
+    void OutfitTable::Reserve(size_t rows) {
+        models.reserve(rows);
+        for (auto& column : slots) column.reserve(rows);
+        names.reserve(rows);
+    }
+
+    void OutfitTable::Clear() {
+        models.clear();
+        for (auto& column : slots) column.clear();
+        names.clear();
+    }
+
+    void OutfitTable::Append(const YimOutfit& outfit, const std::string& name) {
+        models.push_back(outfit.model);
+        for (int slot = 0; slot < 12; slot++) {
+            const auto it = outfit.components.find(slot);
+            const Component component = it != outfit.components.end() ? it->second : Component();
+            slots[ComponentColumn(slot, 0) - 1].push_back(component.drawable);
+            slots[ComponentColumn(slot, 1) - 1].push_back(component.texture);
+            slots[ComponentColumn(slot, 2) - 1].push_back(component.palette);
+        }
+        for (int slot = 0; slot < 9; slot++) {
+            const auto it = outfit.props.find(slot);
+            const Prop prop = it != outfit.props.end() ? it->second : Prop();
+            slots[PropColumn(slot, 0) - 1].push_back(prop.drawable);
+            slots[PropColumn(slot, 1) - 1].push_back(prop.texture);
+        }
+        names.push_back(name);
+    }
+
+    bool OutfitTable::Load(const std::string& inputPath, unsigned threads) {
+        std::error_code ec;
+        if (!fs::is_directory(inputPath, ec)) {
+            WardrobeFile wardrobe;
+            if (!wardrobe.Open(inputPath)) return false;
+            Reserve(Size() + wardrobe.GetCount());
+            YimOutfit outfit;
+            for (size_t i = 0; i < wardrobe.GetCount(); i++) {
+                wardrobe.Get(i, outfit);
+                Append(outfit, wardrobe.GetName(i));
+            }
+            return true;
+        }
+
+        // Parse in parallel a chunk at a time, skipping blend data
+        const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputPath);
+        Reserve(Size() + files.size());
+        const size_t CHUNK = 4096;
+        const unsigned fields = OutfitView::FIELD_MODEL | OutfitView::FIELD_COMPONENTS | OutfitView::FIELD_PROPS;
+        std::vector<YimOutfit> outfits;
+        std::vector<char> loaded;
+        bool complete = true;
+        for (size_t base = 0; base < files.size(); base += CHUNK) {
+            const size_t chunk = std::min(CHUNK, files.size() - base);
+            outfits.assign(chunk, YimOutfit());
+            loaded.assign(chunk, 0);
+            ParallelFor(chunk, threads, [&](size_t index, unsigned) {
+                OutfitView view;
+                loaded[index] = view.Open((fs::path(inputPath) / files[base + index]).string()) &&
+                                view.ToYim(outfits[index], fields) ? 1 : 0;
+            });
+            for (size_t i = 0; i < chunk; i++) {
+                if (!loaded[i]) {
+                    complete = false;
+                    continue;
+                }
+                Append(outfits[i], files[base + i]);
+            }
+        }
+        return complete;
+    }
+
+    int64_t OutfitTable::GetValue(size_t row, size_t column) const {
+        return column == MODEL_COLUMN ? static_cast<int64_t>(models[row]) : slots[column - 1][row];
+    }
+
+    // ============== KERNELS ==============
+    ColumnStats OutfitTable::MinMax(size_t column, const std::vector<uint8_t>* mask) const {
+        const uint8_t* rows = mask ? mask->data() : nullptr;
+        return column == MODEL_COLUMN ? MinMaxKernel(models.data(), Size(), rows)
+                                      : MinMaxKernel(slots[column - 1].data(), Size(), rows);
+    }
+
+    std::vector<ValueCount> OutfitTable::Histogram(size_t column, const std::vector<uint8_t>* mask) const {
+        std::vector<ValueCount> result;
+        const uint8_t* rows = mask ? mask->data() : nullptr;
+        const ColumnStats stats = MinMax(column, mask);
+        if (column == MODEL_COLUMN) {
+            HistogramKernel(models.data(), Size(), rows, stats, result);
+        } else {
+            HistogramKernel(slots[column - 1].data(), Size(), rows, stats, result);
+        }
+        return result;
+    }
+
+    size_t OutfitTable::SelectRange(size_t column, int64_t low, int64_t high, std::vector<uint8_t>& mask) const {
+        mask.resize(Size());
+        return column == MODEL_COLUMN ? RangeKernel(models.data(), Size(), low, high, mask.data())
+                                      : RangeKernel(slots[column - 1].data(), Size(), low, high, mask.data());
+    }
+
+    bool OutfitTable::Select(const OutfitFilter& filter, std::vector<uint8_t>& mask, size_t* selected) const {
+        typedef OutfitFilter::Op Op;
+        const std::vector<OutfitFilter::Instruction>& program = filter.GetProgram();
+        for (const auto& instruction : program) {
+            if (instruction.op < Op::AND && instruction.field >= COLUMN_COUNT) return false;
+        }
+
+        const size_t rows = Size();
+        std::vector<std::vector<uint8_t>> stack;
+        std::vector<uint8_t> scratch;
+        for (const auto& instruction : program) {
+            if (instruction.op == Op::AND || instruction.op == Op::OR) {
+                std::vector<uint8_t> right = std::move(stack.back());
+                stack.pop_back();
+                uint8_t* left = stack.back().data();
+                if (instruction.op == Op::AND) {
+                    for (size_t i = 0; i < rows; i++) left[i] &= right[i];
+                } else {
+                    for (size_t i = 0; i < rows; i++) left[i] |= right[i];
+                }
+                continue;
+            }
+            if (instruction.op == Op::NOT) {
+                uint8_t* top = stack.back().data();
+                for (size_t i = 0; i < rows; i++) top[i] ^= 1;
+                continue;
+            }
+
+            stack.emplace_back(rows, 0);
+            std::vector<uint8_t>& result = stack.back();
+            if (instruction.op == Op::IN_SET) {
+                for (double value : filter.GetSet(static_cast<size_t>(instruction.high))) {
+                    int64_t low, high;
+                    ComparisonRange(Op::EQ, value, low, high);
+                    SelectRange(instruction.field, low, high, scratch);
+                    for (size_t i = 0; i < rows; i++) result[i] |= scratch[i];
+                }
+                continue;
+            }
+
+            int64_t low, high;
+            if (instruction.op == Op::IN_RANGE) {
+                low = static_cast<int64_t>(std::ceil(std::max(instruction.low, double(UNBOUNDED_LOW))));
+                high = static_cast<int64_t>(std::floor(std::min(instruction.high, double(UNBOUNDED_HIGH))));
+            } else {
+                ComparisonRange(instruction.op, instruction.low, low, high);
+            }
+            SelectRange(instruction.field, low, high, result);
+            if (instruction.op == Op::NE) {
+                for (size_t i = 0; i < rows; i++) result[i] ^= 1;
+            }
+        }
+
+        if (stack.empty()) {
+            mask.assign(rows, 1);
+        } else {
+            mask = std::move(stack.back());
+        }
+        if (selected) {
+            size_t count = 0;
+            for (size_t i = 0; i < rows; i++) count += mask[i];
+            *selected = count;
+        }
+        return true;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,77 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "OutfitFilter.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    struct ColumnStats {
+        size_t count;       // Rows considered
+        int64_t min;
+        int64_t max;
+
+        ColumnStats() : count(0), min(0), max(0) {}
+    };
+
+    struct ValueCount {
+        int64_t value;
+        size_t count;
+    };
+
+    // ============== OUTFIT TABLE ==============
+    // A library stored column-wise: one contiguous array per slot field plus
+    // the model column, in OutfitFilter field order (column 0 is the model,
+    // then components and props), so filter programs run column at a time.
+    // Missing components read 0 and missing props -1, as in the outfit
+    // structures; blend data is not stored.
+    //
+    // Kernels are plain loops over contiguous arrays, written so the
+    // compiler can vectorize them. A row mask holds one byte per row
+    // (nonzero: selected) and restricts statistics to the selected rows.
+    class OutfitTable {
+    public:
+        static const size_t COLUMN_COUNT = OutfitFilter::FIELD_BLEND;
+        static const size_t MODEL_COLUMN = OutfitFilter::FIELD_MODEL;
+
+        static size_t ComponentColumn(int slot, int attribute) { return OutfitFilter::FIELD_COMPONENTS + slot * 3 + attribute; }
+        static size_t PropColumn(int slot, int attribute) { return OutfitFilter::FIELD_PROPS + slot * 2 + attribute; }
+
+        // "model", or SLOT[.drawable|.texture|.palette] with SLOT a Cherax
+        // slot name or component<N> / prop<N>
+        static bool ParseColumn(const std::string& name, size_t& column);
+        static std::string ColumnName(size_t column);
+
+        void Reserve(size_t rows);
+        void Clear();
+        size_t Size() const { return models.size(); }
+
+        void Append(const YimOutfit& outfit, const std::string& name = "");
+        // Appends every outfit of a library directory (any format) or .owb
+        // wardrobe; unreadable files are skipped and reported as false
+        bool Load(const std::string& inputPath, unsigned threads = 0);
+
+        const std::string& GetName(size_t row) const { return names[row]; }
+        const uint32_t* GetModels() const { return models.data(); }
+        const int32_t* GetColumn(size_t column) const { return slots[column - 1].data(); }
+        int64_t GetValue(size_t row, size_t column) const;
+
+        // ============== KERNELS ==============
+        ColumnStats MinMax(size_t column, const std::vector<uint8_t>* mask = nullptr) const;
+        // (value, count) for every value present, ascending by value
+        std::vector<ValueCount> Histogram(size_t column, const std::vector<uint8_t>* mask = nullptr) const;
+        // mask[row] = low <= value <= high; returns the number selected
+        size_t SelectRange(size_t column, int64_t low, int64_t high, std::vector<uint8_t>& mask) const;
+        // Runs a compiled filter a column at a time. Fails (mask untouched)
+        // when the filter reads blend fields, which the table does not store.
+        bool Select(const OutfitFilter& filter, std::vector<uint8_t>& mask, size_t* selected = nullptr) const;
+
+    private:
+        std::vector<uint32_t> models;
+        std::vector<int32_t> slots[COLUMN_COUNT - 1];
+        std::vector<std::string> names;
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,329 @@
+#include "OutfitValidation.h"
+#include "OutfitTable.h"
+#include "FormatConverter.h"
+#include "FileHandler.h"
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace OutfitConverter {
+
+    namespace {
+
+        const int COMPONENT_SLOTS = 12;
+
+        struct LimitRule {
+            bool allModels;
+            uint32_t model;
+            std::vector<int> slots;
+            bool setDrawable;
+            bool setTexture;
+            SlotLimit limit;
+        };
+
+        std::string NormalizeName(const std::string& text) {
+            std::string result;
+            for (unsigned char c : text) {
+                if (std::isalnum(c)) result += static_cast<char>(std::tolower(c));
+            }
+            return result;
+        }
+
+        bool ParseInteger(const std::string& text, long long& value) {
+            if (text.empty()) return false;
+            char* end = nullptr;
+            value = std::strtoll(text.c_str(), &end, 10);
+            return *end == '\0';
+        }
+
+        bool ParseModel(const std::string& text, LimitRule& rule) {
+            const std::string name = NormalizeName(text);
+            rule.allModels = text == "*";
+            if (rule.allModels) return true;
+            if (name == "male") rule.model = ComponentMapping::MODEL_MP_M_FREEMODE_01;
+            else if (name == "female") rule.model = ComponentMapping::MODEL_MP_F_FREEMODE_01;
+            else {
+                long long value;
+                if (!ParseInteger(text, value) || value < 0 || value > UINT32_MAX) return false;
+                rule.model = static_cast<uint32_t>(value);
+            }
+            return true;
+        }
+
+        bool ParseSlots(const std::string& text, std::vector<int>& slots) {
+            const std::string name = NormalizeName(text);
+            if (text == "*" || name == "components" || name == "props") {
+                const int first = name == "props" ? COMPONENT_SLOTS : 0;
+                const int last = name == "components" ? COMPONENT_SLOTS : OutfitLimits::SLOTS;
+                for (int slot = first; slot < last; slot++) slots.push_back(slot);
+                return true;
+            }
+            for (const auto& pair : ComponentMapping::CHERAX_COMPONENT_MAP) {
+                if (NormalizeName(pair.first) == name) slots.push_back(pair.second);
+            }
+            for (const auto& pair : ComponentMapping::CHERAX_PROP_MAP) {
+                if (NormalizeName(pair.first) == name) slots.push_back(COMPONENT_SLOTS + pair.second);
+            }
+            long long index;
+            if (slots.empty() && name.compare(0, 9, "component") == 0 && ParseInteger(name.substr(9), index) &&
+                index >= 0 && index < COMPONENT_SLOTS) {
+                slots.push_back(static_cast<int>(index));
+            } else if (slots.empty() && name.compare(0, 4, "prop") == 0 && ParseInteger(name.substr(4), index) &&
+                       index >= 0 && index < OutfitLimits::SLOTS - COMPONENT_SLOTS) {
+                slots.push_back(COMPONENT_SLOTS + static_cast<int>(index));
+            }
+            return !slots.empty();
+        }
+
+        // MIN..MAX, a single value, or * (set = false)
+        bool ParseRange(const std::string& text, bool& set, int32_t& low, int32_t& high) {
+            set = text != "*";
+            if (!set) return true;
+            const size_t dots = text.find("..");
+            long long first, second;
+            if (!ParseInteger(text.substr(0, dots), first)) return false;
+            second = first;
+            if (dots != std::string::npos && !ParseInteger(text.substr(dots + 2), second)) return false;
+            if (first < INT32_MIN || second > INT32_MAX || first > second) return false;
+            low = static_cast<int32_t>(first);
+            high = static_cast<int32_t>(second);
+            return true;
+        }
+
+        void ApplyRule(const LimitRule& rule, SlotLimit* limits) {
+            for (int slot : rule.slots) {
+                if (rule.setDrawable) {
+                    limits[slot].drawableMin = rule.limit.drawableMin;
+                    limits[slot].drawableMax = rule.limit.drawableMax;
+                }
+                if (rule.setTexture) {
+                    limits[slot].textureMin = rule.limit.textureMin;
+                    limits[slot].textureMax = rule.limit.textureMax;
+                }
+            }
+        }
+
+        size_t SlotColumn(int slot, int attribute) {
+            return slot < COMPONENT_SLOTS ? OutfitTable::ComponentColumn(slot, attribute)
+                                          : OutfitTable::PropColumn(slot - COMPONENT_SLOTS, attribute);
+        }
+
+        bool Outside(int32_t value, int32_t low, int32_t high) {
+            return value < low || value > high;
+        }
+    }
+
+    // ============== OUTFIT LIMITS ==============
+    OutfitLimits::OutfitLimits() {
+        // Same ranges as FormatConverter::ValidateComponent/ValidateProp
+        for (int slot = 0; slot < SLOTS; slot++) {
+            defaults[slot] = slot < COMPONENT_SLOTS ? SlotLimit{ -1, 999, 0, 99 } : SlotLimit{ -1, 499, -1, 49 };
+        }
+        models[ComponentMapping::MODEL_MP_M_FREEMODE_01].assign(defaults, defaults + SLOTS);
+        models[ComponentMapping::MODEL_MP_F_FREEMODE_01].assign(defaults, defaults + SLOTS);
+    }
+
+    bool OutfitLimits::Load(const std::string& filepath, std::string& error) {
+        if (!FileHandler::FileExists(filepath)) {
+            error = "cannot read " + filepath;
+            return false;
+        }
+        return Parse(FileHandler::ReadFileContent(filepath), error);
+    }
+
+    bool OutfitLimits::Parse(const std::string& content, std::string& error) {
+        std::vector<LimitRule> rules;
+        std::istringstream stream(content);
+        std::string line;
+        for (size_t number = 1; std::getline(stream, line); number++) {
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            std::vector<std::string> tokens;
+            std::string token;
+            while (fields >> token) tokens.push_back(token);
+            if (tokens.empty()) continue;
+
+            LimitRule rule = LimitRule();
+            const std::string where = "line " + std::to_string(number) + ": ";
+            if (tokens.size() != 4) {
+                error = where + "expected MODEL SLOT DRAWABLE TEXTURE";
+                return false;
+            }
+            if (!ParseModel(tokens[0], rule)) {
+                error = where + "unknown model '" + tokens[0] + "'";
+                return false;
+            }
+            if (!ParseSlots(tokens[1], rule.slots)) {
+                error = where + "unknown slot '" + tokens[1] + "'";
+                return false;
+            }
+            if (!ParseRange(tokens[2], rule.setDrawable, rule.limit.drawableMin, rule.limit.drawableMax) ||
+                !ParseRange(tokens[3], rule.setTexture, rule.limit.textureMin, rule.limit.textureMax)) {
+                error = where + "invalid range";
+                return false;
+            }
+            rules.push_back(rule);
+        }
+
+        // Every named model starts from the built-in limits and takes the
+        // rules for it or for all models, in file order
+        OutfitLimits parsed;
+        for (const auto& rule : rules) {
+            if (!rule.allModels) parsed.models[rule.model].assign(parsed.defaults, parsed.defaults + SLOTS);
+        }
+        for (const auto& rule : rules) {
+            if (rule.allModels) {
+                ApplyRule(rule, parsed.defaults);
+                for (auto& pair : parsed.models) ApplyRule(rule, pair.second.data());
+            } else {
+                ApplyRule(rule, parsed.models[rule.model].data());
+            }
+        }
+        *this = parsed;
+        return true;
+    }
+
+    bool OutfitLimits::IsKnownModel(uint32_t model) const {
+        return models.count(model) > 0;
+    }
+
+    const SlotLimit* OutfitLimits::Get(uint32_t model) const {
+        auto it = models.find(model);
+        return it != models.end() ? it->second.data() : defaults;
+    }
+
+    std::vector<uint32_t> OutfitLimits::GetModels() const {
+        std::vector<uint32_t> result;
+        for (const auto& pair : models) result.push_back(pair.first);
+        return result;
+    }
+
+    // ============== BATCH VALIDATOR ==============
+    uint64_t BatchValidator::Check(const YimOutfit& outfit, const OutfitLimits& limits) {
+        uint64_t violations = limits.IsKnownModel(outfit.model) ? 0 : MODEL_BIT;
+        const SlotLimit* slotLimits = limits.Get(outfit.model);
+        for (int slot = 0; slot < OutfitLimits::SLOTS; slot++) {
+            int32_t drawable, texture;
+            if (slot < COMPONENT_SLOTS) {
+                auto it = outfit.components.find(slot);
+                const Component component = it != outfit.components.end() ? it->second : Component();
+                drawable = component.drawable;
+                texture = component.texture;
+            } else {
+                auto it = outfit.props.find(slot - COMPONENT_SLOTS);
+                const Prop prop = it != outfit.props.end() ? it->second : Prop();
+                drawable = prop.drawable;
+                texture = prop.texture;
+            }
+            const SlotLimit& limit = slotLimits[slot];
+            if (Outside(drawable, limit.drawableMin, limit.drawableMax)) violations |= DrawableBit(slot);
+            if (Outside(texture, limit.textureMin, limit.textureMax)) violations |= TextureBit(slot);
+        }
+        return violations;
+    }
+
+    size_t BatchValidator::Validate(const OutfitTable& table, const OutfitLimits& limits,
+                                    std::vector<uint64_t>& violations) {
+        const size_t rows = table.Size();
+        violations.assign(rows, 0);
+        if (rows == 0) return 0;
+
+        // Model class per row: index into the known models, or the last
+        // class (built-in/* limits) for unknown models. A class is one bit
+        // of a 64-bit member mask, so only the first MAX_CLASSES known models
+        // get a class; rows of the others are re-checked one at a time below.
+        const size_t MAX_CLASSES = 63;
+        const std::vector<uint32_t> known = limits.GetModels();
+        const uint8_t unknownClass = static_cast<uint8_t>(std::min(known.size(), MAX_CLASSES));
+        std::vector<const SlotLimit*> classLimits;
+        for (size_t k = 0; k < unknownClass; k++) classLimits.push_back(limits.Get(known[k]));
+        classLimits.push_back(limits.GetDefaults());
+
+        std::vector<uint8_t> classes(rows, unknownClass);
+        const uint32_t* models = table.GetModels();
+        uint8_t* rowClass = classes.data();
+        for (uint8_t k = 0; k < unknownClass; k++) {
+            const uint32_t model = known[k];
+            for (size_t i = 0; i < rows; i++) rowClass[i] = models[i] == model ? k : rowClass[i];
+        }
+        uint64_t* out = violations.data();
+        for (size_t i = 0; i < rows; i++) out[i] = rowClass[i] == unknownClass ? MODEL_BIT : 0;
+
+        for (int slot = 0; slot < OutfitLimits::SLOTS; slot++) {
+            for (int attribute = 0; attribute < 2; attribute++) {
+                const int32_t* values = table.GetColumn(SlotColumn(slot, attribute));
+                const int shift = attribute == 0 ? slot : OutfitLimits::SLOTS + slot;
+
+                // Group classes by identical range; usually there is one group
+                std::vector<std::pair<std::pair<int32_t, int32_t>, uint64_t>> groups;
+                for (size_t k = 0; k < classLimits.size(); k++) {
+                    const SlotLimit& limit = classLimits[k][slot];
+                    const std::pair<int32_t, int32_t> range = attribute == 0
+                        ? std::make_pair(limit.drawableMin, limit.drawableMax)
+                        : std::make_pair(limit.textureMin, limit.textureMax);
+                    auto it = std::find_if(groups.begin(), groups.end(),
+                                           [&](const std::pair<std::pair<int32_t, int32_t>, uint64_t>& group) {
+                                               return group.first == range;
+                                           });
+                    if (it == groups.end()) groups.push_back({ range, uint64_t(1) << k });
+                    else it->second |= uint64_t(1) << k;
+                }
+
+                // Outside [low, high] is one unsigned compare of value - low
+                for (const auto& group : groups) {
+                    const uint32_t low = static_cast<uint32_t>(group.first.first);
+                    const uint32_t span = static_cast<uint32_t>(group.first.second) - low;
+                    if (groups.size() == 1) {
+                        for (size_t i = 0; i < rows; i++) {
+                            out[i] |= static_cast<uint64_t>(static_cast<uint32_t>(values[i]) - low > span) << shift;
+                        }
+                    } else {
+                        const uint64_t members = group.second;
+                        for (size_t i = 0; i < rows; i++) {
+                            const uint64_t outside = static_cast<uint32_t>(values[i]) - low > span;
+                            out[i] |= (outside & (members >> rowClass[i])) << shift;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Known models past the class cap were checked against the */built-in
+        // limits and flagged unknown; redo those rows with their own limits
+        if (known.size() > MAX_CLASSES) {
+            for (size_t i = 0; i < rows; i++) {
+                if (rowClass[i] != unknownClass || !limits.IsKnownModel(models[i])) continue;
+                const SlotLimit* slotLimits = limits.Get(models[i]);
+                uint64_t rowViolations = 0;
+                for (int slot = 0; slot < OutfitLimits::SLOTS; slot++) {
+                    const SlotLimit& limit = slotLimits[slot];
+                    const int32_t drawable = table.GetColumn(SlotColumn(slot, 0))[i];
+                    const int32_t texture = table.GetColumn(SlotColumn(slot, 1))[i];
+                    if (Outside(drawable, limit.drawableMin, limit.drawableMax)) rowViolations |= DrawableBit(slot);
+                    if (Outside(texture, limit.textureMin, limit.textureMax)) rowViolations |= TextureBit(slot);
+                }
+                out[i] = rowViolations;
+            }
+        }
+
+        size_t invalid = 0;
+        for (size_t i = 0; i < rows; i++) invalid += out[i] != 0;
+        return invalid;
+    }
+
+    std::string BatchValidator::Describe(uint64_t violations) {
+        std::string text;
+        auto add = [&](const std::string& name) {
+            if (!text.empty()) text += ", ";
+            text += name;
+        };
+        if (violations & MODEL_BIT) add("model");
+        for (int slot = 0; slot < OutfitLimits::SLOTS; slot++) {
+            if (violations & DrawableBit(slot)) add(OutfitTable::ColumnName(SlotColumn(slot, 0)));
+            if (violations & TextureBit(slot)) add(OutfitTable::ColumnName(SlotColumn(slot, 1)));
+        }
+        return text;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,84 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    class OutfitTable;
+
+    // Inclusive drawable and texture ranges of one slot
+    struct SlotLimit {
+        int32_t drawableMin;
+        int32_t drawableMax;
+        int32_t textureMin;
+        int32_t textureMax;
+    };
+
+    // ============== OUTFIT LIMITS ==============
+    // Per model, per slot drawable/texture ranges. Slots are numbered 0-11
+    // for components and 12-20 for props. Built-in limits match
+    // FormatConverter::ValidateComponent/ValidateProp for every slot, and
+    // the freemode models are the known models.
+    //
+    // Limits files refine them, one rule per line, applied in order:
+    //
+    //   # model   slot        drawable   texture
+    //   *         props       -1..199    -1..29
+    //   male      Torso       0..195     0..15
+    //   female    component8  0..240     *
+    //
+    // model is male, female, a model hash or * (every model); slot is a
+    // Cherax slot name (case and spaces ignored), component<N>, prop<N>,
+    // components, props or *; ranges are MIN..MAX, a single value, or *
+    // to leave that range unchanged. Models named in the file become known.
+    class OutfitLimits {
+    public:
+        static const int SLOTS = 21;
+
+        OutfitLimits();
+
+        bool Load(const std::string& filepath, std::string& error);
+        bool Parse(const std::string& content, std::string& error);
+
+        bool IsKnownModel(uint32_t model) const;
+        // Limits for every slot of model (the * rules for unknown models)
+        const SlotLimit* Get(uint32_t model) const;
+        const SlotLimit* GetDefaults() const { return defaults; }
+        std::vector<uint32_t> GetModels() const;
+
+    private:
+        SlotLimit defaults[SLOTS];
+        std::map<uint32_t, std::vector<SlotLimit>> models;
+    };
+
+    // ============== BATCH VALIDATOR ==============
+    // Per-outfit violation bitmask: bit slot for a drawable outside its
+    // range, bit SLOTS + slot for a texture outside its range, MODEL_BIT for
+    // an unknown model. Missing components read 0 and missing props -1.
+    class BatchValidator {
+    public:
+        static const uint64_t MODEL_BIT = uint64_t(1) << (2 * OutfitLimits::SLOTS);
+
+        static uint64_t DrawableBit(int slot) { return uint64_t(1) << slot; }
+        static uint64_t TextureBit(int slot) { return uint64_t(1) << (OutfitLimits::SLOTS + slot); }
+
+        // One outfit, a slot at a time
+        static uint64_t Check(const YimOutfit& outfit, const OutfitLimits& limits);
+
+        // Whole table a column at a time: each slot column is compared
+        // against the limits of every model class in one branch-free pass
+        // (classes with identical limits share a pass). Outfits of known
+        // models past the 63rd fall back to a per-outfit check. Returns the
+        // number of outfits with any violation.
+        static size_t Validate(const OutfitTable& table, const OutfitLimits& limits,
+                               std::vector<uint64_t>& violations);
+
+        // "model, Torso.drawable, Hat.texture"
+        static std::string Describe(uint64_t violations);
+    };
+
+} // namespace OutfitConverter
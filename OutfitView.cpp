@@ -0,0 +1,384 @@
+#include "OutfitView.h"
+#include "OutfitCodec.h"
+#include "FileHandler.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+
+namespace OutfitConverter {
+
+    // ============== SCAN HELPERS ==============
+    namespace {
+
+        bool IsSpace(char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        }
+
+        bool IsDigit(char c) {
+            return std::isdigit(static_cast<unsigned char>(c)) != 0;
+        }
+
+        size_t SkipSpace(const std::string& text, size_t position) {
+            while (position < text.size() && IsSpace(text[position])) position++;
+            return position;
+        }
+
+        // Same rules as JsonParser::GetUInt32: first "key" in the text, which
+        // must be followed by ':', then a run of digits
+        uint32_t SearchUInt32(const std::string& text, const char* key) {
+            const std::string quoted = std::string("\"") + key + "\"";
+            const size_t found = text.find(quoted);
+            if (found == std::string::npos) return 0;
+            size_t position = SkipSpace(text, found + quoted.size());
+            if (position >= text.size() || text[position] != ':') return 0;
+            position = SkipSpace(text, position + 1);
+            uint32_t value = 0;
+            while (position < text.size() && IsDigit(text[position])) {
+                value = value * 10 + static_cast<uint32_t>(text[position++] - '0');
+            }
+            return value;
+        }
+
+        // Integer as JsonParser::ParseInt reads it: optional '-', then digits
+        int ParseIntAt(const std::string& text, size_t& position) {
+            position = SkipSpace(text, position);
+            const size_t start = position;
+            if (position < text.size() && text[position] == '-') position++;
+            while (position < text.size() && IsDigit(text[position])) position++;
+            if (position == start) return 0;
+            const long value = std::strtol(text.c_str() + start, nullptr, 10);
+            return value < INT_MIN ? INT_MIN : value > INT_MAX ? INT_MAX : static_cast<int>(value);
+        }
+
+        const char* ComponentName(int slot) {
+            for (const auto& pair : ComponentMapping::CHERAX_COMPONENT_MAP) {
+                if (pair.second == slot) return pair.first.c_str();
+            }
+            return nullptr;
+        }
+
+        const char* PropName(int slot) {
+            for (const auto& pair : ComponentMapping::CHERAX_PROP_MAP) {
+                if (pair.second == slot) return pair.first.c_str();
+            }
+            return nullptr;
+        }
+    }
+
+    // ============== OUTFIT VIEW ==============
+    OutfitView::OutfitView()
+        : format(FormatConverter::FormatType::UNKNOWN), decoded(0), model(0) {}
+
+    bool OutfitView::Open(const std::string& filepath, FormatConverter::FormatType fileFormat) {
+        return Parse(FileHandler::ReadFileContent(filepath), fileFormat);
+    }
+
+    bool OutfitView::Parse(std::string text, FormatConverter::FormatType textFormat) {
+        content = std::move(text);
+        decoded = 0;
+        keys.clear();
+        for (auto& array : lexisArrays) array.clear();
+        full = YimOutfit();
+
+        format = textFormat == FormatConverter::FormatType::UNKNOWN
+            ? FormatConverter::DetectFormatFromContent(content) : textFormat;
+        return !content.empty() && CodecRegistry::Instance().Get(format) != nullptr;
+    }
+
+    bool OutfitView::IsJson() const {
+        return format == FormatConverter::FormatType::CHERAX ||
+               format == FormatConverter::FormatType::YIM ||
+               format == FormatConverter::FormatType::LEXIS;
+    }
+
+    uint32_t OutfitView::GetModel() const {
+        if (decoded & DECODED_MODEL) return model;
+        decoded |= DECODED_MODEL;
+
+        if (IsJson()) {
+            model = SearchUInt32(content, "model");
+            if (format == FormatConverter::FormatType::YIM && model == 0) {
+                model = ComponentMapping::MODEL_MP_M_FREEMODE_01;
+            }
+        } else if (format == FormatConverter::FormatType::STAND) {
+            // Last "Model: name" line wins, as in ParseStandOutfit
+            std::string name;
+            size_t start = 0;
+            while (start < content.size()) {
+                size_t end = content.find('\n', start);
+                if (end == std::string::npos) end = content.size();
+                const size_t keyStart = content.find_first_not_of(" \t\r", start);
+                if (keyStart < end && content.compare(keyStart, 5, "Model") == 0) {
+                    const size_t colon = content.find_first_not_of(" \t\r", keyStart + 5);
+                    if (colon < end && content[colon] == ':') {
+                        const size_t valueStart = content.find_first_not_of(" \t\r", colon + 1);
+                        const size_t valueEnd = content.find_last_not_of(" \t\r", end - 1);
+                        name = valueStart < end && valueEnd >= valueStart
+                            ? content.substr(valueStart, valueEnd - valueStart + 1) : "";
+                    }
+                }
+                start = end + 1;
+            }
+            auto it = ComponentMapping::STAND_MODEL_MAP.find(name);
+            model = it != ComponentMapping::STAND_MODEL_MAP.end() ? it->second : ComponentMapping::MODEL_MP_M_FREEMODE_01;
+        } else {
+            DecodeFull();
+            model = full.model;
+        }
+        return model;
+    }
+
+    const BlendData& OutfitView::GetBlend() const {
+        if (decoded & DECODED_BLEND) return blend;
+        decoded |= DECODED_BLEND;
+        blend = BlendData();
+
+        if (format == FormatConverter::FormatType::YIM) {
+            BuildKeys();
+            const int32_t section = FindAnyKey("blend_data");
+            if (section >= 0) {
+                blend.is_parent = ReadInt(FindKey(section, "is_parent"));
+                blend.shape_first_id = ReadInt(FindKey(section, "shape_first_id"));
+                blend.shape_mix = ReadFloat(FindKey(section, "shape_mix"));
+                blend.shape_second_id = ReadInt(FindKey(section, "shape_second_id"));
+                blend.shape_third_id = ReadInt(FindKey(section, "shape_third_id"));
+                blend.skin_first_id = ReadInt(FindKey(section, "skin_first_id"));
+                blend.skin_mix = ReadFloat(FindKey(section, "skin_mix"));
+                blend.skin_second_id = ReadInt(FindKey(section, "skin_second_id"));
+                blend.skin_third_id = ReadInt(FindKey(section, "skin_third_id"));
+                blend.third_mix = ReadFloat(FindKey(section, "third_mix"));
+            }
+        } else if (!IsJson()) {
+            DecodeFull();
+            blend = full.blend_data;
+        }
+        return blend;
+    }
+
+    bool OutfitView::HasComponent(int slot) const {
+        if (slot < 0 || slot >= 12) return false;
+        DecodeComponent(slot);
+        return hasComponent[slot];
+    }
+
+    Component OutfitView::GetComponent(int slot) const {
+        return HasComponent(slot) ? components[slot] : Component();
+    }
+
+    bool OutfitView::HasProp(int slot) const {
+        if (slot < 0 || slot >= 9) return false;
+        DecodeProp(slot);
+        return hasProp[slot];
+    }
+
+    Prop OutfitView::GetProp(int slot) const {
+        return HasProp(slot) ? props[slot] : Prop();
+    }
+
+    bool OutfitView::ToYim(YimOutfit& outfit, unsigned fields) const {
+        if (content.empty() || CodecRegistry::Instance().Get(format) == nullptr) return false;
+
+        outfit = YimOutfit();
+        if (fields & FIELD_MODEL) outfit.model = GetModel();
+        if (fields & FIELD_BLEND) outfit.blend_data = GetBlend();
+        if (fields & FIELD_COMPONENTS) {
+            for (int slot = 0; slot < 12; slot++) {
+                if (HasComponent(slot)) outfit.components[slot] = components[slot];
+            }
+        }
+        if (fields & FIELD_PROPS) {
+            for (int slot = 0; slot < 9; slot++) {
+                if (HasProp(slot)) outfit.props[slot] = props[slot];
+            }
+        }
+        return true;
+    }
+
+    // ============== LAZY DECODING ==============
+    void OutfitView::DecodeFull() const {
+        if (decoded & DECODED_FULL) return;
+        decoded |= DECODED_FULL;
+        const OutfitCodec* codec = CodecRegistry::Instance().Get(format);
+        if (!codec || !codec->Decode(content, full)) full = YimOutfit();
+    }
+
+    void OutfitView::DecodeComponent(int slot) const {
+        const uint32_t bit = DECODED_COMPONENT0 << slot;
+        if (decoded & bit) return;
+        decoded |= bit;
+        hasComponent[slot] = false;
+        components[slot] = Component();
+
+        if (format == FormatConverter::FormatType::LEXIS) {
+            if (!(decoded & DECODED_LEXIS_COMPONENTS)) {
+                decoded |= DECODED_LEXIS_COMPONENTS;
+                BuildKeys();
+                lexisArrays[0] = ReadIntArray(FindAnyKey("component"));
+                lexisArrays[1] = ReadIntArray(FindAnyKey("component variation"));
+            }
+            // Short arrays are padded with 0, as in ParseLexisOutfit
+            hasComponent[slot] = true;
+            if (static_cast<size_t>(slot) < lexisArrays[0].size()) components[slot].drawable = lexisArrays[0][slot];
+            if (static_cast<size_t>(slot) < lexisArrays[1].size()) components[slot].texture = lexisArrays[1][slot];
+        } else if (format == FormatConverter::FormatType::CHERAX || format == FormatConverter::FormatType::YIM) {
+            BuildKeys();
+            const bool cherax = format == FormatConverter::FormatType::CHERAX;
+            const int32_t section = FindAnyKey("components");
+            const char* name = ComponentName(slot);
+            const int32_t entry = section < 0 ? -1 :
+                cherax ? (name ? FindKey(section, name) : -1) : FindKey(section, std::to_string(slot));
+            if (entry >= 0) {
+                hasComponent[slot] = true;
+                components[slot].drawable = ReadInt(FindKey(entry, cherax ? "drawable" : "drawable_id"));
+                components[slot].texture = ReadInt(FindKey(entry, cherax ? "texture" : "texture_id"));
+                components[slot].palette = cherax ? ReadInt(FindKey(entry, "palette")) : 0;
+            }
+        } else {
+            DecodeFull();
+            auto it = full.components.find(slot);
+            if (it != full.components.end()) {
+                hasComponent[slot] = true;
+                components[slot] = it->second;
+            }
+        }
+    }
+
+    void OutfitView::DecodeProp(int slot) const {
+        const uint32_t bit = DECODED_PROP0 << slot;
+        if (decoded & bit) return;
+        decoded |= bit;
+        hasProp[slot] = false;
+        props[slot] = Prop();
+
+        if (format == FormatConverter::FormatType::LEXIS) {
+            if (!(decoded & DECODED_LEXIS_PROPS)) {
+                decoded |= DECODED_LEXIS_PROPS;
+                BuildKeys();
+                lexisArrays[2] = ReadIntArray(FindAnyKey("prop"));
+                lexisArrays[3] = ReadIntArray(FindAnyKey("prop variation"));
+            }
+            // Short arrays are padded with -1, as in ParseLexisOutfit
+            hasProp[slot] = true;
+            if (static_cast<size_t>(slot) < lexisArrays[2].size()) props[slot].drawable = lexisArrays[2][slot];
+            if (static_cast<size_t>(slot) < lexisArrays[3].size()) props[slot].texture = lexisArrays[3][slot];
+        } else if (format == FormatConverter::FormatType::CHERAX || format == FormatConverter::FormatType::YIM) {
+            BuildKeys();
+            const bool cherax = format == FormatConverter::FormatType::CHERAX;
+            const int32_t section = FindAnyKey("props");
+            const char* name = PropName(slot);
+            const int32_t entry = section < 0 ? -1 :
+                cherax ? (name ? FindKey(section, name) : -1) : FindKey(section, std::to_string(slot));
+            if (entry >= 0) {
+                hasProp[slot] = true;
+                props[slot].drawable = ReadInt(FindKey(entry, cherax ? "drawable" : "drawable_id"));
+                props[slot].texture = ReadInt(FindKey(entry, cherax ? "texture" : "texture_id"));
+            }
+        } else {
+            DecodeFull();
+            auto it = full.props.find(slot);
+            if (it != full.props.end()) {
+                hasProp[slot] = true;
+                props[slot] = it->second;
+            }
+        }
+    }
+
+    // ============== STRUCTURAL PASS ==============
+    // One scan over the buffer recording every key, the offset of its value
+    // and the key owning the enclosing object (objects inside an array
+    // belong to the array's key). Values are not decoded here.
+    void OutfitView::BuildKeys() const {
+        if (decoded & DECODED_KEYS) return;
+        decoded |= DECODED_KEYS;
+
+        std::vector<int32_t> owners;
+        int32_t pending = -1;   // Key whose value has not started yet
+        const size_t size = content.size();
+        for (size_t i = 0; i < size; i++) {
+            const char c = content[i];
+            if (c == '"') {
+                size_t end = i + 1;
+                while (end < size && content[end] != '"') end += content[end] == '\\' ? 2 : 1;
+                const size_t next = SkipSpace(content, end + 1);
+                if (next < size && content[next] == ':') {
+                    KeyEntry entry;
+                    entry.name = static_cast<uint32_t>(i + 1);
+                    entry.length = static_cast<uint32_t>(end - i - 1);
+                    entry.value = static_cast<uint32_t>(next + 1);
+                    entry.parent = owners.empty() ? -1 : owners.back();
+                    keys.push_back(entry);
+                    pending = static_cast<int32_t>(keys.size() - 1);
+                    i = next;
+                } else {
+                    pending = -1;
+                    i = end;
+                }
+            } else if (c == '{' || c == '[') {
+                owners.push_back(pending >= 0 ? pending : owners.empty() ? -1 : owners.back());
+                pending = -1;
+            } else if (c == '}' || c == ']') {
+                if (!owners.empty()) owners.pop_back();
+                pending = -1;
+            } else if (c == ',') {
+                pending = -1;
+            }
+        }
+    }
+
+    int32_t OutfitView::FindKey(int32_t parent, const std::string& name) const {
+        if (parent < 0) return -1;
+        for (size_t i = static_cast<size_t>(parent) + 1; i < keys.size(); i++) {
+            const KeyEntry& entry = keys[i];
+            if (entry.parent == parent && entry.length == name.size() &&
+                content.compare(entry.name, entry.length, name) == 0) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    int32_t OutfitView::FindAnyKey(const std::string& name) const {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i].length == name.size() && content.compare(keys[i].name, keys[i].length, name) == 0) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    int OutfitView::ReadInt(int32_t entry) const {
+        if (entry < 0) return 0;
+        size_t position = keys[entry].value;
+        return ParseIntAt(content, position);
+    }
+
+    float OutfitView::ReadFloat(int32_t entry) const {
+        if (entry < 0) return 0.0f;
+        // Sign, digits and dots, as JsonParser::ParseFloat
+        size_t position = SkipSpace(content, keys[entry].value);
+        const size_t start = position;
+        if (position < content.size() && content[position] == '-') position++;
+        while (position < content.size() && (IsDigit(content[position]) || content[position] == '.')) position++;
+        if (position == start) return 0.0f;
+        return std::strtof(content.substr(start, position - start).c_str(), nullptr);
+    }
+
+    std::vector<int> OutfitView::ReadIntArray(int32_t entry) const {
+        std::vector<int> values;
+        if (entry < 0) return values;
+        size_t position = SkipSpace(content, keys[entry].value);
+        if (position >= content.size() || content[position] != '[') return values;
+        position = SkipSpace(content, position + 1);
+        while (position < content.size() && content[position] != ']') {
+            const size_t before = position;
+            values.push_back(ParseIntAt(content, position));
+            position = SkipSpace(content, position);
+            if (position < content.size() && content[position] == ',') position++;
+            position = SkipSpace(content, position);
+            if (position == before) break;  // Not a number; stop rather than spin
+        }
+        return values;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,98 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace OutfitConverter {
+
+    // ============== OUTFIT VIEW ==============
+    // Lazily decoded outfit over a retained file buffer. Nothing is parsed
+    // up front: the model is read by a direct key search, and the first
+    // slot or blend access runs one structural pass recording where every
+    // JSON key's value starts. Each field is then decoded from its offset on
+    // first access and cached. Values match FormatConverter::ParseAsYim.
+    //
+    // Stand files and registered codecs have no offsets table; their first
+    // non-model access decodes the whole outfit through the codec.
+    // A view is not thread-safe; use one per thread.
+    class OutfitView {
+    public:
+        // Field groups for ToYim
+        enum Fields : unsigned {
+            FIELD_MODEL = 1,
+            FIELD_BLEND = 2,
+            FIELD_COMPONENTS = 4,
+            FIELD_PROPS = 8,
+            FIELD_ALL = 15
+        };
+
+        OutfitView();
+
+        // Retains the whole file; UNKNOWN detects the format from content
+        bool Open(const std::string& filepath,
+                  FormatConverter::FormatType format = FormatConverter::FormatType::UNKNOWN);
+        bool Parse(std::string content,
+                   FormatConverter::FormatType format = FormatConverter::FormatType::UNKNOWN);
+
+        FormatConverter::FormatType GetFormat() const { return format; }
+        const std::string& GetContent() const { return content; }
+
+        uint32_t GetModel() const;
+        const BlendData& GetBlend() const;
+        bool HasComponent(int slot) const;
+        Component GetComponent(int slot) const;
+        bool HasProp(int slot) const;
+        Prop GetProp(int slot) const;
+
+        // Canonical outfit with the requested field groups decoded; the
+        // others keep their YimOutfit defaults
+        bool ToYim(YimOutfit& outfit, unsigned fields = FIELD_ALL) const;
+
+    private:
+        struct KeyEntry {
+            uint32_t name;      // Offset of the key text (inside the quotes)
+            uint32_t length;
+            uint32_t value;     // Offset just past the ':'
+            int32_t parent;     // Entry owning the enclosing object, -1 at top level
+        };
+
+        std::string content;
+        FormatConverter::FormatType format;
+
+        // Decoded state; each bit of decoded marks one cached field
+        enum : uint32_t {
+            DECODED_MODEL = 1u << 0,
+            DECODED_BLEND = 1u << 1,
+            DECODED_KEYS = 1u << 2,
+            DECODED_FULL = 1u << 3,
+            DECODED_LEXIS_COMPONENTS = 1u << 4,
+            DECODED_LEXIS_PROPS = 1u << 5,
+            DECODED_COMPONENT0 = 1u << 6,   // 12 bits
+            DECODED_PROP0 = 1u << 18        // 9 bits
+        };
+        mutable uint32_t decoded;
+        mutable uint32_t model;
+        mutable BlendData blend;
+        mutable Component components[12];
+        mutable Prop props[9];
+        mutable bool hasComponent[12];
+        mutable bool hasProp[9];
+        mutable std::vector<KeyEntry> keys;
+        mutable std::vector<int> lexisArrays[4];    // component, variation, prop, variation
+        mutable YimOutfit full;
+
+        bool IsJson() const;
+        void BuildKeys() const;
+        int32_t FindKey(int32_t parent, const std::string& name) const;
+        int32_t FindAnyKey(const std::string& name) const;
+        int ReadInt(int32_t entry) const;
+        float ReadFloat(int32_t entry) const;
+        std::vector<int> ReadIntArray(int32_t entry) const;
+        void DecodeFull() const;
+        void DecodeComponent(int slot) const;
+        void DecodeProp(int slot) const;
+    };
+
+} // namespace OutfitConverter
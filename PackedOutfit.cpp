@@ -0,0 +1,360 @@
+#include "PackedOutfit.h"
+#include "FormatConverter.h"
+#include "WardrobeContainer.h"
+#include "FileHandler.h"
+#include "ByteOrder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace OutfitConverter {
+
+    // ============== BIT LAYOUT ==============
+    namespace {
+
+        const unsigned OFF_TAG = 0;
+        const unsigned OFF_MODEL = 1;
+        const unsigned OFF_COMPONENT_MASK = 3;
+        const unsigned OFF_PROP_MASK = 15;
+        const unsigned OFF_IS_PARENT = 24;
+        const unsigned OFF_IDS = 25;            // 6 x 6 bits
+        const unsigned OFF_MIXES = 61;          // 3 x 10 bits
+        const unsigned OFF_COMPONENTS = 91;     // 12 x 19 bits
+        const unsigned OFF_PROPS = 319;         // 9 x 15 bits, ends at bit 454
+
+        const unsigned ID_BITS = 6;
+        const unsigned MIX_BITS = 10;
+        const unsigned COMPONENT_BITS = 19;
+        const unsigned PROP_BITS = 15;
+
+        const int COMPONENT_SLOTS = 12;
+        const int PROP_SLOTS = 9;
+
+        static_assert(sizeof(PackedOutfit) == 64, "packed outfits must fill one cache line");
+
+        const uint32_t MODEL_CODES[4] = {
+            0,
+            ComponentMapping::MODEL_MP_M_FREEMODE_01,
+            ComponentMapping::MODEL_MP_F_FREEMODE_01,
+            0
+        };
+
+        // Fields may straddle a word boundary; offsets are constants at every
+        // call site, so the compiler folds the straddle check away
+        inline uint64_t GetBits(const uint64_t* words, unsigned offset, unsigned width) {
+            const unsigned index = offset >> 6;
+            const unsigned shift = offset & 63;
+            uint64_t value = words[index] >> shift;
+            if (shift + width > 64) value |= words[index + 1] << (64 - shift);
+            return value & ((1ULL << width) - 1);
+        }
+
+        inline void SetBits(uint64_t* words, unsigned offset, unsigned width, uint64_t value) {
+            const unsigned index = offset >> 6;
+            const unsigned shift = offset & 63;
+            value &= (1ULL << width) - 1;
+            words[index] |= value << shift;
+            if (shift + width > 64) words[index + 1] |= value >> (64 - shift);
+        }
+
+        inline float DecodeMix(uint64_t thousandths) {
+            return static_cast<float>(thousandths) / 1000.0f;
+        }
+
+        // Only values that decode back bit-for-bit are packed
+        bool EncodeMix(float value, uint64_t& thousandths) {
+            if (!(value >= 0.0f && value <= 1.0f)) return false;
+            thousandths = static_cast<uint64_t>(std::lround(static_cast<double>(value) * 1000.0));
+            const float decoded = DecodeMix(thousandths);
+            return std::memcmp(&decoded, &value, sizeof(value)) == 0;
+        }
+
+    } // namespace
+
+    // ============== OUTFIT PACKER ==============
+    bool OutfitPacker::Pack(const YimOutfit& outfit, PackedOutfit& packed) {
+        uint64_t* words = packed.words;
+        std::memset(words, 0, sizeof(packed.words));
+
+        uint64_t modelCode = 0;
+        while (modelCode < 3 && MODEL_CODES[modelCode] != outfit.model) modelCode++;
+        if (modelCode == 3) return false;
+        SetBits(words, OFF_MODEL, 2, modelCode);
+
+        const BlendData& blend = outfit.blend_data;
+        if (blend.is_parent != 0 && blend.is_parent != 1) return false;
+        SetBits(words, OFF_IS_PARENT, 1, static_cast<uint64_t>(blend.is_parent));
+
+        const int ids[6] = {
+            blend.shape_first_id, blend.shape_second_id, blend.shape_third_id,
+            blend.skin_first_id, blend.skin_second_id, blend.skin_third_id
+        };
+        for (int i = 0; i < 6; i++) {
+            if (ids[i] < 0 || ids[i] >= (1 << ID_BITS)) return false;
+            SetBits(words, OFF_IDS + i * ID_BITS, ID_BITS, static_cast<uint64_t>(ids[i]));
+        }
+
+        const float mixes[3] = { blend.shape_mix, blend.skin_mix, blend.third_mix };
+        for (int i = 0; i < 3; i++) {
+            uint64_t thousandths;
+            if (!EncodeMix(mixes[i], thousandths)) return false;
+            SetBits(words, OFF_MIXES + i * MIX_BITS, MIX_BITS, thousandths);
+        }
+
+        uint64_t componentMask = 0;
+        for (const auto& pair : outfit.components) {
+            const Component& comp = pair.second;
+            if (pair.first < 0 || pair.first >= COMPONENT_SLOTS ||
+                !FormatConverter::ValidateComponent(comp) || comp.palette < 0 || comp.palette > 3) {
+                return false;
+            }
+            componentMask |= 1ULL << pair.first;
+            const unsigned offset = OFF_COMPONENTS + pair.first * COMPONENT_BITS;
+            SetBits(words, offset, 10, static_cast<uint64_t>(comp.drawable + 1));
+            SetBits(words, offset + 10, 7, static_cast<uint64_t>(comp.texture));
+            SetBits(words, offset + 17, 2, static_cast<uint64_t>(comp.palette));
+        }
+        SetBits(words, OFF_COMPONENT_MASK, COMPONENT_SLOTS, componentMask);
+
+        uint64_t propMask = 0;
+        for (const auto& pair : outfit.props) {
+            if (pair.first < 0 || pair.first >= PROP_SLOTS || !FormatConverter::ValidateProp(pair.second)) {
+                return false;
+            }
+            propMask |= 1ULL << pair.first;
+            const unsigned offset = OFF_PROPS + pair.first * PROP_BITS;
+            SetBits(words, offset, 9, static_cast<uint64_t>(pair.second.drawable + 1));
+            SetBits(words, offset + 9, 6, static_cast<uint64_t>(pair.second.texture + 1));
+        }
+        SetBits(words, OFF_PROP_MASK, PROP_SLOTS, propMask);
+
+        return true;
+    }
+
+    void OutfitPacker::Unpack(const PackedOutfit& packed, YimOutfit& outfit) {
+        const uint64_t* words = packed.words;
+        outfit = YimOutfit();
+        outfit.model = MODEL_CODES[GetBits(words, OFF_MODEL, 2)];
+
+        BlendData& blend = outfit.blend_data;
+        blend.is_parent = static_cast<int>(GetBits(words, OFF_IS_PARENT, 1));
+        blend.shape_first_id = static_cast<int>(GetBits(words, OFF_IDS + 0 * ID_BITS, ID_BITS));
+        blend.shape_second_id = static_cast<int>(GetBits(words, OFF_IDS + 1 * ID_BITS, ID_BITS));
+        blend.shape_third_id = static_cast<int>(GetBits(words, OFF_IDS + 2 * ID_BITS, ID_BITS));
+        blend.skin_first_id = static_cast<int>(GetBits(words, OFF_IDS + 3 * ID_BITS, ID_BITS));
+        blend.skin_second_id = static_cast<int>(GetBits(words, OFF_IDS + 4 * ID_BITS, ID_BITS));
+        blend.skin_third_id = static_cast<int>(GetBits(words, OFF_IDS + 5 * ID_BITS, ID_BITS));
+        blend.shape_mix = DecodeMix(GetBits(words, OFF_MIXES + 0 * MIX_BITS, MIX_BITS));
+        blend.skin_mix = DecodeMix(GetBits(words, OFF_MIXES + 1 * MIX_BITS, MIX_BITS));
+        blend.third_mix = DecodeMix(GetBits(words, OFF_MIXES + 2 * MIX_BITS, MIX_BITS));
+
+        const uint64_t componentMask = GetBits(words, OFF_COMPONENT_MASK, COMPONENT_SLOTS);
+        for (int slot = 0; slot < COMPONENT_SLOTS; slot++) {
+            if (!(componentMask & (1ULL << slot))) continue;
+            const unsigned offset = OFF_COMPONENTS + slot * COMPONENT_BITS;
+            outfit.components[slot] = Component(
+                static_cast<int>(GetBits(words, offset, 10)) - 1,
+                static_cast<int>(GetBits(words, offset + 10, 7)),
+                static_cast<int>(GetBits(words, offset + 17, 2)));
+        }
+
+        const uint64_t propMask = GetBits(words, OFF_PROP_MASK, PROP_SLOTS);
+        for (int slot = 0; slot < PROP_SLOTS; slot++) {
+            if (!(propMask & (1ULL << slot))) continue;
+            const unsigned offset = OFF_PROPS + slot * PROP_BITS;
+            outfit.props[slot] = Prop(
+                static_cast<int>(GetBits(words, offset, 9)) - 1,
+                static_cast<int>(GetBits(words, offset + 9, 6)) - 1);
+        }
+    }
+
+    // ============== OUTFIT COLUMNS ==============
+    void OutfitColumns::Resize(size_t outfits) {
+        count = outfits;
+        model.resize(outfits);
+        componentMask.resize(outfits);
+        propMask.resize(outfits);
+        drawable.resize(outfits * COMPONENT_SLOTS);
+        texture.resize(outfits * COMPONENT_SLOTS);
+        palette.resize(outfits * COMPONENT_SLOTS);
+        propDrawable.resize(outfits * PROP_SLOTS);
+        propTexture.resize(outfits * PROP_SLOTS);
+    }
+
+    // ============== PACKED ARCHIVE ==============
+    const char PackedArchive::MAGIC[4] = { 'O', 'P', 'K', '1' };
+
+    size_t PackedArchive::Add(const YimOutfit& outfit) {
+        PackedOutfit packed;
+        if (!OutfitPacker::Pack(outfit, packed)) {
+            std::memset(packed.words, 0, sizeof(packed.words));
+            SetBits(packed.words, OFF_TAG, 1, 1);
+            packed.words[0] |= static_cast<uint64_t>(overflow.size()) << 1;
+            overflow.push_back(outfit);
+        }
+        records.push_back(packed);
+        return records.size() - 1;
+    }
+
+    bool PackedArchive::Get(size_t index, YimOutfit& outfit) const {
+        if (index >= records.size()) return false;
+
+        const PackedOutfit& packed = records[index];
+        if (OutfitPacker::IsOverflow(packed)) {
+            outfit = overflow[static_cast<size_t>(packed.words[0] >> 1)];
+        } else {
+            OutfitPacker::Unpack(packed, outfit);
+        }
+        return true;
+    }
+
+    void PackedArchive::Clear() {
+        records.clear();
+        overflow.clear();
+    }
+
+    size_t PackedArchive::GetByteSize() const {
+        return HEADER_SIZE + records.size() * sizeof(PackedOutfit) +
+               overflow.size() * WardrobeContainer::RECORD_SIZE;
+    }
+
+    void PackedArchive::DecodeColumns(size_t first, size_t count, OutfitColumns& columns) const {
+        first = std::min(first, records.size());
+        count = std::min(count, records.size() - first);
+        columns.Resize(count);
+
+        // Straight-line decode: identical shifts and masks for every record
+        for (size_t i = 0; i < count; i++) {
+            const uint64_t* words = records[first + i].words;
+            columns.model[i] = MODEL_CODES[GetBits(words, OFF_MODEL, 2)];
+            columns.componentMask[i] = static_cast<uint16_t>(GetBits(words, OFF_COMPONENT_MASK, COMPONENT_SLOTS));
+            columns.propMask[i] = static_cast<uint16_t>(GetBits(words, OFF_PROP_MASK, PROP_SLOTS));
+
+            int32_t* drawable = &columns.drawable[i * COMPONENT_SLOTS];
+            int32_t* texture = &columns.texture[i * COMPONENT_SLOTS];
+            int32_t* palette = &columns.palette[i * COMPONENT_SLOTS];
+            for (int slot = 0; slot < COMPONENT_SLOTS; slot++) {
+                const unsigned offset = OFF_COMPONENTS + slot * COMPONENT_BITS;
+                drawable[slot] = static_cast<int32_t>(GetBits(words, offset, 10)) - 1;
+                texture[slot] = static_cast<int32_t>(GetBits(words, offset + 10, 7));
+                palette[slot] = static_cast<int32_t>(GetBits(words, offset + 17, 2));
+            }
+
+            int32_t* propDrawable = &columns.propDrawable[i * PROP_SLOTS];
+            int32_t* propTexture = &columns.propTexture[i * PROP_SLOTS];
+            for (int slot = 0; slot < PROP_SLOTS; slot++) {
+                const unsigned offset = OFF_PROPS + slot * PROP_BITS;
+                propDrawable[slot] = static_cast<int32_t>(GetBits(words, offset, 9)) - 1;
+                propTexture[slot] = static_cast<int32_t>(GetBits(words, offset + 9, 6)) - 1;
+            }
+        }
+
+        // Overflow records are rare; patch them in a second pass
+        if (overflow.empty()) return;
+        for (size_t i = 0; i < count; i++) {
+            const PackedOutfit& packed = records[first + i];
+            if (!OutfitPacker::IsOverflow(packed)) continue;
+
+            const YimOutfit& outfit = overflow[static_cast<size_t>(packed.words[0] >> 1)];
+            uint16_t componentMask = 0;
+            uint16_t propMask = 0;
+            columns.model[i] = outfit.model;
+            for (int slot = 0; slot < COMPONENT_SLOTS; slot++) {
+                auto it = outfit.components.find(slot);
+                Component comp = it != outfit.components.end() ? it->second : Component(-1, 0, 0);
+                if (it != outfit.components.end()) componentMask |= static_cast<uint16_t>(1u << slot);
+                columns.drawable[i * COMPONENT_SLOTS + slot] = comp.drawable;
+                columns.texture[i * COMPONENT_SLOTS + slot] = comp.texture;
+                columns.palette[i * COMPONENT_SLOTS + slot] = comp.palette;
+            }
+            for (int slot = 0; slot < PROP_SLOTS; slot++) {
+                auto it = outfit.props.find(slot);
+                Prop prop = it != outfit.props.end() ? it->second : Prop();
+                if (it != outfit.props.end()) propMask |= static_cast<uint16_t>(1u << slot);
+                columns.propDrawable[i * PROP_SLOTS + slot] = prop.drawable;
+                columns.propTexture[i * PROP_SLOTS + slot] = prop.texture;
+            }
+            columns.componentMask[i] = componentMask;
+            columns.propMask[i] = propMask;
+        }
+    }
+
+    bool PackedArchive::Save(const std::string& filepath) const {
+        std::string tempPath;
+        std::FILE* file = FileHandler::BeginAtomicWrite(filepath, tempPath);
+        if (!file) return false;
+
+        uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        PutU32(header + 4, VERSION);
+        PutU64(header + 8, records.size());
+        PutU64(header + 16, overflow.size());
+        bool success = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+        // Little-endian words, staged through a buffer of whole records
+        std::vector<uint8_t> buffer;
+        buffer.reserve(1024 * sizeof(PackedOutfit));
+        for (size_t i = 0; success && i < records.size(); i++) {
+            for (size_t w = 0; w < PackedOutfit::WORDS; w++) {
+                uint8_t bytes[8];
+                PutU64(bytes, records[i].words[w]);
+                buffer.insert(buffer.end(), bytes, bytes + 8);
+            }
+            if (buffer.size() == buffer.capacity() || i + 1 == records.size()) {
+                success = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+                buffer.clear();
+            }
+        }
+
+        uint8_t record[WardrobeContainer::RECORD_SIZE];
+        for (size_t i = 0; success && i < overflow.size(); i++) {
+            WardrobeContainer::EncodeRecord(overflow[i], WardrobeContainer::NO_NAME, 0, record);
+            success = std::fwrite(record, 1, sizeof(record), file) == sizeof(record);
+        }
+
+        return FileHandler::CommitAtomicWrite(file, tempPath, filepath, success);
+    }
+
+    bool PackedArchive::Load(const std::string& filepath) {
+        Clear();
+
+        const std::string content = FileHandler::ReadFileContent(filepath);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(content.data());
+        if (content.size() < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+            GetU32(data + 4) != VERSION) {
+            return false;
+        }
+
+        const uint64_t recordCount = GetU64(data + 8);
+        const uint64_t overflowCount = GetU64(data + 16);
+        const uint64_t available = content.size() - HEADER_SIZE;
+        if (recordCount > available / sizeof(PackedOutfit) ||
+            overflowCount > (available - recordCount * sizeof(PackedOutfit)) / WardrobeContainer::RECORD_SIZE) {
+            return false;
+        }
+
+        records.resize(static_cast<size_t>(recordCount));
+        const uint8_t* in = data + HEADER_SIZE;
+        for (auto& packed : records) {
+            for (size_t w = 0; w < PackedOutfit::WORDS; w++, in += 8) {
+                packed.words[w] = GetU64(in);
+            }
+        }
+
+        overflow.resize(static_cast<size_t>(overflowCount));
+        for (auto& outfit : overflow) {
+            WardrobeContainer::DecodeRecord(in, outfit);
+            in += WardrobeContainer::RECORD_SIZE;
+        }
+
+        // Every overflow tag must point inside the overflow list
+        for (const auto& packed : records) {
+            if (OutfitPacker::IsOverflow(packed) && (packed.words[0] >> 1) >= overflow.size()) {
+                Clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,84 @@
+#pragma once
+#include "OutfitStructures.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== PACKED OUTFIT ==============
+    // One outfit in a single 64-byte cache line. Fields sit at fixed bit
+    // offsets (see PackedOutfit.cpp), so every record decodes with the same
+    // shifts and masks and a batch decode has no per-record branching:
+    //
+    //   tag 1 | model code 2 | component mask 12 | prop mask 9
+    //   blend: is_parent 1, six ids x 6, three mixes x 10 (thousandths)
+    //   12 components x (drawable+1: 10, texture: 7, palette: 2)
+    //   9 props x (drawable+1: 9, texture+1: 6)
+    //
+    // Only outfits inside FormatConverter::ValidateComponent/ValidateProp
+    // ranges, with a freemode (or unset) model and mixes that are exact
+    // thousandths, fit this layout. Anything else is kept verbatim by
+    // PackedArchive as an overflow entry, so packing is always lossless.
+    struct PackedOutfit {
+        static const size_t WORDS = 8;
+        uint64_t words[WORDS];
+    };
+
+    class OutfitPacker {
+    public:
+        // False when the outfit does not fit the packed layout
+        static bool Pack(const YimOutfit& outfit, PackedOutfit& packed);
+        static void Unpack(const PackedOutfit& packed, YimOutfit& outfit);
+
+        static bool IsOverflow(const PackedOutfit& packed) { return (packed.words[0] & 1) != 0; }
+    };
+
+    // ============== OUTFIT COLUMNS ==============
+    // Structure-of-arrays view produced by PackedArchive::DecodeColumns.
+    // Per-slot arrays are row-major: drawable[i * 12 + slot].
+    struct OutfitColumns {
+        size_t count;
+        std::vector<uint32_t> model;
+        std::vector<uint16_t> componentMask;
+        std::vector<uint16_t> propMask;
+        std::vector<int32_t> drawable;
+        std::vector<int32_t> texture;
+        std::vector<int32_t> palette;
+        std::vector<int32_t> propDrawable;
+        std::vector<int32_t> propTexture;
+
+        OutfitColumns() : count(0) {}
+        void Resize(size_t outfits);
+    };
+
+    // ============== PACKED ARCHIVE ==============
+    // Append-only store of packed outfits. Records that do not fit the packed
+    // layout are tagged and point into an overflow list of full outfits.
+    class PackedArchive {
+    private:
+        std::vector<PackedOutfit> records;
+        std::vector<YimOutfit> overflow;
+
+    public:
+        static const char MAGIC[4];
+        static const uint32_t VERSION = 1;
+        static const size_t HEADER_SIZE = 32;
+
+        size_t Add(const YimOutfit& outfit);
+        bool Get(size_t index, YimOutfit& outfit) const;
+        void Clear();
+
+        size_t Size() const { return records.size(); }
+        size_t GetOverflowCount() const { return overflow.size(); }
+        size_t GetByteSize() const;     // Size of the archive file
+
+        // Decode [first, first + count) into columns; count is clamped to Size()
+        void DecodeColumns(size_t first, size_t count, OutfitColumns& columns) const;
+
+        bool Save(const std::string& filepath) const;
+        bool Load(const std::string& filepath);
+    };
+
+} // namespace OutfitConverter
@@ -0,0 +1,49 @@
+#pragma once
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== PARALLEL HELPERS ==============
+    // Number of workers to use when the caller passes 0 ("auto").
+    inline unsigned ResolveThreadCount(unsigned requested, size_t workItems) {
+        unsigned threads = requested;
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+            if (threads == 0) threads = 1;
+        }
+        if (workItems < threads) threads = static_cast<unsigned>(std::max<size_t>(workItems, 1));
+        return threads;
+    }
+
+    // Run fn(index, worker) for every index in [0, count). Indices are handed
+    // out dynamically so uneven file sizes still balance across workers; the
+    // worker number lets callers keep per-thread scratch state without locking.
+    template<typename Fn>
+    void ParallelFor(size_t count, unsigned requestedThreads, Fn fn) {
+        unsigned threads = ResolveThreadCount(requestedThreads, count);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; i++) fn(i, 0u);
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned w = 0; w < threads; w++) {
+            workers.emplace_back([&, w]() {
+                size_t i;
+                while ((i = next.fetch_add(1)) < count) {
+                    fn(i, w);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,407 @@
+#include "WardrobeContainer.h"
+#include "FileHandler.h"
+#include "OutfitBundle.h"
+#include "FanOutConverter.h"
+#include "BatchConverter.h"
+#include "Parallel.h"
+#include "ByteOrder.h"
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace OutfitConverter {
+
+    // ============== FIELD OFFSETS ==============
+    namespace {
+
+        // Header field offsets
+        const size_t H_MAGIC = 0;
+        const size_t H_VERSION = 4;
+        const size_t H_HEADER_SIZE = 6;
+        const size_t H_RECORD_SIZE = 8;
+        const size_t H_FLAGS = 12;
+        const size_t H_COUNT = 16;
+        const size_t H_RECORD_OFFSET = 24;
+        const size_t H_STRING_OFFSET = 32;
+        const size_t H_STRING_SIZE = 40;
+
+        // Record field offsets
+        const size_t R_MODEL = 0;
+        const size_t R_NAME_OFFSET = 4;
+        const size_t R_NAME_LENGTH = 8;
+        const size_t R_COMPONENT_MASK = 12;
+        const size_t R_PROP_MASK = 14;
+        const size_t R_BLEND = 16;          // 10 x 4 bytes
+        const size_t R_COMPONENTS = 56;     // 12 x (drawable, texture, palette)
+        const size_t R_PROPS = 200;         // 9 x (drawable, texture)
+
+        const int COMPONENT_SLOTS = 12;
+        const int PROP_SLOTS = 9;
+
+    } // namespace
+
+    // ============== RECORD LAYOUT ==============
+    const char WardrobeContainer::MAGIC[4] = { 'O', 'W', 'B', '1' };
+
+    void WardrobeContainer::EncodeRecord(const YimOutfit& outfit, uint32_t nameOffset,
+                                         uint32_t nameLength, uint8_t* record) {
+        std::memset(record, 0, RECORD_SIZE);
+        PutU32(record + R_MODEL, outfit.model);
+        PutU32(record + R_NAME_OFFSET, nameOffset);
+        PutU32(record + R_NAME_LENGTH, nameLength);
+
+        const BlendData& blend = outfit.blend_data;
+        uint8_t* out = record + R_BLEND;
+        PutI32(out + 0, blend.is_parent);
+        PutI32(out + 4, blend.shape_first_id);
+        PutF32(out + 8, blend.shape_mix);
+        PutI32(out + 12, blend.shape_second_id);
+        PutI32(out + 16, blend.shape_third_id);
+        PutI32(out + 20, blend.skin_first_id);
+        PutF32(out + 24, blend.skin_mix);
+        PutI32(out + 28, blend.skin_second_id);
+        PutI32(out + 32, blend.skin_third_id);
+        PutF32(out + 36, blend.third_mix);
+
+        uint16_t componentMask = 0;
+        for (const auto& pair : outfit.components) {
+            if (pair.first < 0 || pair.first >= COMPONENT_SLOTS) continue;
+            componentMask |= static_cast<uint16_t>(1u << pair.first);
+            out = record + R_COMPONENTS + pair.first * 12;
+            PutI32(out + 0, pair.second.drawable);
+            PutI32(out + 4, pair.second.texture);
+            PutI32(out + 8, pair.second.palette);
+        }
+
+        uint16_t propMask = 0;
+        for (const auto& pair : outfit.props) {
+            if (pair.first < 0 || pair.first >= PROP_SLOTS) continue;
+            propMask |= static_cast<uint16_t>(1u << pair.first);
+            out = record + R_PROPS + pair.first * 8;
+            PutI32(out + 0, pair.second.drawable);
+            PutI32(out + 4, pair.second.texture);
+        }
+
+        PutU16(record + R_COMPONENT_MASK, componentMask);
+        PutU16(record + R_PROP_MASK, propMask);
+    }
+
+    void WardrobeContainer::DecodeRecord(const uint8_t* record, YimOutfit& outfit) {
+        outfit = YimOutfit();
+        outfit.model = GetU32(record + R_MODEL);
+
+        BlendData& blend = outfit.blend_data;
+        const uint8_t* in = record + R_BLEND;
+        blend.is_parent = GetI32(in + 0);
+        blend.shape_first_id = GetI32(in + 4);
+        blend.shape_mix = GetF32(in + 8);
+        blend.shape_second_id = GetI32(in + 12);
+        blend.shape_third_id = GetI32(in + 16);
+        blend.skin_first_id = GetI32(in + 20);
+        blend.skin_mix = GetF32(in + 24);
+        blend.skin_second_id = GetI32(in + 28);
+        blend.skin_third_id = GetI32(in + 32);
+        blend.third_mix = GetF32(in + 36);
+
+        const uint16_t componentMask = GetU16(record + R_COMPONENT_MASK);
+        for (int slot = 0; slot < COMPONENT_SLOTS; slot++) {
+            if (!(componentMask & (1u << slot))) continue;
+            in = record + R_COMPONENTS + slot * 12;
+            outfit.components[slot] = Component(GetI32(in), GetI32(in + 4), GetI32(in + 8));
+        }
+
+        const uint16_t propMask = GetU16(record + R_PROP_MASK);
+        for (int slot = 0; slot < PROP_SLOTS; slot++) {
+            if (!(propMask & (1u << slot))) continue;
+            in = record + R_PROPS + slot * 8;
+            outfit.props[slot] = Prop(GetI32(in), GetI32(in + 4));
+        }
+    }
+
+    // ============== WARDROBE WRITER ==============
+    WardrobeWriter::WardrobeWriter() : file(nullptr), count(0), failed(false) {}
+
+    WardrobeWriter::~WardrobeWriter() {
+        if (file) {
+            FileHandler::CommitAtomicWrite(file, tempPath, targetPath, false);
+        }
+    }
+
+    bool WardrobeWriter::Open(const std::string& filepath) {
+        if (file) return false;
+
+        targetPath = filepath;
+        strings.clear();
+        count = 0;
+        failed = false;
+
+        file = FileHandler::BeginAtomicWrite(targetPath, tempPath);
+        if (!file) return false;
+
+        // Placeholder; the real header is written once the counts are known
+        uint8_t header[WardrobeContainer::HEADER_SIZE] = {};
+        failed = std::fwrite(header, 1, sizeof(header), file) != sizeof(header);
+        return !failed;
+    }
+
+    bool WardrobeWriter::Add(const YimOutfit& outfit, const std::string& name) {
+        if (!file || failed) return false;
+
+        uint32_t nameOffset = WardrobeContainer::NO_NAME;
+        if (!name.empty()) {
+            nameOffset = static_cast<uint32_t>(strings.size());
+            strings += name;
+        }
+
+        uint8_t record[WardrobeContainer::RECORD_SIZE];
+        WardrobeContainer::EncodeRecord(outfit, nameOffset, static_cast<uint32_t>(name.size()), record);
+        if (std::fwrite(record, 1, sizeof(record), file) != sizeof(record)) {
+            failed = true;
+            return false;
+        }
+        count++;
+        return true;
+    }
+
+    bool WardrobeWriter::Close() {
+        if (!file) return false;
+
+        const uint64_t recordOffset = WardrobeContainer::HEADER_SIZE;
+        const uint64_t stringOffset = recordOffset + count * WardrobeContainer::RECORD_SIZE;
+
+        if (!failed && !strings.empty()) {
+            failed = std::fwrite(strings.data(), 1, strings.size(), file) != strings.size();
+        }
+
+        uint8_t header[WardrobeContainer::HEADER_SIZE] = {};
+        std::memcpy(header + H_MAGIC, WardrobeContainer::MAGIC, sizeof(WardrobeContainer::MAGIC));
+        PutU16(header + H_VERSION, WardrobeContainer::VERSION);
+        PutU16(header + H_HEADER_SIZE, static_cast<uint16_t>(WardrobeContainer::HEADER_SIZE));
+        PutU32(header + H_RECORD_SIZE, WardrobeContainer::RECORD_SIZE);
+        PutU32(header + H_FLAGS, strings.empty() ? 0 : WardrobeContainer::FLAG_NAMES);
+        PutU64(header + H_COUNT, count);
+        PutU64(header + H_RECORD_OFFSET, recordOffset);
+        PutU64(header + H_STRING_OFFSET, stringOffset);
+        PutU64(header + H_STRING_SIZE, strings.size());
+
+        if (!failed) {
+            failed = std::fseek(file, 0, SEEK_SET) != 0 ||
+                     std::fwrite(header, 1, sizeof(header), file) != sizeof(header);
+        }
+
+        bool success = FileHandler::CommitAtomicWrite(file, tempPath, targetPath, !failed);
+        file = nullptr;
+        return success;
+    }
+
+    // ============== WARDROBE FILE ==============
+    WardrobeFile::WardrobeFile()
+        : data(nullptr), size(0), count(0), recordSize(0), recordOffset(0),
+          stringOffset(0), stringSize(0) {}
+
+    WardrobeFile::~WardrobeFile() {
+        Close();
+    }
+
+    bool WardrobeFile::Open(const std::string& filepath) {
+        Close();
+        if (!mapping.Open(filepath, WardrobeContainer::HEADER_SIZE)) return false;
+        data = mapping.Data();
+        size = mapping.Size();
+
+        if (!ValidateHeader()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool WardrobeFile::ValidateHeader() {
+        if (std::memcmp(data + H_MAGIC, WardrobeContainer::MAGIC, sizeof(WardrobeContainer::MAGIC)) != 0 ||
+            GetU16(data + H_VERSION) != WardrobeContainer::VERSION) {
+            return false;
+        }
+
+        const uint64_t records = GetU64(data + H_COUNT);
+        const uint64_t recordBytes = GetU32(data + H_RECORD_SIZE);
+        const uint64_t recordsAt = GetU64(data + H_RECORD_OFFSET);
+        const uint64_t stringsAt = GetU64(data + H_STRING_OFFSET);
+        const uint64_t stringBytes = GetU64(data + H_STRING_SIZE);
+
+        // Every offset must lie inside the mapping before any record is touched
+        if (recordBytes < WardrobeContainer::RECORD_SIZE || recordsAt < GetU16(data + H_HEADER_SIZE) ||
+            recordsAt > size || records > (size - recordsAt) / recordBytes ||
+            stringsAt > size || stringBytes > size - stringsAt) {
+            return false;
+        }
+
+        count = static_cast<size_t>(records);
+        recordSize = static_cast<size_t>(recordBytes);
+        recordOffset = static_cast<size_t>(recordsAt);
+        stringOffset = static_cast<size_t>(stringsAt);
+        stringSize = static_cast<size_t>(stringBytes);
+        return true;
+    }
+
+    void WardrobeFile::Close() {
+        mapping.Close();
+        data = nullptr;
+        size = 0;
+        count = 0;
+    }
+
+    bool WardrobeFile::Get(size_t index, YimOutfit& outfit) const {
+        if (index >= count) return false;
+        WardrobeContainer::DecodeRecord(Record(index), outfit);
+        return true;
+    }
+
+    std::string WardrobeFile::GetName(size_t index) const {
+        if (index >= count) return "";
+
+        const uint32_t offset = GetU32(Record(index) + R_NAME_OFFSET);
+        const uint32_t length = GetU32(Record(index) + R_NAME_LENGTH);
+        if (offset == WardrobeContainer::NO_NAME || offset > stringSize || length > stringSize - offset) {
+            return "";
+        }
+        return std::string(reinterpret_cast<const char*>(data + stringOffset + offset), length);
+    }
+
+    uint32_t WardrobeFile::GetModel(size_t index) const {
+        return index < count ? GetU32(Record(index) + R_MODEL) : 0;
+    }
+
+    // ============== WARDROBE IMPORT / EXPORT ==============
+    WardrobeTransferResult WardrobeTransfer::Import(const std::string& inputPath,
+                                                    const std::string& wardrobePath,
+                                                    unsigned threads) {
+        WardrobeTransferResult result;
+        WardrobeWriter writer;
+        if (!writer.Open(wardrobePath)) {
+            result.failed++;
+            result.failedItems.push_back(wardrobePath);
+            return result;
+        }
+
+        std::error_code ec;
+        if (fs::is_directory(inputPath, ec)) {
+            // Parse in parallel a chunk at a time, append in file order
+            const std::vector<std::string> files = BatchConverter::CollectInputFiles(inputPath);
+            const size_t CHUNK = 4096;
+            std::vector<YimOutfit> outfits;
+            std::vector<char> loaded;
+
+            for (size_t base = 0; base < files.size(); base += CHUNK) {
+                const size_t chunk = std::min(CHUNK, files.size() - base);
+                outfits.assign(chunk, YimOutfit());
+                loaded.assign(chunk, 0);
+
+                ParallelFor(chunk, threads, [&](size_t index, unsigned) {
+                    const std::string path = (fs::path(inputPath) / files[base + index]).string();
+                    loaded[index] = FormatConverter::LoadAsYim(
+                        path, FormatConverter::DetectFormat(path), outfits[index]) ? 1 : 0;
+                });
+
+                for (size_t i = 0; i < chunk; i++) {
+                    const std::string& file = files[base + i];
+                    const std::string name = fs::path(file).replace_extension().generic_string();
+                    if (loaded[i] && writer.Add(outfits[i], name)) {
+                        result.outfits++;
+                    } else {
+                        result.failed++;
+                        result.failedItems.push_back(file);
+                    }
+                }
+            }
+        } else {
+            BundleReader reader;
+            YimOutfit outfit;
+            if (reader.Open(inputPath)) {
+                while (reader.Next(outfit)) {
+                    if (writer.Add(outfit)) result.outfits++;
+                    else result.failed++;
+                }
+            }
+            if (!reader.GetCount() || reader.HasError()) {
+                result.failed++;
+                result.failedItems.push_back(inputPath);
+            }
+        }
+
+        if (!writer.Close()) {
+            result.failed++;
+            result.failedItems.push_back(wardrobePath);
+        }
+        return result;
+    }
+
+    WardrobeTransferResult WardrobeTransfer::Export(const std::string& wardrobePath,
+                                                    const std::string& outputDir,
+                                                    const std::vector<FormatConverter::FormatType>& targets,
+                                                    unsigned threads) {
+        WardrobeTransferResult result;
+        WardrobeFile wardrobe;
+        if (!wardrobe.Open(wardrobePath)) {
+            result.failed++;
+            result.failedItems.push_back(wardrobePath);
+            return result;
+        }
+
+        // Unnamed records, and names that would escape outputDir, get a numbered file
+        const size_t count = wardrobe.GetCount();
+        std::vector<std::string> names(count);
+        std::unordered_map<std::string, size_t> owners;
+        std::vector<char> collides(count, 0);
+        for (size_t index = 0; index < count; index++) {
+            std::string name = wardrobe.GetName(index);
+            if (name.empty() || fs::path(name).is_absolute() || name.find("..") != std::string::npos) {
+                name = std::to_string(index + 1);
+                name.insert(0, name.size() < 6 ? 6 - name.size() : 0, '0');
+                name = "wardrobe_" + name;
+            }
+            names[index] = name;
+
+            // Records sharing a name would overwrite each other; neither owns the file
+            auto inserted = owners.emplace(name, index);
+            if (!inserted.second) {
+                collides[index] = 1;
+                collides[inserted.first->second] = 1;
+            }
+        }
+
+        std::mutex resultMutex;
+        ParallelFor(count, threads, [&](size_t index, unsigned) {
+            const std::string& name = names[index];
+            YimOutfit outfit;
+            std::vector<std::string> outputs;
+            bool success = !collides[index] && wardrobe.Get(index, outfit);
+            if (success) FanOutConverter::SerializeAll(outfit, targets, outputs);
+
+            // Names are stored without an extension and may contain dots
+            // ("look v1.2"), so the extension is appended, never replaced
+            for (size_t i = 0; success && i < targets.size(); i++) {
+                const fs::path outputPath = fs::path(outputDir) / FormatConverter::FormatTypeToName(targets[i]) /
+                                            (name + FormatConverter::GetFormatExtension(targets[i]));
+                std::error_code ec;
+                fs::create_directories(outputPath.parent_path(), ec);
+                success = FileHandler::WriteFileContent(outputPath.string(), outputs[i]);
+            }
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (success) {
+                result.outfits++;
+            } else {
+                result.failed++;
+                result.failedItems.push_back(name);
+            }
+        });
+        FileHandler::FlushPendingWrites();
+
+        return result;
+    }
+
+} // namespace OutfitConverter
@@ -0,0 +1,125 @@
+#pragma once
+#include "OutfitStructures.h"
+#include "MappedFile.h"
+#include "FormatConverter.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+namespace OutfitConverter {
+
+    // ============== WARDROBE CONTAINER (.owb) ==============
+    // Binary interchange file for many canonical outfits. All integers are
+    // little-endian.
+    //
+    //   Header   (HEADER_SIZE bytes)  magic, version, record size, count, offsets
+    //   Records  (count * recordSize) fixed layout, see EncodeRecord
+    //   Strings  (optional)           outfit names, referenced by offset/length
+    //
+    // Fixed-size records put outfit i at recordOffset + i * recordSize, so a
+    // mapped wardrobe reads any outfit in O(1) without parsing anything else.
+    // Readers accept records larger than RECORD_SIZE and ignore the tail,
+    // which leaves room to append fields in later versions.
+    class WardrobeContainer {
+    public:
+        static const char MAGIC[4];
+        static const uint16_t VERSION = 1;
+        static const uint32_t HEADER_SIZE = 64;
+        static const uint32_t RECORD_SIZE = 272;
+        static const uint32_t FLAG_NAMES = 1;
+        static const uint32_t NO_NAME = 0xFFFFFFFFu;
+
+        // Components 0-11 and props 0-8 are stored; other slot keys are dropped
+        static void EncodeRecord(const YimOutfit& outfit, uint32_t nameOffset, uint32_t nameLength,
+                                 uint8_t* record);
+        static void DecodeRecord(const uint8_t* record, YimOutfit& outfit);
+    };
+
+    // ============== WARDROBE WRITER ==============
+    // Records stream straight to disk; names are collected and appended as the
+    // string table on Close, after which the header is filled in. The file is
+    // committed through FileHandler's temp-file-and-rename path.
+    class WardrobeWriter {
+    private:
+        std::FILE* file;
+        std::string tempPath;
+        std::string targetPath;
+        std::string strings;
+        uint64_t count;
+        bool failed;
+
+    public:
+        WardrobeWriter();
+        ~WardrobeWriter();
+
+        WardrobeWriter(const WardrobeWriter&) = delete;
+        WardrobeWriter& operator=(const WardrobeWriter&) = delete;
+
+        bool Open(const std::string& filepath);
+        bool Add(const YimOutfit& outfit, const std::string& name = "");
+        bool Close();
+
+        uint64_t GetCount() const { return count; }
+    };
+
+    // ============== WARDROBE FILE ==============
+    // Read-only memory-mapped view of a wardrobe. Get() may be called from
+    // several threads at once.
+    class WardrobeFile {
+    private:
+        MappedFile mapping;
+        const uint8_t* data;
+        size_t size;
+        size_t count;
+        size_t recordSize;
+        size_t recordOffset;
+        size_t stringOffset;
+        size_t stringSize;
+
+        const uint8_t* Record(size_t index) const { return data + recordOffset + index * recordSize; }
+        bool ValidateHeader();
+
+    public:
+        WardrobeFile();
+        ~WardrobeFile();
+
+        WardrobeFile(const WardrobeFile&) = delete;
+        WardrobeFile& operator=(const WardrobeFile&) = delete;
+
+        bool Open(const std::string& filepath);
+        void Close();
+
+        size_t GetCount() const { return count; }
+        bool Get(size_t index, YimOutfit& outfit) const;
+        std::string GetName(size_t index) const;
+        uint32_t GetModel(size_t index) const;
+    };
+
+    // ============== WARDROBE IMPORT / EXPORT ==============
+    struct WardrobeTransferResult {
+        size_t outfits;
+        size_t failed;
+        std::vector<std::string> failedItems;
+
+        WardrobeTransferResult() : outfits(0), failed(0) {}
+    };
+
+    class WardrobeTransfer {
+    public:
+        // inputPath is a directory of outfit files (named by relative path
+        // without extension) or a bundle file (unnamed records)
+        static WardrobeTransferResult Import(const std::string& inputPath,
+                                             const std::string& wardrobePath,
+                                             unsigned threads = 0);
+
+        // Writes outputDir/<Format>/<name or wardrobe_NNNNNN>.<ext> per target.
+        // Records that share a name, or fail to read, are counted as failed.
+        static WardrobeTransferResult Export(const std::string& wardrobePath,
+                                             const std::string& outputDir,
+                                             const std::vector<FormatConverter::FormatType>& targets,
+                                             unsigned threads = 0);
+    };
+
+} // namespace OutfitConverter